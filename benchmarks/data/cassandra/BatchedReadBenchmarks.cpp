@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Compares reading ledger objects and transactions with one query per key against batched `IN` queries.
+ * Needs a running Cassandra or ScyllaDB; the contact point is taken from CLIO_BENCHMARK_CASSANDRA_HOST and defaults to
+ * localhost. The benchmark creates and uses the `clio_benchmark` keyspace.
+ *
+ * The `queries` counter shows how many queries one fetch sends to the coordinators. The benchmark measures client side
+ * latency only: an `IN` query costs the coordinator as much as the separate queries it replaces, because the
+ * coordinator fans out to the replicas of every key and holds the whole result until the slowest one answers.
+ * Against a local single node the fan-out is free, so the numbers here show the round trips saved and overstate the
+ * gain of large batches. On a real cluster batches of 10 to 50 keys pay off; above about 100 keys the fan-out makes a
+ * batch slower than the separate queries and the coordinator memory grows with the batch.
+ */
+
+#include "data/BackendInterface.hpp"
+#include "data/CassandraBackend.hpp"
+#include "data/cassandra/SettingsProvider.hpp"
+#include "rpc/RPCHelpers.hpp"
+#include "util/config/Config.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/asio/spawn.hpp>
+#include <boost/json/parse.hpp>
+#include <fmt/core.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr auto NUM_KEYS = 400;
+constexpr uint32_t LEDGER_SEQUENCE = 1000;
+constexpr auto OBJECT_SIZE = 200;
+
+std::string
+cassandraHost()
+{
+    auto const* host = std::getenv("CLIO_BENCHMARK_CASSANDRA_HOST");
+    return host != nullptr ? host : "127.0.0.1";
+}
+
+std::unique_ptr<data::cassandra::CassandraBackend>
+makeBackend(std::size_t readBatchSize)
+{
+    // backend counters register their metrics, so every backend gets a fresh registry
+    util::prometheus::PrometheusService::init();
+
+    util::Config const cfg{boost::json::parse(fmt::format(
+        R"JSON({{
+            "contact_points": "{}",
+            "keyspace": "clio_benchmark",
+            "replication_factor": 1,
+            "read_batch_size": {}
+        }})JSON",
+        cassandraHost(),
+        readBatchSize
+    ))};
+    return std::make_unique<data::cassandra::CassandraBackend>(data::cassandra::SettingsProvider{cfg}, false);
+}
+
+std::vector<ripple::uint256>
+makeKeys()
+{
+    std::vector<ripple::uint256> keys;
+    for (auto i = 0; i < NUM_KEYS; ++i)
+        keys.push_back(ripple::uint256{static_cast<std::uint64_t>(i + 1)});
+    return keys;
+}
+
+void
+writeData(data::BackendInterface& backend, std::vector<ripple::uint256> const& keys)
+{
+    ripple::LedgerHeader header;
+    header.seq = LEDGER_SEQUENCE;
+    auto const headerBlob = rpc::ledgerHeaderToBlob(header, true);
+
+    backend.startWrites();
+    backend.writeLedger(header, std::string{headerBlob.begin(), headerBlob.end()});
+    for (auto const& key : keys) {
+        auto const keyStr = std::string{key.begin(), key.end()};
+        backend.writeLedgerObject(std::string{keyStr}, LEDGER_SEQUENCE, std::string(OBJECT_SIZE, 'o'));
+        backend.writeTransaction(
+            std::string{keyStr}, LEDGER_SEQUENCE, 0, std::string(OBJECT_SIZE, 't'), std::string(OBJECT_SIZE, 'm')
+        );
+    }
+    backend.finishWrites(LEDGER_SEQUENCE);
+}
+
+template <typename FetchType>
+void
+runFetch(benchmark::State& state, FetchType&& fetch)
+{
+    auto const readBatchSize = static_cast<std::size_t>(state.range(0));
+    auto const keys = makeKeys();
+
+    std::unique_ptr<data::cassandra::CassandraBackend> backend;
+    try {
+        backend = makeBackend(readBatchSize);
+        writeData(*backend, keys);
+    } catch (std::exception const& e) {
+        state.SkipWithError(fmt::format("Cassandra is not available: {}", e.what()).c_str());
+        return;
+    }
+
+    for (auto _ : state) {
+        data::synchronous([&](boost::asio::yield_context yield) {
+            benchmark::DoNotOptimize(fetch(*backend, keys, yield));
+        });
+    }
+
+    state.counters["queries"] = readBatchSize == 0 ? NUM_KEYS : (NUM_KEYS + readBatchSize - 1) / readBatchSize;
+    state.counters["keys"] = benchmark::Counter(NUM_KEYS, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+void
+benchmarkFetchLedgerObjects(benchmark::State& state)
+{
+    runFetch(state, [](auto& backend, auto const& keys, auto yield) {
+        return backend.fetchLedgerObjects(keys, LEDGER_SEQUENCE, yield);
+    });
+}
+
+void
+benchmarkFetchTransactions(benchmark::State& state)
+{
+    runFetch(state, [](auto& backend, auto const& keys, auto yield) { return backend.fetchTransactions(keys, yield); });
+}
+
+}  // namespace
+
+// Argument is the read batch size; 0 is the per-key path
+BENCHMARK(benchmarkFetchLedgerObjects)->Arg(0)->Arg(10)->Arg(50)->Arg(100)->Arg(NUM_KEYS)->UseRealTime();
+BENCHMARK(benchmarkFetchTransactions)->Arg(0)->Arg(10)->Arg(50)->Arg(100)->Arg(NUM_KEYS)->UseRealTime();
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Compares the extraction data pipe backed by single producer single consumer rings with the pipe backed by the mutex
+ * and condition variable based ThreadSafeQueue. One thread per stride plays an extractor and pushes synthetic
+ * GetLedgerResponse messages; the benchmark thread plays the transformer and pops them in ledger order.
+ */
+
+#include "etl/ETLHelpers.hpp"
+#include "etl/impl/ExtractionDataPipe.hpp"
+#include "etl/impl/SpscQueue.hpp"
+
+#include <benchmark/benchmark.h>
+#include <org/xrpl/rpc/v1/get_ledger.pb.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::uint32_t START_SEQUENCE = 1000;
+constexpr std::uint32_t NUM_LEDGERS = 2000;
+constexpr auto NUM_TRANSACTIONS = 20;
+constexpr auto BLOB_SIZE = 300;
+
+using ResponseType = org::xrpl::rpc::v1::GetLedgerResponse;
+
+ResponseType
+makeResponse()
+{
+    ResponseType response;
+    response.set_ledger_header(std::string(BLOB_SIZE, 'h'));
+    for (auto i = 0; i < NUM_TRANSACTIONS; ++i) {
+        auto* txn = response.mutable_transactions_list()->add_transactions();
+        txn->set_transaction_blob(std::string(BLOB_SIZE, 't'));
+        txn->set_metadata_blob(std::string(BLOB_SIZE, 'm'));
+    }
+    return response;
+}
+
+template <typename QueueType>
+void
+benchmarkExtractionDataPipe(benchmark::State& state)
+{
+    auto const stride = static_cast<std::uint32_t>(state.range(0));
+    auto const response = makeResponse();
+
+    for (auto _ : state) {
+        etl::impl::ExtractionDataPipe<ResponseType, QueueType> pipe{stride, START_SEQUENCE};
+
+        // like the extractors, every thread pushes the ledgers of its stride and then finishes its queue; copying the
+        // response stands in for the deserialization an extractor does
+        std::vector<std::thread> extractors;
+        for (std::uint32_t i = 0; i < stride; ++i) {
+            extractors.emplace_back([&pipe, &response, stride, first = START_SEQUENCE + i]() {
+                auto sequence = first;
+                for (; sequence < START_SEQUENCE + NUM_LEDGERS; sequence += stride)
+                    pipe.push(sequence, std::make_optional(response));
+                pipe.finish(sequence);
+            });
+        }
+
+        auto sequence = START_SEQUENCE;
+        while (auto data = pipe.popNext(sequence)) {
+            benchmark::DoNotOptimize(data->transactions_list().transactions_size());
+            ++sequence;
+        }
+
+        for (auto& extractor : extractors)
+            extractor.join();
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_LEDGERS);
+}
+
+using SpscPipeQueue = etl::impl::SpscQueue<std::optional<ResponseType>>;
+using MutexPipeQueue = etl::ThreadSafeQueue<std::optional<ResponseType>>;
+
+}  // namespace
+
+// Argument is the number of extractors
+BENCHMARK_TEMPLATE(benchmarkExtractionDataPipe, SpscPipeQueue)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(benchmarkExtractionDataPipe, MutexPipeQueue)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
@@ -0,0 +1,111 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/RPCHelpers.hpp"
+#include "util/AccountUtils.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json/parse.hpp>
+#include <xrpl/basics/Slice.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/AccountID.h>
+#include <xrpl/protocol/LedgerFormats.h>
+#include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STAmount.h>
+#include <xrpl/protocol/STArray.h>
+#include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/TER.h>
+#include <xrpl/protocol/TxFormats.h>
+#include <xrpl/protocol/UintTypes.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr auto TXNID = "E6DBAFC99223B42257915A63DFC6B0C032D4070F9A574B255AD97466726FC321";
+
+ripple::STObject
+createPayment()
+{
+    ripple::STObject obj(ripple::sfTransaction);
+    obj.setFieldU16(ripple::sfTransactionType, ripple::ttPAYMENT);
+    obj.setAccountID(ripple::sfAccount, util::parseBase58Wrapper<ripple::AccountID>(std::string(ACCOUNT)).value());
+    obj.setAccountID(ripple::sfDestination, util::parseBase58Wrapper<ripple::AccountID>(std::string(ACCOUNT2)).value());
+    obj.setFieldAmount(ripple::sfAmount, ripple::STAmount(1'000'000, false));
+    obj.setFieldAmount(ripple::sfFee, ripple::STAmount(12, false));
+    obj.setFieldU32(ripple::sfSequence, 42);
+    obj.setFieldU32(ripple::sfFlags, 0);
+    obj.setFieldVL(ripple::sfSigningPubKey, ripple::Slice{"test", 4});
+    return obj;
+}
+
+ripple::STObject
+createMeta()
+{
+    ripple::STObject finalFields(ripple::sfFinalFields);
+    finalFields.setAccountID(ripple::sfAccount, util::parseBase58Wrapper<ripple::AccountID>(std::string(ACCOUNT)).value());
+    finalFields.setFieldAmount(ripple::sfBalance, ripple::STAmount(100'000'000, false));
+    finalFields.setFieldU32(ripple::sfSequence, 43);
+
+    ripple::STObject node(ripple::sfModifiedNode);
+    node.setFieldU16(ripple::sfLedgerEntryType, ripple::ltACCOUNT_ROOT);
+    node.setFieldH256(ripple::sfLedgerIndex, ripple::uint256{TXNID});
+    node.emplace_back(std::move(finalFields));
+
+    ripple::STArray nodes{ripple::sfAffectedNodes};
+    for (auto i = 0; i < 4; ++i)
+        nodes.push_back(node);
+
+    ripple::STObject meta(ripple::sfTransactionMetaData);
+    meta.setFieldArray(ripple::sfAffectedNodes, nodes);
+    meta.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    meta.setFieldU32(ripple::sfTransactionIndex, 1);
+    return meta;
+}
+
+void
+benchmarkStyledStringRoundTrip(benchmark::State& state, ripple::STObject const& obj)
+{
+    for (auto _ : state) {
+        auto value = boost::json::parse(obj.getJson(ripple::JsonOptions::none).toStyledString());
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void
+benchmarkToJson(benchmark::State& state, ripple::STObject const& obj)
+{
+    for (auto _ : state) {
+        auto value = rpc::toJson(obj);
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+}  // namespace
+
+// Old conversion that printed rippled JSON and parsed it back, kept for comparison
+BENCHMARK_CAPTURE(benchmarkStyledStringRoundTrip, payment, createPayment());
+BENCHMARK_CAPTURE(benchmarkStyledStringRoundTrip, meta, createMeta());
+
+BENCHMARK_CAPTURE(benchmarkToJson, payment, createPayment());
+BENCHMARK_CAPTURE(benchmarkToJson, meta, createMeta());
@@ -0,0 +1,77 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+/*
+ * Measures the throughput of the DOSGuard calls made for every request when many threads handle requests at once.
+ * Every thread plays a different client, so the guard itself should be the only shared state.
+ */
+
+#include "util/config/Config.hpp"
+#include "web/dosguard/DOSGuard.hpp"
+#include "web/dosguard/WhitelistHandlerInterface.hpp"
+
+#include <benchmark/benchmark.h>
+#include <boost/json/parse.hpp>
+#include <fmt/core.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+struct EmptyWhitelistHandler : web::dosguard::WhitelistHandlerInterface {
+    [[nodiscard]] bool
+    isWhiteListed(std::string_view) const override
+    {
+        return false;
+    }
+};
+
+EmptyWhitelistHandler const WHITELIST_HANDLER;
+std::unique_ptr<web::dosguard::DOSGuard> dosGuard;  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+void
+benchmarkDOSGuardRequests(benchmark::State& state)
+{
+    if (state.thread_index() == 0) {
+        util::Config const cfg{boost::json::parse(R"JSON({
+            "dos_guard": {"max_fetches": 4000000000, "max_requests": 4000000000, "max_connections": 4000000000}
+        })JSON")};
+        dosGuard = std::make_unique<web::dosguard::DOSGuard>(cfg, WHITELIST_HANDLER);
+    }
+
+    auto const ip = fmt::format("10.0.{}.{}", state.thread_index() / 256, state.thread_index() % 256);
+
+    // the same calls a websocket request makes: count the request, check the client and account the response size
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dosGuard->request(ip));
+        benchmark::DoNotOptimize(dosGuard->isOk(ip));
+        benchmark::DoNotOptimize(dosGuard->add(ip, 1024));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+        dosGuard->clear();
+}
+
+}  // namespace
+
+BENCHMARK(benchmarkDOSGuardRequests)->ThreadRange(1, 32)->UseRealTime();
@@ -0,0 +1,11 @@
+set(LOG_LEVELS "trace;debug;info;warning;error;fatal")
+
+list(FIND LOG_LEVELS "${min_log_level}" MIN_LOG_SEVERITY)
+if (MIN_LOG_SEVERITY EQUAL -1)
+  message(FATAL_ERROR "Invalid min_log_level '${min_log_level}', expected one of: ${LOG_LEVELS}")
+endif ()
+
+if (MIN_LOG_SEVERITY GREATER 0)
+  message(STATUS "Log statements below ${min_log_level} are removed")
+endif ()
+target_compile_definitions(clio_options INTERFACE CLIO_MIN_LOG_SEVERITY=${MIN_LOG_SEVERITY})
@@ -19,6 +19,7 @@ class Clio(ConanFile):
         'packaging': [True, False],           # create distribution packages
         'coverage': [True, False],            # build for test coverage report; create custom target `clio_tests-ccov`
         'lint': [True, False],                # run clang-tidy checks during compilation
+        'min_log_level': ['trace', 'debug', 'info', 'warning', 'error', 'fatal'],  # drop lower log levels at compile time
     }
 
     requires = [
@@ -43,6 +44,7 @@ class Clio(ConanFile):
         'coverage': False,
         'lint': False,
         'docs': False,
+        'min_log_level': 'trace',
         
         'xrpl/*:tests': False,
         'xrpl/*:rocksdb': False,
@@ -91,6 +93,7 @@ class Clio(ConanFile):
         tc.variables['docs'] = self.options.docs
         tc.variables['packaging'] = self.options.packaging
         tc.variables['benchmark'] = self.options.benchmark
+        tc.variables['min_log_level'] = self.options.min_log_level
         tc.generate()
 
     def build(self):
@@ -64,6 +64,16 @@ BackendCounters::BackendCounters()
           Labels({Label{"operation", "write_sync_retry"}}),
           "The total number of times the backend had to retry a synchronous write"
       ))
+    , readBatchedCounter_(PrometheusService::counterInt(
+          "backend_operations_total_number",
+          Labels({Label{"operation", "read_batched"}}),
+          "The total number of read queries fetching several keys at once"
+      ))
+    , readBatchedKeysCounter_(PrometheusService::counterInt(
+          "backend_batched_read_keys_total_number",
+          Labels(),
+          "The total number of keys fetched by read queries fetching several keys at once"
+      ))
     , asyncWriteCounters_{"write_async"}
     , asyncReadCounters_{"read_async"}
     , readDurationHistogram_(PrometheusService::histogramInt(
@@ -154,6 +164,13 @@ BackendCounters::registerReadError(std::uint64_t const count)
     asyncReadCounters_.registerError(count);
 }
 
+void
+BackendCounters::registerReadBatched(std::uint64_t const numKeys)
+{
+    ++readBatchedCounter_.get();
+    readBatchedKeysCounter_.get() += numKeys;
+}
+
 boost::json::object
 BackendCounters::report() const
 {
@@ -161,6 +178,8 @@ BackendCounters::report() const
     result["too_busy"] = tooBusyCounter_.get().value();
     result["write_sync"] = writeSyncCounter_.get().value();
     result["write_sync_retry"] = writeSyncRetryCounter_.get().value();
+    result["read_batched"] = readBatchedCounter_.get().value();
+    result["read_batched_keys"] = readBatchedKeysCounter_.get().value();
     for (auto const& [key, value] : asyncWriteCounters_.report())
         result[key] = value;
     for (auto const& [key, value] : asyncReadCounters_.report())
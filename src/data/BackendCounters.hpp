@@ -49,6 +49,7 @@ concept SomeBackendCounters = requires(T a) {
     { a.registerReadFinished(std::chrono::steady_clock::time_point{}, std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadRetry(std::uint64_t{}) } -> std::same_as<void>;
     { a.registerReadError(std::uint64_t{}) } -> std::same_as<void>;
+    { a.registerReadBatched(std::uint64_t{}) } -> std::same_as<void>;
     { a.report() } -> std::same_as<boost::json::object>;
 };
 
@@ -142,6 +143,14 @@ public:
     void
     registerReadError(std::uint64_t count = 1u);
 
+    /**
+     * @brief Register that a read operation fetched several keys with one query
+     *
+     * @param numKeys The number of keys the query fetched
+     */
+    void
+    registerReadBatched(std::uint64_t numKeys);
+
     /**
      * @brief Get a report of the backend counters
      *
@@ -185,6 +194,9 @@ private:
     std::reference_wrapper<util::prometheus::CounterInt> writeSyncCounter_;
     std::reference_wrapper<util::prometheus::CounterInt> writeSyncRetryCounter_;
 
+    std::reference_wrapper<util::prometheus::CounterInt> readBatchedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> readBatchedKeysCounter_;
+
     AsyncOperationCounters asyncWriteCounters_{"write_async"};
     AsyncOperationCounters asyncReadCounters_{"read_async"};
 
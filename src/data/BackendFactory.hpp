@@ -21,6 +21,7 @@
 
 #include "data/BackendInterface.hpp"
 #include "data/CassandraBackend.hpp"
+#include "data/LedgerHeaderCache.hpp"
 #include "data/cassandra/SettingsProvider.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
@@ -28,6 +29,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -47,13 +49,17 @@ make_Backend(util::Config const& config)
     LOG(log.info()) << "Constructing BackendInterface";
 
     auto const readOnly = config.valueOr("read_only", false);
+    auto const ledgerHeaderCacheCapacity =
+        config.valueOr<std::size_t>("cache.ledger_headers", LedgerHeaderCache::DEFAULT_CAPACITY);
 
     auto const type = config.value<std::string>("database.type");
     std::shared_ptr<BackendInterface> backend = nullptr;
 
     if (boost::iequals(type, "cassandra")) {
         auto cfg = config.section("database." + type);
-        backend = std::make_shared<data::cassandra::CassandraBackend>(data::cassandra::SettingsProvider{cfg}, readOnly);
+        backend = std::make_shared<data::cassandra::CassandraBackend>(
+            data::cassandra::SettingsProvider{cfg}, readOnly, ledgerHeaderCacheCapacity
+        );
     }
 
     if (!backend)
@@ -19,6 +19,7 @@
 
 #include "data/BackendInterface.hpp"
 
+#include "data/LedgerCache.hpp"
 #include "data/Types.hpp"
 #include "util/Assert.hpp"
 #include "util/log/Logger.hpp"
@@ -35,6 +36,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
@@ -59,7 +61,7 @@ bool
 BackendInterface::finishWrites(std::uint32_t const ledgerSequence)
 {
     LOG(gLog.debug()) << "Want finish writes for " << ledgerSequence;
-    auto commitRes = doFinishWrites();
+    auto commitRes = doFinishWrites(ledgerSequence);
     if (commitRes) {
         LOG(gLog.debug()) << "Successfully commited. Updating range now to " << ledgerSequence;
         updateRange(ledgerSequence);
@@ -80,55 +82,50 @@ BackendInterface::hardFetchLedgerRangeNoThrow() const
 }
 
 // *** state data methods
-std::optional<Blob>
-BackendInterface::fetchLedgerObject(
+namespace {
+
+// ObjectType is a Blob or a BlobView; fromCache is the LedgerCache lookup returning it
+template <typename ObjectType, typename CacheFetchType>
+std::optional<ObjectType>
+fetchFromCacheOrDb(
+    BackendInterface const& backend,
+    CacheFetchType const& fromCache,
     ripple::uint256 const& key,
     std::uint32_t const sequence,
     boost::asio::yield_context yield
-) const
+)
 {
-    auto obj = cache_.get(key, sequence);
-    if (obj) {
+    if (auto obj = fromCache(key, sequence); obj) {
         LOG(gLog.trace()) << "Cache hit - " << ripple::strHex(key);
         return obj;
     }
 
-    auto dbObj = doFetchLedgerObject(key, sequence, yield);
+    auto dbObj = backend.doFetchLedgerObject(key, sequence, yield);
     if (!dbObj) {
         LOG(gLog.trace()) << "Missed cache and missed in db";
-    } else {
-        LOG(gLog.trace()) << "Missed cache but found in db";
+        return std::nullopt;
     }
-    return dbObj;
-}
 
-std::optional<std::uint32_t>
-BackendInterface::fetchLedgerObjectSeq(
-    ripple::uint256 const& key,
-    std::uint32_t const sequence,
-    boost::asio::yield_context yield
-) const
-{
-    auto seq = doFetchLedgerObjectSeq(key, sequence, yield);
-    if (!seq)
-        LOG(gLog.trace()) << "Missed in db";
-    return seq;
+    LOG(gLog.trace()) << "Missed cache but found in db";
+    return ObjectType(std::move(*dbObj));
 }
 
-std::vector<Blob>
-BackendInterface::fetchLedgerObjects(
+template <typename ObjectType, typename CacheFetchType>
+std::vector<ObjectType>
+fetchAllFromCacheOrDb(
+    BackendInterface const& backend,
+    CacheFetchType const& fromCache,
     std::vector<ripple::uint256> const& keys,
     std::uint32_t const sequence,
     boost::asio::yield_context yield
-) const
+)
 {
-    std::vector<Blob> results;
+    std::vector<ObjectType> results;
     results.resize(keys.size());
     std::vector<ripple::uint256> misses;
     for (size_t i = 0; i < keys.size(); ++i) {
-        auto obj = cache_.get(keys[i], sequence);
-        if (obj) {
-            results[i] = *obj;
+        if (auto obj = fromCache(keys[i], sequence); obj) {
+            results[i] = std::move(*obj);
         } else {
             misses.push_back(keys[i]);
         }
@@ -136,10 +133,10 @@ BackendInterface::fetchLedgerObjects(
     LOG(gLog.trace()) << "Cache hits = " << keys.size() - misses.size() << " - cache misses = " << misses.size();
 
     if (!misses.empty()) {
-        auto objs = doFetchLedgerObjects(misses, sequence, yield);
+        auto objs = backend.doFetchLedgerObjects(misses, sequence, yield);
         for (size_t i = 0, j = 0; i < results.size(); ++i) {
             if (results[i].empty()) {
-                results[i] = objs[j];
+                results[i] = ObjectType(std::move(objs[j]));
                 ++j;
             }
         }
@@ -148,6 +145,63 @@ BackendInterface::fetchLedgerObjects(
     return results;
 }
 
+}  // namespace
+
+std::optional<Blob>
+BackendInterface::fetchLedgerObject(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+) const
+{
+    return fetchFromCacheOrDb<Blob>(*this, std::bind_front(&LedgerCache::get, &cache_), key, sequence, yield);
+}
+
+std::optional<BlobView>
+BackendInterface::fetchLedgerObjectView(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+) const
+{
+    return fetchFromCacheOrDb<BlobView>(*this, std::bind_front(&LedgerCache::getView, &cache_), key, sequence, yield);
+}
+
+std::optional<std::uint32_t>
+BackendInterface::fetchLedgerObjectSeq(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+) const
+{
+    auto seq = doFetchLedgerObjectSeq(key, sequence, yield);
+    if (!seq)
+        LOG(gLog.trace()) << "Missed in db";
+    return seq;
+}
+
+std::vector<Blob>
+BackendInterface::fetchLedgerObjects(
+    std::vector<ripple::uint256> const& keys,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+) const
+{
+    return fetchAllFromCacheOrDb<Blob>(*this, std::bind_front(&LedgerCache::get, &cache_), keys, sequence, yield);
+}
+
+std::vector<BlobView>
+BackendInterface::fetchLedgerObjectViews(
+    std::vector<ripple::uint256> const& keys,
+    std::uint32_t const sequence,
+    boost::asio::yield_context yield
+) const
+{
+    return fetchAllFromCacheOrDb<BlobView>(
+        *this, std::bind_front(&LedgerCache::getView, &cache_), keys, sequence, yield
+    );
+}
+
 // Fetches the successor to key/index
 std::optional<ripple::uint256>
 BackendInterface::fetchSuccessorKey(
@@ -362,7 +416,7 @@ BackendInterface::fetchFees(std::uint32_t const seq, boost::asio::yield_context
     ripple::Fees fees;
 
     auto key = ripple::keylet::fees().key;
-    auto bytes = fetchLedgerObject(key, seq, yield);
+    auto bytes = fetchLedgerObjectView(key, seq, yield);
 
     if (!bytes) {
         LOG(gLog.error()) << "Could not find fees";
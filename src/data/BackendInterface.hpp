@@ -21,6 +21,8 @@
 
 #include "data/DBHelpers.hpp"
 #include "data/LedgerCache.hpp"
+#include "data/LedgerCloseTimeIndex.hpp"
+#include "data/LedgerHeaderCache.hpp"
 #include "data/Types.hpp"
 #include "etl/CorruptionDetector.hpp"
 #include "util/log/Logger.hpp"
@@ -140,10 +142,21 @@ protected:
     mutable std::shared_mutex rngMtx_;
     std::optional<LedgerRange> range;
     LedgerCache cache_;
+    LedgerCloseTimeIndex closeTimeIndex_;
+    mutable LedgerHeaderCache headerCache_;  // filled by the const fetch functions of the backend
     std::optional<etl::CorruptionDetector<LedgerCache>> corruptionDetector_;
 
 public:
-    BackendInterface() = default;
+    /**
+     * @brief Construct the backend interface.
+     *
+     * @param ledgerHeaderCacheCapacity The maximum number of ledger headers to cache; 0 disables the cache
+     */
+    explicit BackendInterface(std::size_t ledgerHeaderCacheCapacity = LedgerHeaderCache::DEFAULT_CAPACITY)
+        : headerCache_{ledgerHeaderCacheCapacity}
+    {
+    }
+
     virtual ~BackendInterface() = default;
 
     // TODO: Remove this hack. Cache should not be exposed thru BackendInterface
@@ -165,6 +178,42 @@ public:
         return cache_;
     }
 
+    /**
+     * @return Immutable index of ledger close times
+     */
+    LedgerCloseTimeIndex const&
+    closeTimeIndex() const
+    {
+        return closeTimeIndex_;
+    }
+
+    /**
+     * @return Mutable index of ledger close times
+     */
+    LedgerCloseTimeIndex&
+    closeTimeIndex()
+    {
+        return closeTimeIndex_;
+    }
+
+    /**
+     * @return Immutable cache of ledger headers
+     */
+    LedgerHeaderCache const&
+    ledgerHeaderCache() const
+    {
+        return headerCache_;
+    }
+
+    /**
+     * @return Mutable cache of ledger headers
+     */
+    LedgerHeaderCache&
+    ledgerHeaderCache()
+    {
+        return headerCache_;
+    }
+
     /**
      * @brief Sets the corruption detector.
      *
@@ -186,6 +235,18 @@ public:
     virtual std::optional<ripple::LedgerHeader>
     fetchLedgerBySequence(std::uint32_t sequence, boost::asio::yield_context yield) const = 0;
 
+    /**
+     * @brief Fetches a specific ledger by sequence number from DB, bypassing the ledger header cache.
+     *
+     * Meant for bulk and background readers which would otherwise evict the headers that requests need.
+     *
+     * @param sequence The sequence number to fetch for
+     * @param yield The coroutine context
+     * @return The ripple::LedgerHeader if found; nullopt otherwise
+     */
+    virtual std::optional<ripple::LedgerHeader>
+    hardFetchLedgerBySequence(std::uint32_t sequence, boost::asio::yield_context yield) const = 0;
+
     /**
      * @brief Fetches a specific ledger by hash.
      *
@@ -378,6 +439,21 @@ public:
     std::optional<Blob>
     fetchLedgerObject(ripple::uint256 const& key, std::uint32_t sequence, boost::asio::yield_context yield) const;
 
+    /**
+     * @brief Fetches a specific ledger object without copying it out of the cache.
+     *
+     * Works like fetchLedgerObject but on a cache hit the returned view points directly into cache memory. The view
+     * keeps that memory alive for as long as it exists, so it can be held for the duration of a request and parsed
+     * in place. On a cache miss the view owns the data fetched from the DB.
+     *
+     * @param key The key of the object
+     * @param sequence The ledger sequence to fetch for
+     * @param yield The coroutine context
+     * @return A view of the object on success; nullopt otherwise
+     */
+    std::optional<BlobView>
+    fetchLedgerObjectView(ripple::uint256 const& key, std::uint32_t sequence, boost::asio::yield_context yield) const;
+
     /**
      * @brief Fetches a specific ledger object sequence.
      *
@@ -409,6 +485,23 @@ public:
         boost::asio::yield_context yield
     ) const;
 
+    /**
+     * @brief Fetches all ledger objects by their keys without copying cached objects.
+     *
+     * Works like fetchLedgerObjects but returns views; see fetchLedgerObjectView for details.
+     *
+     * @param keys A vector with the keys of the objects to fetch
+     * @param sequence The ledger sequence to fetch for
+     * @param yield The coroutine context
+     * @return A vector of views of the ledger objects; views of objects that were not found are empty
+     */
+    std::vector<BlobView>
+    fetchLedgerObjectViews(
+        std::vector<ripple::uint256> const& keys,
+        std::uint32_t sequence,
+        boost::asio::yield_context yield
+    ) const;
+
     /**
      * @brief The database-specific implementation for fetching a ledger object.
      *
@@ -670,12 +763,15 @@ private:
     doWriteLedgerObject(std::string&& key, std::uint32_t seq, std::string&& blob) = 0;
 
     /**
-     * @brief The implementation should wait for all pending writes to finish
+     * @brief The implementation should wait for the pending writes of the ledger to finish and commit it
+     *
+     * Writes of later ledgers may already be in flight; ledgers are finished in order.
      *
+     * @param ledgerSequence The ledger sequence to finish writing for
      * @return true on success; false otherwise
      */
     virtual bool
-    doFinishWrites() = 0;
+    doFinishWrites(std::uint32_t ledgerSequence) = 0;
 };
 
 }  // namespace data
@@ -21,6 +21,7 @@
 
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
+#include "data/LedgerHeaderCache.hpp"
 #include "data/Types.hpp"
 #include "data/cassandra/Handle.hpp"
 #include "data/cassandra/Schema.hpp"
@@ -43,12 +44,13 @@
 #include <xrpl/protocol/LedgerHeader.h>
 #include <xrpl/protocol/nft.h>
 
-#include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -77,7 +79,11 @@ class BasicCassandraBackend : public BackendInterface {
     // have to be mutable because BackendInterface constness :(
     mutable ExecutionStrategyType executor_;
 
-    std::atomic_uint32_t ledgerSequence_ = 0u;
+    std::size_t readBatchSize_;
+
+    // write group of each ledger whose writes are not finished yet
+    std::mutex writeGroupsMutex_;
+    std::map<std::uint32_t, std::uint64_t> writeGroups_;
 
 public:
     /**
@@ -85,12 +91,19 @@ public:
      *
      * @param settingsProvider The settings provider to use
      * @param readOnly Whether the database should be in readonly mode
+     * @param ledgerHeaderCacheCapacity The maximum number of ledger headers to cache; 0 disables the cache
      */
-    BasicCassandraBackend(SettingsProviderType settingsProvider, bool readOnly)
-        : settingsProvider_{std::move(settingsProvider)}
+    BasicCassandraBackend(
+        SettingsProviderType settingsProvider,
+        bool readOnly,
+        std::size_t ledgerHeaderCacheCapacity = LedgerHeaderCache::DEFAULT_CAPACITY
+    )
+        : BackendInterface{ledgerHeaderCacheCapacity}
+        , settingsProvider_{std::move(settingsProvider)}
         , schema_{settingsProvider_}
         , handle_{settingsProvider_.getSettings()}
         , executor_{settingsProvider_.getSettings(), handle_}
+        , readBatchSize_{settingsProvider_.getSettings().readBatchSize}
     {
         if (auto const res = handle_.connect(); not res)
             throw std::runtime_error("Could not connect to databse: " + res.error());
@@ -186,32 +199,41 @@ public:
     }
 
     bool
-    doFinishWrites() override
+    doFinishWrites(std::uint32_t ledgerSequence) override
     {
-        // wait for other threads to finish their writes
-        executor_.sync();
+        // wait for the writes of this ledger; the writes of the ledgers after it may still be in flight
+        if (auto const group = takeWriteGroup(ledgerSequence); group.has_value()) {
+            executor_.sync(*group);
+        } else {
+            executor_.sync();
+        }
 
         if (!range) {
-            executor_.writeSync(schema_->updateLedgerRange, ledgerSequence_, false, ledgerSequence_);
+            executor_.writeSync(schema_->updateLedgerRange, ledgerSequence, false, ledgerSequence);
         }
 
-        if (not executeSyncUpdate(schema_->updateLedgerRange.bind(ledgerSequence_, true, ledgerSequence_ - 1))) {
-            LOG(log_.warn()) << "Update failed for ledger " << ledgerSequence_;
+        if (not executeSyncUpdate(
+                schema_->updateLedgerRange.bind(ledgerSequence, true, ledgerSequence - 1), ledgerSequence
+            )) {
+            LOG(log_.warn()) << "Update failed for ledger " << ledgerSequence;
             return false;
         }
 
-        LOG(log_.info()) << "Committed ledger " << ledgerSequence_;
+        LOG(log_.info()) << "Committed ledger " << ledgerSequence;
         return true;
     }
 
     void
     writeLedger(ripple::LedgerHeader const& ledgerHeader, std::string&& blob) override
     {
+        {
+            std::scoped_lock const lock{writeGroupsMutex_};
+            writeGroups_[ledgerHeader.seq] = executor_.startWriteGroup();
+        }
+
         executor_.write(schema_->insertLedgerHeader, ledgerHeader.seq, std::move(blob));
 
         executor_.write(schema_->insertLedgerHash, ledgerHeader.hash, ledgerHeader.seq);
-
-        ledgerSequence_ = ledgerHeader.seq;
     }
 
     std::optional<std::uint32_t>
@@ -236,6 +258,19 @@ public:
 
     std::optional<ripple::LedgerHeader>
     fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::yield_context yield) const override
+    {
+        if (auto header = headerCache_.get(sequence); header.has_value())
+            return header;
+
+        auto header = hardFetchLedgerBySequence(sequence, yield);
+        if (header.has_value())
+            headerCache_.put(*header);
+
+        return header;
+    }
+
+    std::optional<ripple::LedgerHeader>
+    hardFetchLedgerBySequence(std::uint32_t const sequence, boost::asio::yield_context yield) const override
     {
         auto const res = executor_.read(yield, schema_->selectLedgerBySeq, sequence);
         if (res) {
@@ -259,6 +294,9 @@ public:
     std::optional<ripple::LedgerHeader>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context yield) const override
     {
+        if (auto header = headerCache_.get(hash); header.has_value())
+            return header;
+
         if (auto const res = executor_.read(yield, schema_->selectLedgerByHash, hash); res) {
             if (auto const& result = res.value(); result) {
                 if (auto const maybeValue = result.template get<uint32_t>(); maybeValue)
@@ -635,7 +673,22 @@ public:
         statements.reserve(numHashes);
 
         auto const timeDiff = util::timed([this, yield, &results, &hashes, &statements]() {
-            // TODO: seems like a job for "hash IN (list of hashes)" instead?
+            if (readBatchSize_ > 0) {
+                std::map<ripple::uint256, TransactionAndMetadata> found;
+                auto const entries = executor_.readBatched(yield, schema_->selectTransactions, hashes, readBatchSize_);
+                for (auto const& result : entries) {
+                    for (auto [hash, txn, meta, seq, date] :
+                         extract<ripple::uint256, Blob, Blob, uint32_t, uint32_t>(result))
+                        found.emplace(hash, TransactionAndMetadata{std::move(txn), std::move(meta), seq, date});
+                }
+
+                for (auto const& hash : hashes) {
+                    auto const it = found.find(hash);
+                    results.push_back(it != found.end() ? it->second : TransactionAndMetadata{});
+                }
+                return;
+            }
+
             std::transform(
                 std::cbegin(hashes),
                 std::cend(hashes),
@@ -679,10 +732,26 @@ public:
         std::vector<Blob> results;
         results.reserve(numKeys);
 
+        if (readBatchSize_ > 0) {
+            std::map<ripple::uint256, Blob> found;
+            auto const entries = executor_.readBatched(yield, schema_->selectObjects, keys, readBatchSize_, sequence);
+            for (auto const& result : entries) {
+                for (auto [key, object] : extract<ripple::uint256, Blob>(result))
+                    found.emplace(key, std::move(object));
+            }
+
+            for (auto const& key : keys) {
+                auto const it = found.find(key);
+                results.push_back(it != found.end() ? it->second : Blob{});
+            }
+
+            LOG(log_.trace()) << "Fetched " << numKeys << " objects in batches of " << readBatchSize_;
+            return results;
+        }
+
         std::vector<Statement> statements;
         statements.reserve(numKeys);
 
-        // TODO: seems like a job for "key IN (list of keys)" instead?
         std::transform(
             std::cbegin(keys),
             std::cend(keys),
@@ -925,8 +994,21 @@ public:
     }
 
 private:
+    std::optional<std::uint64_t>
+    takeWriteGroup(std::uint32_t ledgerSequence)
+    {
+        std::scoped_lock const lock{writeGroupsMutex_};
+        auto const it = writeGroups_.find(ledgerSequence);
+        if (it == writeGroups_.end())
+            return std::nullopt;
+
+        auto const group = it->second;
+        writeGroups_.erase(writeGroups_.begin(), std::next(it));
+        return group;
+    }
+
     bool
-    executeSyncUpdate(Statement statement)
+    executeSyncUpdate(Statement statement, std::uint32_t ledgerSequence)
     {
         auto const res = executor_.writeSync(statement);
         auto maybeSuccess = res->template get<bool>();
@@ -943,7 +1025,7 @@ private:
             // against what we were trying to write in the first place and
             // use that as the source of truth for the result.
             auto rng = hardFetchLedgerRangeNoThrow();
-            return rng && rng->maxSequence == ledgerSequence_;
+            return rng && rng->maxSequence == ledgerSequence;
         }
 
         return true;
@@ -20,23 +20,117 @@
 #include "data/LedgerCache.hpp"
 
 #include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+#include "data/impl/CacheSnapshot.hpp"
 #include "util/Assert.hpp"
 
+#include <fmt/core.h>
 #include <xrpl/basics/base_uint.h>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <iterator>
 #include <mutex>
+#include <numeric>
 #include <optional>
 #include <shared_mutex>
+#include <span>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace data {
 
+namespace {
+
+Blob
+toBlob(std::span<unsigned char const> bytes)
+{
+    return {bytes.begin(), bytes.end()};
+}
+
+template <typename EntriesType>
+auto
+lowerBound(EntriesType& entries, ripple::uint256 const& key)
+{
+    return std::ranges::lower_bound(entries, key, std::less<>{}, [](auto const& entry) { return entry.first; });
+}
+
+template <typename EntriesType>
+auto
+upperBound(EntriesType& entries, ripple::uint256 const& key)
+{
+    return std::ranges::upper_bound(entries, key, std::less<>{}, [](auto const& entry) { return entry.first; });
+}
+
+}  // namespace
+
+std::size_t
+LedgerCache::shardIndex(ripple::uint256 const& key)
+{
+    // uint256 compares bytewise, so indexing shards by the leading bytes keeps the order of keys across shards: all
+    // keys in shard N are less than all keys in shard N + 1
+    static_assert(SHARD_BITS == 16, "Shard index is built from the two leading bytes of the key");
+    return (static_cast<std::size_t>(key.data()[0]) << 8) | static_cast<std::size_t>(key.data()[1]);
+}
+
+void
+LedgerCache::compact(Shard& shard)
+{
+    impl::BlobArena fresh;
+    fresh.reserve(shard.arena.liveBytes());
+
+    // readers holding views into the old arena keep its slabs alive until they are done
+    for (auto& [_, entry] : shard.entries)
+        entry.blob = fresh.append(shard.arena.bytes(entry.blob));
+    for (auto& version : shard.history)
+        version.blob = fresh.append(shard.arena.bytes(version.blob));
+
+    shard.arena = std::move(fresh);
+}
+
+void
+LedgerCache::pruneHistory(Shard& shard, uint32_t seq, uint32_t window)
+{
+    // a version is needed as long as any of the sequences it is valid for is inside the window
+    auto const expired = std::ranges::partition(shard.history, [seq, window](auto const& version) {
+        return static_cast<uint64_t>(version.toSeq) + window > seq;
+    });
+
+    for (auto const& version : expired) {
+        shard.arena.release(version.blob);
+        shard.historyBytes -= version.blob.size;
+    }
+    shard.history.erase(expired.begin(), expired.end());
+}
+
+void
+LedgerCache::sweepHistory(uint32_t seq, uint32_t window)
+{
+    // shards that no ledger touches anymore would otherwise hold on to their expired versions forever
+    for (auto i = 0u; i < HISTORY_SWEEP_SHARDS; ++i, sweepCursor_ = (sweepCursor_ + 1) % SHARD_COUNT) {
+        auto& shard = shards_[sweepCursor_];
+        std::scoped_lock const lck{shard.mtx};
+        if (shard.history.empty())
+            continue;
+
+        auto const liveBefore = shard.arena.liveBytes();
+        auto const historyBefore = shard.historyBytes;
+
+        pruneHistory(shard, seq, window);
+
+        liveBytesGauge_.get() += static_cast<int64_t>(shard.arena.liveBytes()) - static_cast<int64_t>(liveBefore);
+        historyBytesGauge_.get() += static_cast<int64_t>(shard.historyBytes) - static_cast<int64_t>(historyBefore);
+    }
+}
+
 uint32_t
 LedgerCache::latestLedgerSequence() const
 {
-    std::shared_lock const lck{mtx_};
     return latestSeq_;
 }
 
@@ -57,32 +151,100 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
     if (disabled_)
         return;
 
-    {
-        std::scoped_lock const lck{mtx_};
-        if (seq > latestSeq_) {
-            ASSERT(
-                seq == latestSeq_ + 1 || latestSeq_ == 0,
-                "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
-                seq,
-                latestSeq_
-            );
-            latestSeq_ = seq;
-        }
-        for (auto const& obj : objs) {
+    // deletes_ is only relevant while the cache is loading; once full there are no background writers left
+    std::unique_lock deletesLock{deletesMtx_, std::defer_lock};
+    if (not full_)
+        deletesLock.lock();
+
+    // group the objects by shard so that each shard is locked at most once per update. stable sort keeps the order
+    // of updates to the same key as they were given to us
+    std::vector<std::size_t> order(objs.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::stable_sort(order, std::less<>{}, [&objs](auto idx) { return shardIndex(objs[idx].key); });
+
+    // only new ledgers create history; background writers fill in data that was not superseded yet
+    auto const window = isBackground ? 0u : historyWindow_.load();
+
+    for (auto it = order.begin(); it != order.end();) {
+        auto& shard = shards_[shardIndex(objs[*it].key)];
+        std::scoped_lock const lck{shard.mtx};
+
+        if (not isBackground)
+            shard.lastModifiedSeq = std::max(shard.lastModifiedSeq, seq);
+
+        auto const allocatedBefore = shard.arena.allocatedBytes();
+        auto const liveBefore = shard.arena.liveBytes();
+        auto const historyBefore = shard.historyBytes;
+
+        auto const retire = [&shard, seq, window](ripple::uint256 const& key, CacheEntry const& entry) {
+            // an object written and replaced within the same ledger was never visible to anyone
+            if (window == 0 or entry.seq == seq) {
+                shard.arena.release(entry.blob);
+                return;
+            }
+            shard.history.push_back({key, entry.seq, seq, entry.blob});
+            shard.historyBytes += entry.blob.size;
+        };
+
+        auto const current = shardIndex(objs[*it].key);
+        for (; it != order.end() and shardIndex(objs[*it].key) == current; ++it) {
+            auto const& obj = objs[*it];
+            auto pos = lowerBound(shard.entries, obj.key);
+            auto const found = pos != shard.entries.end() and pos->first == obj.key;
+
             if (!obj.blob.empty()) {
                 if (isBackground && deletes_.contains(obj.key))
                     continue;
 
-                auto& e = map_[obj.key];
-                if (seq > e.seq) {
-                    e = {seq, obj.blob};
+                if (not found) {
+                    shard.entries.insert(pos, {obj.key, {seq, shard.arena.append(obj.blob)}});
+                    ++size_;
+                } else if (seq > pos->second.seq) {
+                    retire(pos->first, pos->second);
+                    pos->second = {seq, shard.arena.append(obj.blob)};
                 }
             } else {
-                map_.erase(obj.key);
+                if (found) {
+                    retire(pos->first, pos->second);
+                    shard.entries.erase(pos);
+                    --size_;
+                }
                 if (!full_ && !isBackground)
                     deletes_.insert(obj.key);
             }
         }
+
+        if (window != 0)
+            pruneHistory(shard, seq, window);
+
+        if (shard.arena.shouldCompact())
+            compact(shard);
+
+        allocatedBytesGauge_.get() +=
+            static_cast<int64_t>(shard.arena.allocatedBytes()) - static_cast<int64_t>(allocatedBefore);
+        liveBytesGauge_.get() += static_cast<int64_t>(shard.arena.liveBytes()) - static_cast<int64_t>(liveBefore);
+        historyBytesGauge_.get() += static_cast<int64_t>(shard.historyBytes) - static_cast<int64_t>(historyBefore);
+    }
+
+    if (window != 0) {
+        sweepHistory(seq, window);
+
+        if (historyStartSeq_ == 0)
+            historyStartSeq_ = seq;
+        historyDepthGauge_.get().set(std::min<int64_t>(window, seq - historyStartSeq_));
+    }
+
+    {
+        std::scoped_lock const lck{mtx_};
+        if (seq > latestSeq_) {
+            ASSERT(
+                seq == latestSeq_ + 1 || latestSeq_ == 0,
+                "New sequense must be either next or first. seq = {}, latestSeq_ = {}",
+                seq,
+                latestSeq_.load()
+            );
+            latestSeq_ = seq;
+        }
         cv_.notify_all();
     }
 }
@@ -93,15 +255,26 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     ++successorReqCounter_.get();
     if (seq != latestSeq_)
         return {};
-    auto e = map_.upper_bound(key);
-    if (e == map_.end())
-        return {};
-    ++successorHitCounter_.get();
-    return {{e->first, e->second.blob}};
+
+    auto const first = shardIndex(key);
+    for (auto idx = first; idx < SHARD_COUNT; ++idx) {
+        auto const& shard = shards_[idx];
+        std::shared_lock const lck{shard.mtx};
+
+        // the shard was changed by a ledger newer than requested so its content can't be trusted for seq
+        if (shard.lastModifiedSeq > seq)
+            return {};
+
+        auto const e = idx == first ? upperBound(shard.entries, key) : shard.entries.begin();
+        if (e != shard.entries.end()) {
+            ++successorHitCounter_.get();
+            return {{e->first, toBlob(shard.arena.bytes(e->second.blob))}};
+        }
+    }
+    return {};
 }
 
 std::optional<LedgerObject>
@@ -110,33 +283,167 @@ LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
     if (disabled_ or not full_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     if (seq != latestSeq_)
         return {};
-    auto e = map_.lower_bound(key);
-    if (e == map_.begin())
-        return {};
-    --e;
-    return {{e->first, e->second.blob}};
+
+    for (auto idx = shardIndex(key) + 1; idx-- > 0;) {
+        auto const& shard = shards_[idx];
+        std::shared_lock const lck{shard.mtx};
+
+        if (shard.lastModifiedSeq > seq)
+            return {};
+
+        auto const e = lowerBound(shard.entries, key);
+        if (e != shard.entries.begin()) {
+            auto const prev = std::prev(e);
+            return {{prev->first, toBlob(shard.arena.bytes(prev->second.blob))}};
+        }
+    }
+    return {};
 }
 
 std::optional<Blob>
 LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
+{
+    if (auto const view = getView(key, seq); view.has_value())
+        return view->toBlob();
+    return {};
+}
+
+std::optional<BlobView>
+LedgerCache::getView(ripple::uint256 const& key, uint32_t seq) const
 {
     if (disabled_)
         return {};
 
-    std::shared_lock const lck{mtx_};
     if (seq > latestSeq_)
         return {};
+
     ++objectReqCounter_.get();
-    auto e = map_.find(key);
-    if (e == map_.end())
-        return {};
-    if (seq < e->second.seq)
+    auto const& shard = shards_[shardIndex(key)];
+    std::shared_lock const lck{shard.mtx};
+
+    auto const e = lowerBound(shard.entries, key);
+    if (e != shard.entries.end() and e->first == key and seq >= e->second.seq) {
+        ++objectHitCounter_.get();
+        return shard.arena.view(e->second.blob);
+    }
+
+    // the object was modified after seq or deleted; an older version may still be around
+    auto const it = std::ranges::find_if(shard.history, [&key, seq](auto const& version) {
+        return version.key == key and version.fromSeq <= seq and seq < version.toSeq;
+    });
+    if (it == shard.history.end())
         return {};
+
     ++objectHitCounter_.get();
-    return {e->second.blob};
+    return shard.arena.view(it->blob);
+}
+
+std::expected<uint32_t, std::string>
+LedgerCache::writeSnapshot(std::filesystem::path const& path) const
+{
+    if (disabled_ or not full_)
+        return std::unexpected{"Cache is not fully loaded"};
+
+    auto const seq = latestSeq_.load();
+    auto writer = impl::CacheSnapshotWriter::open(path, seq);
+    if (not writer.has_value())
+        return std::unexpected{std::move(writer).error()};
+
+    for (auto const& shard : shards_) {
+        std::shared_lock const lck{shard.mtx};
+        for (auto const& [key, entry] : shard.entries)
+            writer->add({.key = key, .seq = entry.seq, .data = shard.arena.bytes(entry.blob)});
+    }
+
+    if (auto const written = writer->commit(); not written.has_value())
+        return std::unexpected{written.error()};
+    return seq;
+}
+
+std::expected<uint32_t, std::string>
+LedgerCache::loadSnapshot(std::filesystem::path const& path, uint32_t minSeq, uint32_t maxSeq)
+{
+    ASSERT(size_ == 0 and latestSeq_ == 0, "Snapshot can only be loaded into an empty cache");
+
+    auto reader = impl::CacheSnapshotReader::open(path);
+    if (not reader.has_value())
+        return std::unexpected{std::move(reader).error()};
+
+    auto const seq = reader->seq();
+    if (seq < minSeq or seq > maxSeq)
+        return std::unexpected{fmt::format("Snapshot is for ledger {}, expected {}-{}", seq, minSeq, maxSeq)};
+
+    // objects are stored in key order so each shard is filled in one go and its entries end up sorted
+    auto object = reader->next();
+    while (object.has_value()) {
+        auto const current = shardIndex(object->key);
+        auto& shard = shards_[current];
+        std::scoped_lock const lck{shard.mtx};
+
+        auto const allocatedBefore = shard.arena.allocatedBytes();
+        auto const liveBefore = shard.arena.liveBytes();
+
+        for (; object.has_value() and shardIndex(object->key) == current; object = reader->next()) {
+            shard.entries.emplace_back(object->key, CacheEntry{object->seq, shard.arena.append(object->data)});
+            shard.lastModifiedSeq = std::max(shard.lastModifiedSeq, object->seq);
+            ++size_;
+        }
+
+        allocatedBytesGauge_.get() +=
+            static_cast<int64_t>(shard.arena.allocatedBytes()) - static_cast<int64_t>(allocatedBefore);
+        liveBytesGauge_.get() += static_cast<int64_t>(shard.arena.liveBytes()) - static_cast<int64_t>(liveBefore);
+    }
+
+    {
+        std::scoped_lock const lck{mtx_};
+        latestSeq_ = seq;
+        cv_.notify_all();
+    }
+    return seq;
+}
+
+void
+LedgerCache::setHistoryWindow(uint32_t window)
+{
+    historyWindow_ = window;
+}
+
+uint32_t
+LedgerCache::historyWindow() const
+{
+    return historyWindow_;
+}
+
+void
+LedgerCache::clear()
+{
+    ASSERT(not full_, "Only a cache that is not full can be cleared");
+
+    std::scoped_lock const deletesLock{deletesMtx_};
+    deletes_.clear();
+
+    for (auto& shard : shards_) {
+        std::scoped_lock const lck{shard.mtx};
+
+        allocatedBytesGauge_.get() -= static_cast<int64_t>(shard.arena.allocatedBytes());
+        liveBytesGauge_.get() -= static_cast<int64_t>(shard.arena.liveBytes());
+        historyBytesGauge_.get() -= static_cast<int64_t>(shard.historyBytes);
+
+        // readers holding views into the old arena keep its slabs alive until they are done
+        shard.entries.clear();
+        shard.history.clear();
+        shard.historyBytes = 0;
+        shard.arena = impl::BlobArena{};
+        shard.lastModifiedSeq = 0;
+    }
+
+    size_ = 0;
+    historyStartSeq_ = 0;
+
+    std::scoped_lock const lck{mtx_};
+    latestSeq_ = 0;
 }
 
 void
@@ -158,7 +465,7 @@ LedgerCache::setFull()
         return;
 
     full_ = true;
-    std::scoped_lock const lck{mtx_};
+    std::scoped_lock const lck{deletesMtx_};
     deletes_.clear();
 }
 
@@ -171,8 +478,7 @@ LedgerCache::isFull() const
 size_t
 LedgerCache::size() const
 {
-    std::shared_lock const lck{mtx_};
-    return map_.size();
+    return size_;
 }
 
 float
@@ -20,7 +20,9 @@
 #pragma once
 
 #include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Gauge.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
@@ -31,22 +33,63 @@
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <filesystem>
 #include <functional>
-#include <map>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace data {
 
 /**
  * @brief Cache for an entire ledger.
+ *
+ * The key space is split into ordered shards by the most significant bits of the key. Each shard keeps its entries
+ * in a flat vector sorted by key and is guarded by its own lock, so readers only ever contend with a writer that
+ * touches the same shard. Object data lives in a per-shard arena that is compacted when a ledger update leaves too
+ * much of it unused.
+ *
+ * Optionally the cache keeps the versions of objects that were replaced or deleted by the last few ledgers. With a
+ * history window of N ledgers, objects can be fetched for any of the N ledgers before the latest one as well.
  */
 class LedgerCache {
     struct CacheEntry {
         uint32_t seq = 0;
-        Blob blob;
+        impl::BlobArena::Ref blob;
+    };
+
+    using Entry = std::pair<ripple::uint256, CacheEntry>;
+
+    // a replaced or deleted object; valid for sequences in [fromSeq, toSeq)
+    struct Version {
+        ripple::uint256 key;
+        uint32_t fromSeq = 0;
+        uint32_t toSeq = 0;
+        impl::BlobArena::Ref blob;
+    };
+
+    static constexpr std::size_t SHARD_BITS = 16;
+    static constexpr std::size_t SHARD_COUNT = std::size_t{1} << SHARD_BITS;
+
+    // number of shards that get their expired history dropped per ledger even if the ledger did not touch them
+    static constexpr std::size_t HISTORY_SWEEP_SHARDS = 1024;
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mtx;
+        std::vector<Entry> entries;  // sorted by key
+        impl::BlobArena arena;
+
+        std::vector<Version> history;  // unordered
+        std::size_t historyBytes = 0;
+
+        // Latest sequence that changed the content of this shard. A shard that was not modified after a given
+        // sequence holds exactly the same data as it had at that sequence.
+        uint32_t lastModifiedSeq = 0;
     };
 
     // counters for fetchLedgerObject(s) hit rate
@@ -71,15 +114,43 @@ class LedgerCache {
         util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "successor_key"}})
     )};
 
-    std::map<ripple::uint256, CacheEntry> map_;
+    // memory used for object data
+    std::reference_wrapper<util::prometheus::GaugeInt> allocatedBytesGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_blob_bytes",
+        util::prometheus::Labels({util::prometheus::Label{"type", "allocated"}}),
+        "Memory held by the LedgerCache for object data"
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> liveBytesGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_blob_bytes",
+        util::prometheus::Labels({util::prometheus::Label{"type", "live"}})
+    )};
+    std::reference_wrapper<util::prometheus::GaugeInt> historyBytesGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_blob_bytes",
+        util::prometheus::Labels({util::prometheus::Label{"type", "history"}})
+    )};
+
+    // number of ledgers before the latest one that can currently be served from history
+    std::reference_wrapper<util::prometheus::GaugeInt> historyDepthGauge_{PrometheusService::gaugeInt(
+        "ledger_cache_history_depth",
+        util::prometheus::Labels{},
+        "Number of ledgers before the latest one the LedgerCache keeps old object versions for"
+    )};
 
-    mutable std::shared_mutex mtx_;
-    std::condition_variable_any cv_;
-    uint32_t latestSeq_ = 0;
+    std::vector<Shard> shards_ = std::vector<Shard>(SHARD_COUNT);
+    std::atomic_size_t size_ = 0;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::atomic_uint32_t latestSeq_ = 0;
     std::atomic_bool full_ = false;
     std::atomic_bool disabled_ = false;
 
+    std::atomic_uint32_t historyWindow_ = 0;
+    uint32_t historyStartSeq_ = 0;  // first ledger applied with history enabled
+    std::size_t sweepCursor_ = 0;
+
     // temporary set to prevent background thread from writing already deleted data. not used when cache is full
+    std::mutex deletesMtx_;
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
 public:
@@ -96,6 +167,9 @@ public:
     /**
      * @brief Fetch a cached object by its key and sequence number.
      *
+     * Note: Sequences older than the sequence the object was last modified at only hit if the history window is
+     * enabled and still covers them.
+     *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
      * @return If found in cache, will return the cached Blob; otherwise nullopt is returned
@@ -103,10 +177,24 @@ public:
     std::optional<Blob>
     get(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Fetch a cached object by its key and sequence number without copying it.
+     *
+     * The returned view shares ownership of the cache memory holding the object, so it stays valid even if the object
+     * is replaced or removed from the cache afterwards.
+     *
+     * @param key The key to fetch for
+     * @param seq The sequence to fetch for
+     * @return If found in cache, will return a view of the cached object; otherwise nullopt is returned
+     */
+    std::optional<BlobView>
+    getView(ripple::uint256 const& key, uint32_t seq) const;
+
     /**
      * @brief Gets a cached successor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false. It also misses if a newer
+     * ledger already modified the part of the cache that holds the answer.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -118,7 +206,8 @@ public:
     /**
      * @brief Gets a cached predcessor.
      *
-     * Note: This function always returns std::nullopt when @ref isFull() returns false.
+     * Note: This function always returns std::nullopt when @ref isFull() returns false. It also misses if a newer
+     * ledger already modified the part of the cache that holds the answer.
      *
      * @param key The key to fetch for
      * @param seq The sequence to fetch for
@@ -127,6 +216,59 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    /**
+     * @brief Set the number of ledgers before the latest one for which replaced and deleted objects are kept.
+     *
+     * Zero disables the history. Should be set before the cache starts receiving new ledgers.
+     *
+     * @param window The number of ledgers
+     */
+    void
+    setHistoryWindow(uint32_t window);
+
+    /**
+     * @return The number of ledgers before the latest one for which replaced and deleted objects are kept
+     */
+    uint32_t
+    historyWindow() const;
+
+    /**
+     * @brief Write the objects of the cache to a snapshot file.
+     *
+     * Ledgers may be applied while the snapshot is being written, so some objects can come from ledgers newer than
+     * the one the snapshot is taken at. Every object is stored with the sequence it was last modified at which keeps
+     * it correct for reads, and applying all ledgers after the snapshot sequence makes the restored cache complete.
+     *
+     * @param path The file to write to
+     * @return The ledger sequence the snapshot was taken at on success; error message otherwise
+     */
+    std::expected<uint32_t, std::string>
+    writeSnapshot(std::filesystem::path const& path) const;
+
+    /**
+     * @brief Fill the empty cache from a snapshot file.
+     *
+     * Nothing is loaded if the snapshot is invalid or was taken at a sequence outside of the given range. The cache
+     * is not marked full; the caller must @ref update it with every ledger after the returned sequence and then call
+     * @ref setFull.
+     *
+     * @param path The file to read from
+     * @param minSeq The oldest acceptable snapshot sequence
+     * @param maxSeq The newest acceptable snapshot sequence
+     * @return The ledger sequence the snapshot was taken at on success; error message otherwise
+     */
+    std::expected<uint32_t, std::string>
+    loadSnapshot(std::filesystem::path const& path, uint32_t minSeq, uint32_t maxSeq);
+
+    /**
+     * @brief Drop all objects and start over with an empty cache.
+     *
+     * Used to discard a partially restored snapshot so that the cache can be loaded from the database instead. Must
+     * not be called once the cache is full.
+     */
+    void
+    clear();
+
     /**
      * @brief Disables the cache.
      */
@@ -186,6 +328,19 @@ public:
      */
     void
     waitUntilCacheContainsSeq(uint32_t seq);
+
+private:
+    static std::size_t
+    shardIndex(ripple::uint256 const& key);
+
+    static void
+    compact(Shard& shard);
+
+    static void
+    pruneHistory(Shard& shard, uint32_t seq, uint32_t window);
+
+    void
+    sweepHistory(uint32_t seq, uint32_t window);
 };
 
 }  // namespace data
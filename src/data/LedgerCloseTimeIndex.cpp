@@ -0,0 +1,217 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCloseTimeIndex.hpp"
+
+#include "data/Types.hpp"
+#include "data/impl/ChecksummedFile.hpp"
+
+#include <fmt/core.h>
+#include <fmt/std.h>
+#include <xrpl/basics/chrono.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace data {
+
+namespace {
+
+/*
+ * The file consists of a header, the close times and a trailer:
+ *   header:  magic (8 bytes), format version (uint32), first ledger sequence (uint32), number of ledgers (uint32)
+ *   body:    close time of each ledger in network clock seconds (uint32)
+ *   trailer: CRC-32 of everything before it (uint32), written by impl::ChecksummedFileWriter
+ *
+ * Numbers are stored in host byte order; the file is meant to be read back on the machine that wrote it.
+ */
+constexpr std::array<char, 8> MAGIC = {'C', 'L', 'I', 'O', 'C', 'L', 'T', 'I'};
+constexpr std::uint32_t FORMAT_VERSION = 1;
+
+constexpr std::size_t HEADER_SIZE = MAGIC.size() + 3 * sizeof(std::uint32_t);
+
+template <typename T>
+T
+read(unsigned char const* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+LedgerCloseTimeIndex::LedgerCloseTimeIndex(std::uint32_t firstSequence, std::vector<std::uint32_t> closeTimes)
+    : firstSequence_{firstSequence}, closeTimes_{std::move(closeTimes)}
+{
+}
+
+bool
+LedgerCloseTimeIndex::add(std::uint32_t seq, ripple::NetClock::time_point closeTime)
+{
+    std::scoped_lock const lock{mtx_};
+
+    if (closeTimes_.empty()) {
+        firstSequence_ = seq;
+    } else {
+        auto const nextSequence = firstSequence_ + static_cast<std::uint32_t>(closeTimes_.size());
+        if (seq < nextSequence)
+            return true;
+        if (seq > nextSequence)
+            return false;
+    }
+
+    closeTimes_.push_back(closeTime.time_since_epoch().count());
+    return true;
+}
+
+bool
+LedgerCloseTimeIndex::prepend(LedgerCloseTimeIndex const& older)
+{
+    std::shared_lock const olderLock{older.mtx_};
+    std::scoped_lock const lock{mtx_};
+
+    if (older.closeTimes_.empty())
+        return true;
+
+    if (closeTimes_.empty()) {
+        firstSequence_ = older.firstSequence_;
+        closeTimes_ = older.closeTimes_;
+        return true;
+    }
+
+    auto const olderEnd = older.firstSequence_ + static_cast<std::uint32_t>(older.closeTimes_.size());
+    if (olderEnd < firstSequence_)
+        return false;
+
+    if (older.firstSequence_ >= firstSequence_)
+        return true;
+
+    auto const count = firstSequence_ - older.firstSequence_;
+    closeTimes_.insert(closeTimes_.begin(), older.closeTimes_.begin(), std::next(older.closeTimes_.begin(), count));
+    firstSequence_ = older.firstSequence_;
+    return true;
+}
+
+std::optional<std::uint32_t>
+LedgerCloseTimeIndex::lastLedgerClosedBy(ripple::NetClock::time_point time) const
+{
+    std::shared_lock const lock{mtx_};
+
+    auto const it = std::ranges::upper_bound(closeTimes_, time.time_since_epoch().count());
+    if (it == closeTimes_.begin())
+        return std::nullopt;
+
+    return firstSequence_ + static_cast<std::uint32_t>(std::distance(closeTimes_.begin(), it) - 1);
+}
+
+std::optional<ripple::NetClock::time_point>
+LedgerCloseTimeIndex::closeTime(std::uint32_t seq) const
+{
+    std::shared_lock const lock{mtx_};
+
+    if (seq < firstSequence_ or seq - firstSequence_ >= closeTimes_.size())
+        return std::nullopt;
+
+    return ripple::NetClock::time_point{ripple::NetClock::duration{closeTimes_[seq - firstSequence_]}};
+}
+
+std::optional<LedgerRange>
+LedgerCloseTimeIndex::range() const
+{
+    std::shared_lock const lock{mtx_};
+
+    if (closeTimes_.empty())
+        return std::nullopt;
+
+    return LedgerRange{
+        .minSequence = firstSequence_,
+        .maxSequence = firstSequence_ + static_cast<std::uint32_t>(closeTimes_.size()) - 1
+    };
+}
+
+std::expected<LedgerRange, std::string>
+LedgerCloseTimeIndex::save(std::filesystem::path const& path) const
+{
+    std::shared_lock const lock{mtx_};
+
+    if (closeTimes_.empty())
+        return std::unexpected{"Index is empty"};
+
+    auto file = impl::ChecksummedFileWriter::open(path);
+    if (not file.has_value())
+        return std::unexpected{std::move(file).error()};
+
+    auto const count = static_cast<std::uint32_t>(closeTimes_.size());
+    file->write(MAGIC.data(), MAGIC.size());
+    file->write(&FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    file->write(&firstSequence_, sizeof(firstSequence_));
+    file->write(&count, sizeof(count));
+    file->write(closeTimes_.data(), closeTimes_.size() * sizeof(std::uint32_t));
+
+    if (auto const committed = file->commit(); not committed.has_value())
+        return std::unexpected{committed.error()};
+
+    return LedgerRange{.minSequence = firstSequence_, .maxSequence = firstSequence_ + count - 1};
+}
+
+std::expected<LedgerRange, std::string>
+LedgerCloseTimeIndex::load(std::filesystem::path const& path)
+{
+    auto const file = impl::ChecksummedFileReader::open(path);
+    if (not file.has_value())
+        return std::unexpected{file.error()};
+
+    auto const content = file->content();
+    auto const* data = content.data();
+    if (content.size() < HEADER_SIZE or std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0)
+        return std::unexpected{fmt::format("{} is not a close time index", path)};
+
+    if (auto const version = read<std::uint32_t>(data + MAGIC.size()); version != FORMAT_VERSION)
+        return std::unexpected{fmt::format("{} has unsupported format version {}", path, version)};
+
+    auto const firstSequence = read<std::uint32_t>(data + MAGIC.size() + sizeof(std::uint32_t));
+    auto const count = read<std::uint32_t>(data + MAGIC.size() + 2 * sizeof(std::uint32_t));
+    if (count == 0 or content.size() != HEADER_SIZE + (count * sizeof(std::uint32_t)))
+        return std::unexpected{fmt::format("{} has a wrong size", path)};
+
+    std::scoped_lock const lock{mtx_};
+    if (not closeTimes_.empty())
+        return std::unexpected{"Index is not empty"};
+
+    firstSequence_ = firstSequence;
+    closeTimes_.resize(count);
+    std::memcpy(closeTimes_.data(), data + HEADER_SIZE, count * sizeof(std::uint32_t));
+
+    return LedgerRange{.minSequence = firstSequence, .maxSequence = firstSequence + count - 1};
+}
+
+}  // namespace data
@@ -0,0 +1,129 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <xrpl/basics/chrono.h>
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace data {
+
+/**
+ * @brief Maps ledger close times to ledger sequences without reading the database.
+ *
+ * The close times of a contiguous run of ledgers are kept in a flat array indexed by sequence. Close times never
+ * decrease from one ledger to the next, so the last ledger closed by a given time is found with a binary search over
+ * that array. Newer ledgers are appended as they are published; older ones are prepended when the index is backfilled.
+ */
+class LedgerCloseTimeIndex {
+    mutable std::shared_mutex mtx_;
+    std::uint32_t firstSequence_ = 0;
+
+    // network clock seconds at which ledger firstSequence_ + i closed
+    std::vector<std::uint32_t> closeTimes_;
+
+public:
+    LedgerCloseTimeIndex() = default;
+
+    /**
+     * @brief Construct an index of the given ledgers.
+     *
+     * @param firstSequence The sequence of the first ledger
+     * @param closeTimes The close times of firstSequence and the ledgers following it, in network clock seconds
+     */
+    LedgerCloseTimeIndex(std::uint32_t firstSequence, std::vector<std::uint32_t> closeTimes);
+
+    /**
+     * @brief Add the close time of the ledger following the last one in the index.
+     *
+     * Ledgers the index already knows about are ignored. A ledger that does not directly follow the last one in the
+     * index is rejected so that the index keeps its existing run of ledgers.
+     *
+     * @param seq The sequence of the ledger
+     * @param closeTime The close time of the ledger
+     * @return true if the ledger is in the index; false if ledgers are missing between the index and the given one
+     */
+    bool
+    add(std::uint32_t seq, ripple::NetClock::time_point closeTime);
+
+    /**
+     * @brief Add the ledgers of another index that are older than the ones in this index.
+     *
+     * @param older The index to take the ledgers from; it must reach the first ledger of this index
+     * @return true if the ledgers were added; false if there would be a gap between the two indexes
+     */
+    bool
+    prepend(LedgerCloseTimeIndex const& older);
+
+    /**
+     * @brief Find the latest ledger that closed no later than the given time.
+     *
+     * @param time The time to look up
+     * @return The sequence of the ledger; nullopt if the index is empty or its first ledger closed after the time
+     */
+    std::optional<std::uint32_t>
+    lastLedgerClosedBy(ripple::NetClock::time_point time) const;
+
+    /**
+     * @brief Get the close time of a ledger.
+     *
+     * @param seq The sequence of the ledger
+     * @return The close time; nullopt if the ledger is not in the index
+     */
+    std::optional<ripple::NetClock::time_point>
+    closeTime(std::uint32_t seq) const;
+
+    /**
+     * @return The range of ledgers in the index; nullopt if the index is empty
+     */
+    std::optional<LedgerRange>
+    range() const;
+
+    /**
+     * @brief Write the index to a file.
+     *
+     * The index is written to a temporary file next to the target first, so an interrupted write never leaves a broken
+     * file behind.
+     *
+     * @param path The file to write to
+     * @return The range of ledgers written on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<LedgerRange, std::string>
+    save(std::filesystem::path const& path) const;
+
+    /**
+     * @brief Fill the empty index from a file written by save().
+     *
+     * @param path The file to read
+     * @return The range of ledgers loaded on success; error message if the file can't be read or is not valid
+     */
+    [[nodiscard]] std::expected<LedgerRange, std::string>
+    load(std::filesystem::path const& path);
+};
+
+}  // namespace data
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace data {
+
+LedgerHeaderCache::LedgerHeaderCache(std::size_t capacity)
+    : shardCapacity_{(capacity + SHARD_COUNT - 1) / SHARD_COUNT}
+{
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::get(std::uint32_t sequence) const
+{
+    ++reqCounter_.get();
+
+    auto header = bySequence_[sequence % SHARD_COUNT].lock()->get(sequence);
+    if (header.has_value())
+        ++hitCounter_.get();
+
+    return header;
+}
+
+std::optional<ripple::LedgerHeader>
+LedgerHeaderCache::get(ripple::uint256 const& hash) const
+{
+    auto const sequence = byHash_[shardOf(hash)].lock()->get(hash);
+    if (not sequence.has_value()) {
+        ++reqCounter_.get();
+        return std::nullopt;
+    }
+
+    // the header may have been evicted or replaced since the hash was cached
+    auto header = get(*sequence);
+    if (header.has_value() and header->hash != hash)
+        return std::nullopt;
+
+    return header;
+}
+
+void
+LedgerHeaderCache::put(ripple::LedgerHeader const& header)
+{
+    if (shardCapacity_ == 0)
+        return;
+
+    bySequence_[header.seq % SHARD_COUNT].lock()->put(header.seq, header, shardCapacity_);
+    byHash_[shardOf(header.hash)].lock()->put(header.hash, header.seq, shardCapacity_);
+}
+
+std::size_t
+LedgerHeaderCache::shardOf(ripple::uint256 const& hash)
+{
+    // ledger hashes are uniformly distributed so any of their bytes picks a shard evenly
+    return *hash.begin() % SHARD_COUNT;
+}
+
+std::size_t
+LedgerHeaderCache::size() const
+{
+    std::size_t size = 0;
+    for (auto const& shard : bySequence_)
+        size += shard.lock()->size();
+
+    return size;
+}
+
+}  // namespace data
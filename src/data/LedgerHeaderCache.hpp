@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Mutex.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/basics/hardened_hash.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace data {
+
+/**
+ * @brief Bounded cache of ledger headers, looked up by sequence or by hash.
+ *
+ * Ledger headers never change once written, so they only leave the cache when they are evicted by the least recently
+ * used policy. The cache is split into shards which are locked separately, so concurrent lookups of different ledgers
+ * rarely contend. A lookup by hash resolves the hash to a sequence first and then looks up the header by sequence.
+ */
+class LedgerHeaderCache {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+private:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    template <typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
+    class Lru {
+        std::list<std::pair<KeyType, ValueType>> entries_;  // most recently used first
+        std::unordered_map<KeyType, typename decltype(entries_)::iterator, HashType> positions_;
+
+    public:
+        std::optional<ValueType>
+        get(KeyType const& key)
+        {
+            auto const it = positions_.find(key);
+            if (it == positions_.end())
+                return std::nullopt;
+
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return it->second->second;
+        }
+
+        void
+        put(KeyType const& key, ValueType const& value, std::size_t capacity)
+        {
+            if (auto const it = positions_.find(key); it != positions_.end()) {
+                it->second->second = value;
+                entries_.splice(entries_.begin(), entries_, it->second);
+                return;
+            }
+
+            if (entries_.size() >= capacity) {
+                positions_.erase(entries_.back().first);
+                entries_.pop_back();
+            }
+
+            entries_.emplace_front(key, value);
+            positions_.emplace(key, entries_.begin());
+        }
+
+        std::size_t
+        size() const
+        {
+            return entries_.size();
+        }
+    };
+
+    std::size_t shardCapacity_;
+
+    // lookups move the entry to the front of its shard
+    mutable std::array<util::Mutex<Lru<std::uint32_t, ripple::LedgerHeader>>, SHARD_COUNT> bySequence_;
+    mutable std::array<util::Mutex<Lru<ripple::uint256, std::uint32_t, ripple::hardened_hash<>>>, SHARD_COUNT> byHash_;
+
+    std::reference_wrapper<util::prometheus::CounterInt> reqCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "request"}, {"fetch", "ledger_headers"}}),
+        "LedgerCache statistics"
+    )};
+    std::reference_wrapper<util::prometheus::CounterInt> hitCounter_{PrometheusService::counterInt(
+        "ledger_cache_counter_total_number",
+        util::prometheus::Labels({{"type", "cache_hit"}, {"fetch", "ledger_headers"}})
+    )};
+
+public:
+    /**
+     * @brief Construct a new cache.
+     *
+     * @param capacity The maximum number of headers to keep; 0 disables the cache
+     */
+    explicit LedgerHeaderCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * @brief Get the header of a ledger by sequence.
+     *
+     * @param sequence The sequence of the ledger
+     * @return The header if it is cached; nullopt otherwise
+     */
+    std::optional<ripple::LedgerHeader>
+    get(std::uint32_t sequence) const;
+
+    /**
+     * @brief Get the header of a ledger by hash.
+     *
+     * @param hash The hash of the ledger
+     * @return The header if it is cached; nullopt otherwise
+     */
+    std::optional<ripple::LedgerHeader>
+    get(ripple::uint256 const& hash) const;
+
+    /**
+     * @brief Put a ledger header into the cache.
+     *
+     * @param header The header to cache
+     */
+    void
+    put(ripple::LedgerHeader const& header);
+
+    /**
+     * @return The number of cached headers
+     */
+    std::size_t
+    size() const;
+
+private:
+    static std::size_t
+    shardOf(ripple::uint256 const& hash);
+};
+
+}  // namespace data
@@ -23,8 +23,11 @@
 #include <xrpl/protocol/AccountID.h>
 
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -35,6 +38,91 @@ namespace data {
 
 using Blob = std::vector<unsigned char>;
 
+/**
+ * @brief A read-only view of serialized object data that keeps the underlying storage alive.
+ *
+ * The view shares ownership of the memory it points to, so it remains valid after the cache that produced it has
+ * moved on to newer ledgers or compacted its storage.
+ */
+class BlobView {
+    std::shared_ptr<unsigned char const> data_;
+    std::size_t size_ = 0;
+
+public:
+    BlobView() = default;
+
+    /**
+     * @brief Construct a view into memory kept alive by the given pointer.
+     *
+     * @param data Pointer to the first byte; its control block keeps the storage alive
+     * @param size The number of bytes in the view
+     */
+    BlobView(std::shared_ptr<unsigned char const> data, std::size_t size) : data_{std::move(data)}, size_{size}
+    {
+    }
+
+    /**
+     * @brief Construct a view that owns the given blob.
+     *
+     * @param blob The blob to take ownership of
+     */
+    explicit BlobView(Blob blob)
+    {
+        auto owner = std::make_shared<Blob const>(std::move(blob));
+        size_ = owner->size();
+        data_ = std::shared_ptr<unsigned char const>{owner, owner->data()};
+    }
+
+    /** @return Pointer to the first byte */
+    [[nodiscard]] unsigned char const*
+    data() const
+    {
+        return data_.get();
+    }
+
+    /** @return The number of bytes in the view */
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** @return true if the view has no data; false otherwise */
+    [[nodiscard]] bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    /** @return Iterator to the first byte */
+    [[nodiscard]] unsigned char const*
+    begin() const
+    {
+        return data();
+    }
+
+    /** @return Iterator past the last byte */
+    [[nodiscard]] unsigned char const*
+    end() const
+    {
+        return data() + size_;
+    }
+
+    /** @return The bytes as a span */
+    [[nodiscard]] std::span<unsigned char const>
+    span() const
+    {
+        return {data(), size_};
+    }
+
+    /** @return A copy of the bytes as a Blob */
+    [[nodiscard]] Blob
+    toBlob() const
+    {
+        return {begin(), end()};
+    }
+};
+
 /**
  * @brief Represents an object in the ledger.
  */
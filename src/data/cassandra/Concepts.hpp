@@ -25,9 +25,11 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
+#include <xrpl/basics/base_uint.h>
 
 #include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -57,11 +59,14 @@ concept SomeExecutionStrategy = requires(
     Handle handle,
     Statement statement,
     std::vector<Statement> statements,
+    std::vector<ripple::uint256> keys,
     PreparedStatement prepared,
     boost::asio::yield_context token
 ) {
     { T(settings, handle) };
     { a.sync() } -> std::same_as<void>;
+    { a.sync(std::uint64_t{}) } -> std::same_as<void>;
+    { a.startWriteGroup() } -> std::same_as<std::uint64_t>;
     { a.isTooBusy() } -> std::same_as<bool>;
     { a.writeSync(statement) } -> std::same_as<ResultOrError>;
     { a.writeSync(prepared) } -> std::same_as<ResultOrError>;
@@ -71,6 +76,7 @@ concept SomeExecutionStrategy = requires(
     { a.read(token, statement) } -> std::same_as<ResultOrError>;
     { a.read(token, statements) } -> std::same_as<ResultOrError>;
     { a.readEach(token, statements) } -> std::same_as<std::vector<Result>>;
+    { a.readBatched(token, prepared, keys, std::size_t{}) } -> std::same_as<std::vector<Result>>;
     { a.stats() } -> std::same_as<boost::json::object>;
 };
 
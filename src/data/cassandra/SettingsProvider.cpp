@@ -124,6 +124,7 @@ SettingsProvider::parseSettings() const
         config_.valueOr<uint32_t>("core_connections_per_host", settings.coreConnectionsPerHost);
     settings.queueSizeIO = config_.maybeValue<uint32_t>("queue_size_io");
     settings.writeBatchSize = config_.valueOr<std::size_t>("write_batch_size", settings.writeBatchSize);
+    settings.readBatchSize = config_.valueOr<std::size_t>("read_batch_size", settings.readBatchSize);
 
     auto const connectTimeoutSecond = config_.maybeValue<uint32_t>("connect_timeout");
     if (connectTimeoutSecond)
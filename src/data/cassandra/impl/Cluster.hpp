@@ -86,6 +86,15 @@ struct Settings {
     /** @brief Size of batches when writing */
     std::size_t writeBatchSize = DEFAULT_BATCH_SIZE;
 
+    /**
+     * @brief Number of keys read by one `IN` query; 0 reads every key with its own query
+     *
+     * The coordinator of an `IN` query fans out to the replicas of every key and waits for all of them, so batching
+     * saves round trips but not database work. Batches of 10 to 50 keys pay off; above about 100 keys the slowest
+     * replica and the coordinator memory dominate.
+     */
+    std::size_t readBatchSize = 0;
+
     /** @brief Size of the IO queue */
     std::optional<uint32_t> queueSizeIO = std::nullopt;  // NOLINT(readability-redundant-member-init)
 
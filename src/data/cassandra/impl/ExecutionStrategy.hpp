@@ -30,6 +30,7 @@
 
 #include <boost/asio.hpp>
 #include <boost/asio/associated_executor.hpp>
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/spawn.hpp>
@@ -41,6 +42,8 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -76,6 +79,8 @@ class DefaultExecutionStrategy {
 
     std::mutex syncMutex_;
     std::condition_variable syncCv_;
+    std::uint64_t currentWriteGroup_ = 0;                                // guarded by syncMutex_
+    std::map<std::uint64_t, std::uint32_t> outstandingWritesPerGroup_;  // guarded by syncMutex_
 
     boost::asio::io_context ioc_;
     std::optional<boost::asio::io_service::work> work_;
@@ -134,6 +139,36 @@ public:
         LOG(log_.debug()) << "Sync done.";
     }
 
+    /**
+     * @brief Wait for the async writes of a write group and of all groups started before it to finish.
+     *
+     * Writes of later groups may still be in flight when this returns.
+     *
+     * @param group The write group to wait for, as returned by @ref startWriteGroup
+     */
+    void
+    sync(std::uint64_t group)
+    {
+        LOG(log_.debug()) << "Waiting to sync writes of group " << group << "...";
+        std::unique_lock<std::mutex> lck(syncMutex_);
+        syncCv_.wait(lck, [this, group]() {
+            return outstandingWritesPerGroup_.empty() or outstandingWritesPerGroup_.begin()->first > group;
+        });
+        LOG(log_.debug()) << "Sync of group " << group << " done.";
+    }
+
+    /**
+     * @brief Start a new write group; async writes issued from now on belong to it.
+     *
+     * @return The new write group
+     */
+    std::uint64_t
+    startWriteGroup()
+    {
+        std::scoped_lock const lck(syncMutex_);
+        return ++currentWriteGroup_;
+    }
+
     /**
      * @return true if outstanding read requests allowance is exhausted; false otherwise
      */
@@ -196,7 +231,7 @@ public:
         auto const startTime = std::chrono::steady_clock::now();
 
         auto statement = preparedStatement.bind(std::forward<Args>(args)...);
-        incrementOutstandingRequestCount();
+        auto const group = incrementOutstandingRequestCount();
 
         counters_->registerWriteStarted();
         // Note: lifetime is controlled by std::shared_from_this internally
@@ -204,8 +239,8 @@ public:
             ioc_,
             handle_,
             std::move(statement),
-            [this, startTime](auto const&) {
-                decrementOutstandingRequestCount();
+            [this, startTime, group](auto const&) {
+                decrementOutstandingRequestCount(group);
 
                 counters_->registerWriteFinished(startTime);
             },
@@ -234,7 +269,7 @@ public:
             chunk.reserve(std::distance(begin, end));
             std::move(begin, end, std::back_inserter(chunk));
 
-            incrementOutstandingRequestCount();
+            auto const group = incrementOutstandingRequestCount();
             counters_->registerWriteStarted();
 
             // Note: lifetime is controlled by std::shared_from_this internally
@@ -242,8 +277,8 @@ public:
                 ioc_,
                 handle_,
                 std::move(chunk),
-                [this, startTime](auto const&) {
-                    decrementOutstandingRequestCount();
+                [this, startTime, group](auto const&) {
+                    decrementOutstandingRequestCount(group);
                     counters_->registerWriteFinished(startTime);
                 },
                 [this]() { counters_->registerWriteRetry(); }
@@ -276,7 +311,7 @@ public:
      *
      * @param token Completion token (yield_context)
      * @param statements Statements to execute in a batch
-     * @throw DatabaseTimeout on timeout
+     * @throw DatabaseTimeout on timeout or once the coroutine was cancelled
      * @return ResultType or error wrapped in Expected
      */
     [[maybe_unused]] ResultOrErrorType
@@ -290,6 +325,7 @@ public:
 
         // todo: perhaps use policy instead
         while (true) {
+            throwIfCancelled(token);
             numReadRequestsOutstanding_ += numStatements;
 
             auto init = [this, &statements, &future]<typename Self>(Self& self) {
@@ -331,7 +367,7 @@ public:
      *
      * @param token Completion token (yield_context)
      * @param statement Statement to execute
-     * @throw DatabaseTimeout on timeout
+     * @throw DatabaseTimeout on timeout or once the coroutine was cancelled
      * @return ResultType or error wrapped in Expected
      */
     [[maybe_unused]] ResultOrErrorType
@@ -344,6 +380,7 @@ public:
 
         // todo: perhaps use policy instead
         while (true) {
+            throwIfCancelled(token);
             ++numReadRequestsOutstanding_;
             auto init = [this, &statement, &future]<typename Self>(Self& self) {
                 auto sself = std::make_shared<Self>(std::move(self));
@@ -385,12 +422,13 @@ public:
      *
      * @param token Completion token (yield_context)
      * @param statements Statements to execute
-     * @throw DatabaseTimeout on db error
+     * @throw DatabaseTimeout on db error or once the coroutine was cancelled
      * @return Vector of results
      */
     std::vector<ResultType>
     readEach(CompletionTokenType token, std::vector<StatementType> const& statements)
     {
+        throwIfCancelled(token);
         auto const startTime = std::chrono::steady_clock::now();
 
         std::atomic_uint64_t errorsCount = 0u;
@@ -468,6 +506,42 @@ public:
         return results;
     }
 
+    /**
+     * @brief Coroutine-based query execution used for reading many keys with few queries.
+     *
+     * The keys are split into batches of batchSize keys. Each batch is bound as a list to the first parameter of the
+     * prepared statement, which is expected to select by `IN ?`, and all batches are read concurrently like in
+     * readEach. Rows in the results are in no particular order and keys that were not found have no row.
+     *
+     * @param token Completion token (yield_context)
+     * @param preparedStatement Statement to bind each batch of keys to
+     * @param keys Keys to fetch
+     * @param batchSize Maximum number of keys per query
+     * @param args Args to bind to the prepared statement after the keys
+     * @throw DatabaseTimeout on db error
+     * @return Vector of results; one per batch
+     */
+    template <typename KeyType, typename... Args>
+    std::vector<ResultType>
+    readBatched(
+        CompletionTokenType token,
+        PreparedStatementType const& preparedStatement,
+        std::vector<KeyType> const& keys,
+        std::size_t batchSize,
+        Args const&... args
+    )
+    {
+        std::vector<StatementType> statements;
+        statements.reserve((keys.size() + batchSize - 1) / batchSize);
+
+        util::forEachBatch(keys, batchSize, [&](auto begin, auto end) {
+            counters_->registerReadBatched(static_cast<std::uint64_t>(std::distance(begin, end)));
+            statements.push_back(preparedStatement.bind(std::vector<KeyType>(begin, end), args...));
+        });
+
+        return readEach(token, statements);
+    }
+
     /**
      * @brief Get statistics about the backend.
      */
@@ -478,7 +552,15 @@ public:
     }
 
 private:
-    void
+    static void
+    throwIfCancelled(CompletionTokenType const& token)
+    {
+        // the coroutine of a request is cancelled once its deadline passed; nobody is waiting for the result anymore
+        if (token.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none)
+            throw DatabaseTimeout{};
+    }
+
+    std::uint64_t
     incrementOutstandingRequestCount()
     {
         {
@@ -490,25 +572,32 @@ private:
             }
         }
         ++numWriteRequestsOutstanding_;
+
+        std::scoped_lock const lck(syncMutex_);
+        ++outstandingWritesPerGroup_[currentWriteGroup_];
+        return currentWriteGroup_;
     }
 
     void
-    decrementOutstandingRequestCount()
+    decrementOutstandingRequestCount(std::uint64_t group)
     {
         // sanity check
         ASSERT(numWriteRequestsOutstanding_ > 0, "Decrementing num outstanding below 0");
-        size_t const cur = (--numWriteRequestsOutstanding_);
+        --numWriteRequestsOutstanding_;
         {
             // mutex lock required to prevent race condition around spurious
             // wakeup
             std::lock_guard const lck(throttleMutex_);
             throttleCv_.notify_one();
         }
-        if (cur == 0) {
-            // mutex lock required to prevent race condition around spurious
-            // wakeup
-            std::lock_guard const lck(syncMutex_);
-            syncCv_.notify_one();
+
+        std::lock_guard const lck(syncMutex_);
+        auto const it = outstandingWritesPerGroup_.find(group);
+        ASSERT(it != outstandingWritesPerGroup_.end(), "Write group {} has no outstanding writes", group);
+        if (--it->second == 0) {
+            // both kinds of sync may be waiting
+            outstandingWritesPerGroup_.erase(it);
+            syncCv_.notify_all();
         }
     }
 
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/BlobArena.hpp"
+
+#include "data/Types.hpp"
+#include "util/Assert.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace data::impl {
+
+void
+BlobArena::reserve(std::size_t bytes)
+{
+    if (not fits(bytes))
+        addSlab(bytes);
+}
+
+BlobArena::Ref
+BlobArena::append(std::span<unsigned char const> bytes)
+{
+    if (bytes.empty())
+        return {};
+
+    // grow by a fraction of what is already allocated so that small arenas stay small while big ones end up with a
+    // few large slabs
+    if (not fits(bytes.size()))
+        addSlab(std::max(bytes.size(), std::clamp(allocatedBytes_ / 4, MIN_SLAB_SIZE, MAX_SLAB_SIZE)));
+
+    auto& slab = *slabs_.back();
+    auto const ref = Ref{
+        .slab = static_cast<uint32_t>(slabs_.size() - 1),
+        .offset = static_cast<uint32_t>(slab.used),
+        .size = static_cast<uint32_t>(bytes.size())
+    };
+
+    std::ranges::copy(bytes, slab.data.get() + slab.used);
+    slab.used += bytes.size();
+    liveBytes_ += bytes.size();
+
+    return ref;
+}
+
+void
+BlobArena::release(Ref ref)
+{
+    ASSERT(liveBytes_ >= ref.size, "Released more bytes than stored. live = {}, size = {}", liveBytes_, ref.size);
+    liveBytes_ -= ref.size;
+}
+
+std::span<unsigned char const>
+BlobArena::bytes(Ref ref) const
+{
+    if (ref.size == 0)
+        return {};
+
+    ASSERT(ref.slab < slabs_.size(), "Slab {} does not exist", ref.slab);
+    return {slabs_[ref.slab]->data.get() + ref.offset, ref.size};
+}
+
+BlobView
+BlobArena::view(Ref ref) const
+{
+    if (ref.size == 0)
+        return {};
+
+    ASSERT(ref.slab < slabs_.size(), "Slab {} does not exist", ref.slab);
+    auto const& slab = slabs_[ref.slab];
+    return {std::shared_ptr<unsigned char const>{slab, slab->data.get() + ref.offset}, ref.size};
+}
+
+std::size_t
+BlobArena::allocatedBytes() const
+{
+    return allocatedBytes_;
+}
+
+std::size_t
+BlobArena::liveBytes() const
+{
+    return liveBytes_;
+}
+
+bool
+BlobArena::fits(std::size_t bytes) const
+{
+    return not slabs_.empty() and slabs_.back()->capacity - slabs_.back()->used >= bytes;
+}
+
+void
+BlobArena::addSlab(std::size_t capacity)
+{
+    auto slab = Slab{.data = std::make_unique_for_overwrite<unsigned char[]>(capacity), .capacity = capacity};
+    slabs_.push_back(std::make_shared<Slab>(std::move(slab)));
+    allocatedBytes_ += capacity;
+}
+
+bool
+BlobArena::shouldCompact() const
+{
+    return allocatedBytes_ > 2 * MIN_SLAB_SIZE and liveBytes_ < allocatedBytes_ / 2;
+}
+
+}  // namespace data::impl
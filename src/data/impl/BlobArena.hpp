@@ -0,0 +1,136 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/Types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace data::impl {
+
+/**
+ * @brief Append-only storage for object blobs.
+ *
+ * Bytes are copied into large slabs instead of being allocated one by one. Replaced or deleted blobs are only
+ * accounted as dead until the owner decides to compact by moving the live blobs into a fresh arena. Slabs are
+ * reference counted so views handed out to readers stay valid after compaction.
+ *
+ * The arena is not synchronized; the owner is responsible for locking.
+ */
+class BlobArena {
+public:
+    static constexpr std::size_t MIN_SLAB_SIZE = 512;
+    static constexpr std::size_t MAX_SLAB_SIZE = 64 * 1024;
+
+    /**
+     * @brief Location of a blob inside the arena.
+     */
+    struct Ref {
+        uint32_t slab = 0;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+private:
+    struct Slab {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t capacity = 0;
+        std::size_t used = 0;
+    };
+
+    std::vector<std::shared_ptr<Slab>> slabs_;
+    std::size_t allocatedBytes_ = 0;
+    std::size_t liveBytes_ = 0;
+
+public:
+    /**
+     * @brief Make sure the next appends totalling up to the given number of bytes go to a single slab.
+     *
+     * @param bytes The number of bytes to reserve
+     */
+    void
+    reserve(std::size_t bytes);
+
+    /**
+     * @brief Copy bytes into the arena.
+     *
+     * @param bytes The bytes to store
+     * @return The location of the stored copy
+     */
+    Ref
+    append(std::span<unsigned char const> bytes);
+
+    /**
+     * @brief Mark a previously appended blob as no longer used.
+     *
+     * @param ref The location of the blob
+     */
+    void
+    release(Ref ref);
+
+    /**
+     * @brief Get the bytes of a blob.
+     *
+     * The span is valid as long as the arena is not compacted or destroyed.
+     *
+     * @param ref The location of the blob
+     * @return The stored bytes
+     */
+    [[nodiscard]] std::span<unsigned char const>
+    bytes(Ref ref) const;
+
+    /**
+     * @brief Get a view of a blob which keeps its slab alive.
+     *
+     * @param ref The location of the blob
+     * @return A view of the stored bytes
+     */
+    [[nodiscard]] BlobView
+    view(Ref ref) const;
+
+    /** @return The number of bytes held by all slabs */
+    [[nodiscard]] std::size_t
+    allocatedBytes() const;
+
+    /** @return The number of bytes used by blobs that were not released */
+    [[nodiscard]] std::size_t
+    liveBytes() const;
+
+    /**
+     * @brief Check whether enough space is wasted on released blobs to make compaction worth it.
+     *
+     * @return true if more than half of the allocated memory is not used by live blobs; false otherwise
+     */
+    [[nodiscard]] bool
+    shouldCompact() const;
+
+private:
+    [[nodiscard]] bool
+    fits(std::size_t bytes) const;
+
+    void
+    addSlab(std::size_t capacity);
+};
+
+}  // namespace data::impl
@@ -0,0 +1,197 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/CacheSnapshot.hpp"
+
+#include "data/impl/ChecksummedFile.hpp"
+
+#include <fmt/core.h>
+#include <fmt/std.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+constexpr std::array<char, 8> MAGIC = {'C', 'L', 'I', 'O', 'C', 'A', 'C', 'H'};
+constexpr uint32_t FORMAT_VERSION = 1;
+
+constexpr std::size_t HEADER_SIZE = MAGIC.size() + sizeof(uint32_t) + sizeof(uint32_t);
+constexpr std::size_t OBJECT_HEADER_SIZE = ripple::uint256::bytes + sizeof(uint32_t) + sizeof(uint32_t);
+
+// the checksum at the very end is handled by ChecksummedFile; this is the object count before it
+constexpr std::size_t TRAILER_SIZE = sizeof(uint64_t);
+
+template <typename T>
+T
+load(unsigned char const* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+CacheSnapshotWriter::CacheSnapshotWriter(ChecksummedFileWriter file) : file_{std::move(file)}
+{
+}
+
+std::expected<CacheSnapshotWriter, std::string>
+CacheSnapshotWriter::open(std::filesystem::path path, uint32_t seq)
+{
+    auto file = ChecksummedFileWriter::open(std::move(path));
+    if (not file.has_value())
+        return std::unexpected{std::move(file).error()};
+
+    CacheSnapshotWriter writer{std::move(file).value()};
+    writer.file_.write(MAGIC.data(), MAGIC.size());
+    writer.file_.write(&FORMAT_VERSION, sizeof(FORMAT_VERSION));
+    writer.file_.write(&seq, sizeof(seq));
+    return writer;
+}
+
+void
+CacheSnapshotWriter::add(CacheSnapshotObject const& object)
+{
+    auto const size = static_cast<uint32_t>(object.data.size());
+
+    file_.write(object.key.data(), ripple::uint256::bytes);
+    file_.write(&object.seq, sizeof(object.seq));
+    file_.write(&size, sizeof(size));
+    file_.write(object.data.data(), object.data.size());
+    ++count_;
+}
+
+std::expected<uint64_t, std::string>
+CacheSnapshotWriter::commit()
+{
+    file_.write(&count_, sizeof(count_));
+
+    if (auto const committed = file_.commit(); not committed.has_value())
+        return std::unexpected{committed.error()};
+
+    return count_;
+}
+
+CacheSnapshotReader::CacheSnapshotReader(ChecksummedFileReader file) : file_{std::move(file)}
+{
+}
+
+std::expected<CacheSnapshotReader, std::string>
+CacheSnapshotReader::open(std::filesystem::path const& path)
+{
+    auto file = ChecksummedFileReader::open(path);
+    if (not file.has_value())
+        return std::unexpected{std::move(file).error()};
+
+    CacheSnapshotReader reader{std::move(file).value()};
+    if (auto const error = reader.validate(); error.has_value())
+        return std::unexpected{fmt::format("{} is not a valid cache snapshot: {}", path, *error)};
+
+    return reader;
+}
+
+uint32_t
+CacheSnapshotReader::seq() const
+{
+    return seq_;
+}
+
+uint64_t
+CacheSnapshotReader::size() const
+{
+    return count_;
+}
+
+std::optional<CacheSnapshotObject>
+CacheSnapshotReader::next()
+{
+    auto const content = file_.content();
+    if (offset_ == content.size() - TRAILER_SIZE)
+        return std::nullopt;
+
+    auto const* object = content.data() + offset_;
+    auto const size = load<uint32_t>(object + ripple::uint256::bytes + sizeof(uint32_t));
+    offset_ += OBJECT_HEADER_SIZE + size;
+
+    return CacheSnapshotObject{
+        .key = ripple::uint256::fromVoid(object),
+        .seq = load<uint32_t>(object + ripple::uint256::bytes),
+        .data = {object + OBJECT_HEADER_SIZE, size}
+    };
+}
+
+std::optional<std::string>
+CacheSnapshotReader::validate()
+{
+    auto const content = file_.content();
+    auto const* data = content.data();
+
+    if (content.size() < HEADER_SIZE + TRAILER_SIZE)
+        return "too small";
+
+    if (std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0)
+        return "wrong magic";
+
+    if (auto const version = load<uint32_t>(data + MAGIC.size()); version != FORMAT_VERSION)
+        return fmt::format("unsupported format version {}", version);
+
+    seq_ = load<uint32_t>(data + MAGIC.size() + sizeof(uint32_t));
+    count_ = load<uint64_t>(data + content.size() - TRAILER_SIZE);
+
+    // the checksum guards against corruption; walking the objects guards against a writer bug producing a file we
+    // would read out of bounds
+    auto const end = content.size() - TRAILER_SIZE;
+    uint64_t found = 0;
+    std::optional<ripple::uint256> previous;
+    for (offset_ = HEADER_SIZE; offset_ < end; ++found) {
+        if (end - offset_ < OBJECT_HEADER_SIZE)
+            return "truncated object";
+
+        auto const key = ripple::uint256::fromVoid(data + offset_);
+        if (previous.has_value() and not(*previous < key))
+            return "objects are not ordered by key";
+        previous = key;
+
+        auto const size = load<uint32_t>(data + offset_ + ripple::uint256::bytes + sizeof(uint32_t));
+        if (end - offset_ - OBJECT_HEADER_SIZE < size)
+            return "truncated object";
+
+        offset_ += OBJECT_HEADER_SIZE + size;
+    }
+
+    if (found != count_)
+        return fmt::format("expected {} objects but found {}", count_, found);
+
+    offset_ = HEADER_SIZE;
+    return std::nullopt;
+}
+
+}  // namespace data::impl
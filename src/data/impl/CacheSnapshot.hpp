@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/impl/ChecksummedFile.hpp"
+
+#include <xrpl/basics/base_uint.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace data::impl {
+
+/*
+ * A snapshot file consists of a header, the cached objects in key order and a trailer:
+ *   header:  magic (8 bytes), format version (uint32), ledger sequence (uint32)
+ *   object:  key (32 bytes), sequence the object was last modified at (uint32), size (uint32), data (size bytes)
+ *   trailer: number of objects (uint64), CRC-32 of everything before the CRC (uint32)
+ *
+ * Numbers are stored in host byte order; a snapshot is meant to be read back on the machine that wrote it.
+ */
+
+/**
+ * @brief A cached object as stored in a snapshot.
+ */
+struct CacheSnapshotObject {
+    ripple::uint256 key;
+    uint32_t seq = 0;
+    std::span<unsigned char const> data;
+};
+
+/**
+ * @brief Writes a LedgerCache snapshot.
+ *
+ * The target file is replaced only once the snapshot is committed, see ChecksummedFileWriter.
+ */
+class CacheSnapshotWriter {
+    ChecksummedFileWriter file_;
+    uint64_t count_ = 0;
+
+public:
+    /**
+     * @brief Start writing a snapshot.
+     *
+     * @param path The file to write the snapshot to
+     * @param seq The ledger sequence the snapshot is taken at
+     * @return The writer on success; error message otherwise
+     */
+    [[nodiscard]] static std::expected<CacheSnapshotWriter, std::string>
+    open(std::filesystem::path path, uint32_t seq);
+
+    /**
+     * @brief Append an object. Objects must be added in key order.
+     *
+     * @param object The object to add
+     */
+    void
+    add(CacheSnapshotObject const& object);
+
+    /**
+     * @brief Finish the snapshot and move it in place of the target file.
+     *
+     * @return The number of objects written on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<uint64_t, std::string>
+    commit();
+
+private:
+    explicit CacheSnapshotWriter(ChecksummedFileWriter file);
+};
+
+/**
+ * @brief Reads a LedgerCache snapshot through a read-only memory mapping of the file.
+ *
+ * The whole file is validated when it is opened, so reading the objects afterwards can not fail.
+ */
+class CacheSnapshotReader {
+    ChecksummedFileReader file_;
+
+    uint32_t seq_ = 0;
+    uint64_t count_ = 0;
+    std::size_t offset_ = 0;
+
+public:
+    /**
+     * @brief Open and validate a snapshot.
+     *
+     * @param path The snapshot file
+     * @return The reader on success; error message if the file can't be read or is not a valid snapshot
+     */
+    [[nodiscard]] static std::expected<CacheSnapshotReader, std::string>
+    open(std::filesystem::path const& path);
+
+    /** @return The ledger sequence the snapshot was taken at */
+    [[nodiscard]] uint32_t
+    seq() const;
+
+    /** @return The number of objects in the snapshot */
+    [[nodiscard]] uint64_t
+    size() const;
+
+    /**
+     * @brief Read the next object.
+     *
+     * The data of the object points into the mapped file and is valid as long as the reader is alive.
+     *
+     * @return The next object in key order or nullopt if all objects were read
+     */
+    [[nodiscard]] std::optional<CacheSnapshotObject>
+    next();
+
+private:
+    explicit CacheSnapshotReader(ChecksummedFileReader file);
+
+    [[nodiscard]] std::optional<std::string>
+    validate();
+};
+
+}  // namespace data::impl
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/ChecksummedFile.hpp"
+
+#include <boost/crc.hpp>
+#include <fcntl.h>
+#include <fmt/core.h>
+#include <fmt/std.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <filesystem>
+#include <ios>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace data::impl {
+
+namespace {
+
+constexpr std::size_t CHECKSUM_SIZE = sizeof(uint32_t);
+
+}  // namespace
+
+ChecksummedFileWriter::ChecksummedFileWriter(std::filesystem::path path)
+    : path_{std::move(path)}, tmpPath_{path_.string() + ".tmp"}
+{
+}
+
+std::expected<ChecksummedFileWriter, std::string>
+ChecksummedFileWriter::open(std::filesystem::path path)
+{
+    ChecksummedFileWriter writer{std::move(path)};
+
+    writer.out_.open(writer.tmpPath_, std::ios::binary | std::ios::trunc);
+    if (not writer.out_)
+        return std::unexpected{fmt::format("Can't open {}: {}", writer.tmpPath_, std::strerror(errno))};
+
+    return writer;
+}
+
+ChecksummedFileWriter::ChecksummedFileWriter(ChecksummedFileWriter&& other)
+    : path_{std::move(other.path_)}
+    , tmpPath_{std::move(other.tmpPath_)}
+    , out_{std::move(other.out_)}
+    , crc_{other.crc_}
+    , committed_{std::exchange(other.committed_, true)}
+{
+}
+
+ChecksummedFileWriter::~ChecksummedFileWriter()
+{
+    if (committed_)
+        return;
+
+    out_.close();
+    std::error_code ec;
+    std::filesystem::remove(tmpPath_, ec);
+}
+
+void
+ChecksummedFileWriter::write(void const* data, std::size_t size)
+{
+    out_.write(static_cast<char const*>(data), static_cast<std::streamsize>(size));
+    crc_.process_bytes(data, size);
+}
+
+std::expected<void, std::string>
+ChecksummedFileWriter::commit()
+{
+    auto const checksum = static_cast<uint32_t>(crc_.checksum());
+    out_.write(reinterpret_cast<char const*>(&checksum), sizeof(checksum));
+    out_.close();
+    if (not out_)
+        return std::unexpected{fmt::format("Can't write {}: {}", tmpPath_, std::strerror(errno))};
+
+    std::error_code ec;
+    std::filesystem::rename(tmpPath_, path_, ec);
+    if (ec)
+        return std::unexpected{fmt::format("Can't move {} to {}: {}", tmpPath_, path_, ec.message())};
+
+    committed_ = true;
+    return {};
+}
+
+std::expected<ChecksummedFileReader, std::string>
+ChecksummedFileReader::open(std::filesystem::path const& path)
+{
+    ChecksummedFileReader reader;
+
+    reader.fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (reader.fd_ < 0)
+        return std::unexpected{fmt::format("Can't open {}: {}", path, std::strerror(errno))};
+
+    struct stat st {};
+    if (::fstat(reader.fd_, &st) != 0)
+        return std::unexpected{fmt::format("Can't stat {}: {}", path, std::strerror(errno))};
+
+    auto const size = static_cast<std::size_t>(st.st_size);
+    if (size < CHECKSUM_SIZE)
+        return std::unexpected{fmt::format("{} is too small to hold a checksum", path)};
+
+    auto* const mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, reader.fd_, 0);
+    if (mapped == MAP_FAILED)
+        return std::unexpected{fmt::format("Can't map {}: {}", path, std::strerror(errno))};
+
+    reader.data_ = static_cast<unsigned char const*>(mapped);
+    reader.size_ = size;
+    ::madvise(mapped, size, MADV_SEQUENTIAL);
+
+    auto const checksumOffset = size - CHECKSUM_SIZE;
+    uint32_t checksum = 0;
+    std::memcpy(&checksum, reader.data_ + checksumOffset, sizeof(checksum));
+
+    boost::crc_32_type crc;
+    crc.process_bytes(reader.data_, checksumOffset);
+    if (crc.checksum() != checksum)
+        return std::unexpected{fmt::format("{} has a checksum mismatch", path)};
+
+    return reader;
+}
+
+ChecksummedFileReader::ChecksummedFileReader(ChecksummedFileReader&& other) noexcept
+    : fd_{std::exchange(other.fd_, -1)}, data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)}
+{
+}
+
+ChecksummedFileReader::~ChecksummedFileReader()
+{
+    if (data_ != nullptr)
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+    if (fd_ >= 0)
+        ::close(fd_);
+}
+
+std::span<unsigned char const>
+ChecksummedFileReader::content() const
+{
+    return {data_, size_ - CHECKSUM_SIZE};
+}
+
+}  // namespace data::impl
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/crc.hpp>
+
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+
+namespace data::impl {
+
+/**
+ * @brief Writes a file that ends with a CRC-32 of everything before it.
+ *
+ * Data goes to a temporary file next to the target which replaces the target only once the file is committed, so an
+ * interrupted write never leaves a broken file behind.
+ */
+class ChecksummedFileWriter {
+    std::filesystem::path path_;
+    std::filesystem::path tmpPath_;
+    std::ofstream out_;
+    boost::crc_32_type crc_;
+    bool committed_ = false;
+
+public:
+    /**
+     * @brief Start writing a file.
+     *
+     * @param path The file to write
+     * @return The writer on success; error message otherwise
+     */
+    [[nodiscard]] static std::expected<ChecksummedFileWriter, std::string>
+    open(std::filesystem::path path);
+
+    ChecksummedFileWriter(ChecksummedFileWriter&& other);
+    ChecksummedFileWriter&
+    operator=(ChecksummedFileWriter&&) = delete;
+
+    /**
+     * @brief Removes the temporary file unless the file was committed.
+     */
+    ~ChecksummedFileWriter();
+
+    /**
+     * @brief Append data to the file.
+     *
+     * @param data The data to append
+     * @param size The size of the data in bytes
+     */
+    void
+    write(void const* data, std::size_t size);
+
+    /**
+     * @brief Append the checksum and move the file in place of the target.
+     *
+     * @return Nothing on success; error message otherwise
+     */
+    [[nodiscard]] std::expected<void, std::string>
+    commit();
+
+private:
+    explicit ChecksummedFileWriter(std::filesystem::path path);
+};
+
+/**
+ * @brief Reads a file written by ChecksummedFileWriter through a read-only memory mapping.
+ *
+ * The checksum is verified when the file is opened.
+ */
+class ChecksummedFileReader {
+    int fd_ = -1;
+    unsigned char const* data_ = nullptr;
+    std::size_t size_ = 0;
+
+public:
+    /**
+     * @brief Map a file and verify its checksum.
+     *
+     * @param path The file to read
+     * @return The reader on success; error message if the file can't be mapped or its checksum does not match
+     */
+    [[nodiscard]] static std::expected<ChecksummedFileReader, std::string>
+    open(std::filesystem::path const& path);
+
+    ChecksummedFileReader(ChecksummedFileReader&& other) noexcept;
+    ChecksummedFileReader&
+    operator=(ChecksummedFileReader&&) = delete;
+
+    ~ChecksummedFileReader();
+
+    /**
+     * @brief Get the content of the file.
+     *
+     * The content points into the mapped file and is valid as long as the reader is alive.
+     *
+     * @return Everything written to the file, without the checksum
+     */
+    [[nodiscard]] std::span<unsigned char const>
+    content() const;
+
+private:
+    ChecksummedFileReader() = default;
+};
+
+}  // namespace data::impl
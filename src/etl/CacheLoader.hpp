@@ -26,12 +26,20 @@
 #include "etl/impl/CursorFromDiffProvider.hpp"
 #include "etl/impl/CursorFromFixDiffNumProvider.hpp"
 #include "util/Assert.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/AnyOperation.hpp"
 #include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace etl {
 
@@ -48,13 +56,21 @@ template <typename CacheType, typename ExecutionContextType = util::async::CoroE
 class CacheLoader {
     using CacheLoaderType = impl::CacheLoaderImpl<CacheType>;
 
+    // replaying more ledger diffs than this takes about as long as loading the cache from the database
+    static constexpr uint32_t MAX_SNAPSHOT_AGE = 10000;
+
     util::Logger log_{"ETL"};
     std::shared_ptr<BackendInterface> backend_;
     std::reference_wrapper<CacheType> cache_;
 
     CacheLoaderSettings settings_;
     ExecutionContextType ctx_;
+    std::optional<util::async::AnyOperation<void>> snapshotTask_;
+
+    // guards loader_ which the snapshot catch up creates from the execution context if it has to fall back
+    std::mutex mtx_;
     std::unique_ptr<CacheLoaderType> loader_;
+    std::optional<util::async::AnyOperation<void>> catchUpTask_;
 
 public:
     /**
@@ -67,6 +83,23 @@ public:
     CacheLoader(util::Config const& config, std::shared_ptr<BackendInterface> const& backend, CacheType& cache)
         : backend_{backend}, cache_{cache}, settings_{make_CacheLoaderSettings(config)}, ctx_{settings_.numThreads}
     {
+        // set up here rather than in load() because on first run the cache is filled without loading it
+        cache_.get().setHistoryWindow(settings_.historyWindow);
+    }
+
+    /**
+     * @brief Stops loading and writing snapshots, waiting for a snapshot that is being written to finish
+     */
+    ~CacheLoader()
+    {
+        stop();
+        if (catchUpTask_.has_value())
+            catchUpTask_->wait();
+
+        if (snapshotTask_.has_value()) {
+            snapshotTask_->abort();
+            snapshotTask_->wait();
+        }
     }
 
     /**
@@ -75,6 +108,10 @@ public:
      * This function is blocking if the cache load style is set to sync and
      * disables the cache entirely if the load style is set to none/no.
      *
+     * If a snapshot file is configured, the cache is restored from it when possible and brought up to date with the
+     * ledgers written after it was taken, in the background unless the load style is sync. If that fails, the cache is
+     * cleared and loaded from the database instead. New snapshots are then written to it regularly.
+     *
      * @param seq The sequence number to load cache for
      */
     void
@@ -88,6 +125,58 @@ public:
             return;
         }
 
+        if (settings_.snapshotPath.has_value()) {
+            startSnapshots();
+            if (auto const snapshotSeq = restoreSnapshot(seq); snapshotSeq.has_value())
+                startCatchUp(*snapshotSeq, seq);
+        }
+
+        if (not catchUpTask_.has_value()) {
+            std::scoped_lock const lock{mtx_};
+            loadFromCursors(seq);
+        }
+
+        if (settings_.isSync()) {
+            wait();
+            ASSERT(cache_.get().isFull(), "Cache must be full after sync load. seq = {}", seq);
+        }
+    }
+
+    /**
+     * @brief Requests the loader to stop asap
+     */
+    void
+    stop() noexcept
+    {
+        std::scoped_lock const lock{mtx_};
+        if (catchUpTask_.has_value())
+            catchUpTask_->abort();
+        if (loader_)
+            loader_->stop();
+    }
+
+    /**
+     * @brief Waits for the loader to finish background work
+     */
+    void
+    wait() noexcept
+    {
+        if (catchUpTask_.has_value())
+            catchUpTask_->wait();
+
+        // once created the loader is never replaced, so it can be waited for without holding the lock
+        auto* loader = [this] {
+            std::scoped_lock const lock{mtx_};
+            return loader_.get();
+        }();
+        if (loader != nullptr)
+            loader->wait();
+    }
+
+private:
+    void
+    loadFromCursors(uint32_t const seq)
+    {
         std::shared_ptr<impl::BaseCursorProvider> provider;
         if (settings_.numCacheCursorsFromDiff != 0) {
             LOG(log_.info()) << "Loading cache with cursor from num_cursors_from_diff="
@@ -113,29 +202,102 @@ public:
             settings_.cachePageFetchSize,
             provider->getCursors(seq)
         );
+    }
 
-        if (settings_.isSync()) {
-            loader_->wait();
-            ASSERT(cache_.get().isFull(), "Cache must be full after sync load. seq = {}", seq);
+    std::optional<uint32_t>
+    restoreSnapshot(uint32_t const seq)
+    {
+        auto const minSeq = seq > MAX_SNAPSHOT_AGE ? seq - MAX_SNAPSHOT_AGE : 0u;
+        auto const snapshotSeq = cache_.get().loadSnapshot(*settings_.snapshotPath, minSeq, seq);
+        if (not snapshotSeq.has_value()) {
+            LOG(log_.warn()) << "Not loading cache from snapshot: " << snapshotSeq.error();
+            return std::nullopt;
         }
+
+        LOG(log_.info()) << "Loaded " << cache_.get().size() << " objects from cache snapshot of ledger "
+                         << *snapshotSeq << ". Catching up to " << seq;
+        return *snapshotSeq;
     }
 
-    /**
-     * @brief Requests the loader to stop asap
-     */
     void
-    stop() noexcept
+    startCatchUp(uint32_t const snapshotSeq, uint32_t const seq)
     {
-        loader_->stop();
+        std::scoped_lock const lock{mtx_};
+        catchUpTask_.emplace(util::async::AnyExecutionContext{ctx_}.execute([this, snapshotSeq, seq](auto token) {
+            if (catchUp(snapshotSeq, seq, token))
+                return;
+
+            std::scoped_lock const lock{mtx_};
+            if (token.isStopRequested())
+                return;
+
+            // the cache holds objects of ledgers newer than the snapshot so it has to be loaded from scratch
+            cache_.get().clear();
+            loadFromCursors(seq);
+        }));
+    }
+
+    bool
+    catchUp(uint32_t const snapshotSeq, uint32_t const seq, auto token)
+    {
+        for (auto diffSeq = snapshotSeq + 1; diffSeq <= seq; ++diffSeq) {
+            if (token.isStopRequested())
+                return false;
+
+            auto const diff =
+                data::retryOnTimeout([this, diffSeq, token] { return backend_->fetchLedgerDiff(diffSeq, token); });
+
+            // every ledger modifies at least the ledger hashes object so an empty diff means it could not be read
+            if (diff.empty()) {
+                LOG(log_.error()) << "Could not fetch diff of ledger " << diffSeq
+                                  << ". Loading cache from the database instead";
+                return false;
+            }
+
+            cache_.get().update(diff, diffSeq);
+        }
+
+        cache_.get().setFull();
+        LOG(log_.info()) << "Cache is up to date with ledger " << seq << ". Cache size = " << cache_.get().size();
+        return true;
     }
 
-    /**
-     * @brief Waits for the loader to finish background work
-     */
     void
-    wait() noexcept
+    startSnapshots()
     {
-        loader_->wait();
+        if (snapshotTask_.has_value())
+            return;
+
+        snapshotTask_.emplace(util::async::AnyExecutionContext{ctx_}.execute([this](auto token) {
+            auto const interval = std::chrono::seconds{settings_.snapshotInterval};
+            auto lastSnapshot = std::chrono::steady_clock::now();
+
+            boost::asio::yield_context yield = token;
+            boost::asio::steady_timer timer{yield.get_executor()};
+
+            // wake up every second to notice stop requests quickly
+            while (not token.isStopRequested()) {
+                timer.expires_after(std::chrono::seconds{1});
+                timer.async_wait(yield);
+
+                if (std::chrono::steady_clock::now() - lastSnapshot < interval or not cache_.get().isFull())
+                    continue;
+
+                auto const start = std::chrono::steady_clock::now();
+                if (auto const snapshotSeq = cache_.get().writeSnapshot(*settings_.snapshotPath);
+                    snapshotSeq.has_value()) {
+                    LOG(log_.info()) << "Wrote cache snapshot of ledger " << *snapshotSeq << " in "
+                                     << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            std::chrono::steady_clock::now() - start
+                                        )
+                                            .count()
+                                     << " milliseconds";
+                } else {
+                    LOG(log_.error()) << "Could not write cache snapshot: " << snapshotSeq.error();
+                }
+                lastSnapshot = std::chrono::steady_clock::now();
+            }
+        }));
     }
 };
 
@@ -24,6 +24,7 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace etl {
@@ -62,6 +63,9 @@ make_CacheLoaderSettings(util::Config const& config)
 
         settings.numCacheMarkers = cache.valueOr<size_t>("num_markers", settings.numCacheMarkers);
         settings.cachePageFetchSize = cache.valueOr<size_t>("page_fetch_size", settings.cachePageFetchSize);
+        settings.historyWindow = cache.valueOr<uint32_t>("history_window", settings.historyWindow);
+        settings.snapshotPath = cache.maybeValue<std::string>("snapshot_path");
+        settings.snapshotInterval = cache.valueOr<size_t>("snapshot_interval", settings.snapshotInterval);
 
         if (auto entry = cache.maybeValue<std::string>("load"); entry) {
             if (boost::iequals(*entry, "sync"))
@@ -22,6 +22,9 @@
 #include "util/config/Config.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
 
 namespace etl {
 
@@ -38,6 +41,10 @@ struct CacheLoaderSettings {
     size_t numThreads = 2;                 /**< number of threads to use for loading cache */
     size_t numCacheCursorsFromDiff = 0;    /**< number of cursors to fetch from diff */
     size_t numCacheCursorsFromAccount = 0; /**< number of cursors to fetch from account_tx */
+    uint32_t historyWindow = 0;            /**< number of past ledgers to keep replaced objects for */
+
+    std::optional<std::string> snapshotPath; /**< file to periodically save the cache to and restore it from */
+    size_t snapshotInterval = 600;           /**< seconds between cache snapshots */
 
     LoadStyle loadStyle = LoadStyle::ASYNC; /**< how to load the cache */
 
@@ -39,6 +39,7 @@
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -153,6 +154,7 @@ ETLService::monitor()
     }
 
     ASSERT(rng.has_value(), "Ledger range can't be null");
+    closeTimeIndexLoader_.load(*rng);
     uint32_t nextSequence = rng->maxSequence + 1;
 
     LOG(log_.debug()) << "Database is populated. Starting monitor loop. sequence = " << nextSequence;
@@ -223,6 +225,8 @@ ETLService::monitorReadOnly()
     uint32_t latestSequence = *latestSequenceOpt;
 
     cacheLoader_.load(latestSequence);
+    if (auto const rng = backend_->hardFetchLedgerRangeNoThrow(); rng.has_value())
+        closeTimeIndexLoader_.load(*rng);
     latestSequence++;
 
     while (not isStopping()) {
@@ -273,8 +277,19 @@ ETLService::ETLService(
     , loadBalancer_(balancer)
     , networkValidatedLedgers_(std::move(ledgers))
     , cacheLoader_(config, backend, backend->cache())
+    , closeTimeIndexLoader_(
+          backend,
+          config.maybeValue<std::string>("close_time_index.path"),
+          config.maybeValue<uint32_t>("close_time_index.backfill_depth")
+      )
     , ledgerFetcher_(backend, balancer)
-    , ledgerLoader_(backend, balancer, ledgerFetcher_, state_)
+    , ledgerLoader_(
+          backend,
+          balancer,
+          ledgerFetcher_,
+          state_,
+          config.valueOr<uint32_t>("transformer_threads", LedgerLoaderType::DEFAULT_NUM_THREADS)
+      )
     , ledgerPublisher_(ioc, backend, backend->cache(), subscriptions, state_)
     , amendmentBlockHandler_(ioc, state_)
 {
@@ -27,6 +27,7 @@
 #include "etl/NetworkValidatedLedgersInterface.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/AmendmentBlockHandler.hpp"
+#include "etl/impl/CloseTimeIndexLoader.hpp"
 #include "etl/impl/ExtractionDataPipe.hpp"
 #include "etl/impl/Extractor.hpp"
 #include "etl/impl/LedgerFetcher.hpp"
@@ -77,6 +78,7 @@ class ETLService {
     using DataPipeType = etl::impl::ExtractionDataPipe<org::xrpl::rpc::v1::GetLedgerResponse>;
     using CacheType = data::LedgerCache;
     using CacheLoaderType = etl::CacheLoader<CacheType>;
+    using CloseTimeIndexLoaderType = etl::impl::CloseTimeIndexLoader;
     using LedgerFetcherType = etl::impl::LedgerFetcher<LoadBalancerType>;
     using ExtractorType = etl::impl::Extractor<DataPipeType, LedgerFetcherType>;
     using LedgerLoaderType = etl::impl::LedgerLoader<LoadBalancerType, LedgerFetcherType>;
@@ -95,6 +97,7 @@ class ETLService {
     std::thread worker_;
 
     CacheLoaderType cacheLoader_;
+    CloseTimeIndexLoaderType closeTimeIndexLoader_;
     LedgerFetcherType ledgerFetcher_;
     LedgerLoaderType ledgerLoader_;
     LedgerPublisherType ledgerPublisher_;
@@ -166,6 +169,7 @@ public:
 
         state_.isStopping = true;
         cacheLoader_.stop();
+        closeTimeIndexLoader_.stop();
 
         if (worker_.joinable())
             worker_.join();
@@ -0,0 +1,330 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "data/BackendInterface.hpp"
+#include "data/LedgerCloseTimeIndex.hpp"
+#include "data/Types.hpp"
+#include "util/async/AnyExecutionContext.hpp"
+#include "util/async/AnyOperation.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
+#include "util/log/Logger.hpp"
+
+#include <xrpl/basics/chrono.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief Fills the close time index of the backend with the ledgers written before Clio started.
+ *
+ * The index is restored from its file if one is configured and the ledgers the file lacks are read from the database
+ * in the background, newest first. Every chunk of ledgers is added to the index as soon as it and all newer chunks are
+ * read, so the index becomes usable for recent ledgers right away. The index is written back to the file when the
+ * loader is destroyed, so the database is only read for the ledgers written while Clio was not running.
+ */
+class CloseTimeIndexLoader {
+    static constexpr std::uint32_t LEDGERS_PER_TASK = 1000;
+    static constexpr std::size_t MAX_CONCURRENT_TASKS = 32;
+    static constexpr std::size_t MAX_TASK_ATTEMPTS = 3;
+    static constexpr std::size_t NUM_THREADS = 2;
+
+    using CloseTimes = std::vector<std::uint32_t>;
+
+    struct Chunk {
+        std::uint32_t first;
+        std::uint32_t last;
+        util::async::AnyOperation<std::optional<CloseTimes>> operation;
+        std::size_t attempts = 1;
+    };
+
+    util::Logger log_{"ETL"};
+
+    std::shared_ptr<BackendInterface> backend_;
+    std::optional<std::string> path_;
+    std::uint32_t backfillDepth_;
+
+    util::async::CoroExecutionContext ctx_{NUM_THREADS};
+    std::atomic_bool stopping_ = false;
+    std::atomic_bool saveOnExit_ = false;
+    std::thread worker_;
+
+public:
+    // about four days of ledgers; reading them takes a few minutes
+    static constexpr std::uint32_t DEFAULT_BACKFILL_DEPTH = 100'000;
+
+    /**
+     * @brief Construct a new close time index loader.
+     *
+     * @param backend The backend whose index to fill
+     * @param path The file the index is saved to and restored from; nullopt to not persist the index
+     * @param backfillDepth Number of the newest ledgers to read from the database at least; nullopt for the default
+     */
+    CloseTimeIndexLoader(
+        std::shared_ptr<BackendInterface> backend,
+        std::optional<std::string> path,
+        std::optional<std::uint32_t> backfillDepth
+    )
+        : backend_{std::move(backend)}
+        , path_{std::move(path)}
+        , backfillDepth_{backfillDepth.value_or(DEFAULT_BACKFILL_DEPTH)}
+    {
+    }
+
+    /**
+     * @brief Stops backfilling and saves the index unless that would lose ledgers restored from the file.
+     */
+    ~CloseTimeIndexLoader()
+    {
+        stop();
+        if (worker_.joinable())
+            worker_.join();
+
+        if (not path_.has_value() or not saveOnExit_ or not backend_->closeTimeIndex().range().has_value())
+            return;
+
+        if (auto const saved = backend_->closeTimeIndex().save(*path_); saved.has_value()) {
+            LOG(log_.info()) << "Saved close times of ledgers " << saved->minSequence << "-" << saved->maxSequence;
+        } else {
+            LOG(log_.error()) << "Could not save close time index: " << saved.error();
+        }
+    }
+
+    CloseTimeIndexLoader(CloseTimeIndexLoader const&) = delete;
+    CloseTimeIndexLoader&
+    operator=(CloseTimeIndexLoader const&) = delete;
+
+    /**
+     * @brief Start filling the index in the background.
+     *
+     * Ledgers newer than the given range are expected to be added to the index as they are published.
+     *
+     * @param range The range of ledgers in the database
+     */
+    void
+    load(data::LedgerRange const& range)
+    {
+        if (worker_.joinable())
+            return;
+
+        worker_ = std::thread([this, range]() { backfill(range); });
+    }
+
+    /**
+     * @brief Requests the loader to stop asap.
+     */
+    void
+    stop() noexcept
+    {
+        stopping_ = true;
+    }
+
+private:
+    void
+    backfill(data::LedgerRange const& range)
+    {
+        auto const numLedgers = range.maxSequence - range.minSequence + 1;
+        auto const backfillFrom = range.maxSequence - std::min(backfillDepth_, numLedgers) + 1;
+
+        data::LedgerCloseTimeIndex fromFile;
+        auto const restored =
+            path_.has_value() and restore(fromFile, range, backfillFrom) ? fromFile.range() : std::nullopt;
+
+        // until the restored ledgers are in the index, saving it would lose them
+        saveOnExit_ = not restored.has_value();
+
+        // the ledgers newer than the restored ones, then the restored ones, then the older ones within the depth
+        auto const fetchFrom = restored.has_value() ? restored->maxSequence + 1 : backfillFrom;
+        if (fetchFrom <= range.maxSequence and not fetchCloseTimes(fetchFrom, range.maxSequence))
+            return;
+
+        if (restored.has_value()) {
+            if (not prepend(fromFile))
+                return;
+            saveOnExit_ = true;
+        }
+
+        auto const oldestKnown = restored.has_value() ? restored->minSequence : backfillFrom;
+        if (backfillFrom < oldestKnown and not fetchCloseTimes(backfillFrom, oldestKnown - 1))
+            return;
+
+        if (auto const indexed = backend_->closeTimeIndex().range(); indexed.has_value()) {
+            LOG(log_.info()) << "Close time index covers ledgers " << indexed->minSequence << "-"
+                             << indexed->maxSequence;
+        }
+    }
+
+    bool
+    restore(data::LedgerCloseTimeIndex& index, data::LedgerRange const& range, std::uint32_t backfillFrom)
+    {
+        data::LedgerCloseTimeIndex fromFile;
+        auto const loaded = fromFile.load(*path_);
+        if (not loaded.has_value()) {
+            LOG(log_.warn()) << "Not restoring close time index: " << loaded.error();
+            return false;
+        }
+
+        // joining a file that ends before the backfill depth would mean reading more ledgers than the depth allows
+        if (loaded->maxSequence + 1 < backfillFrom) {
+            LOG(log_.warn()) << "Not restoring close time index: it ends at ledger " << loaded->maxSequence
+                             << " which is older than the backfill depth";
+            return false;
+        }
+
+        // a file written for another database must not be used; comparing the newest ledger both know is enough
+        auto const seq = std::min(loaded->maxSequence, range.maxSequence);
+        if (seq < std::max(loaded->minSequence, range.minSequence)) {
+            LOG(log_.warn()) << "Not restoring close time index: it has no ledgers in common with the database";
+            return false;
+        }
+
+        std::optional<ripple::LedgerHeader> header;
+        try {
+            header = data::synchronous([this, seq](auto yield) {
+                return backend_->hardFetchLedgerBySequence(seq, yield);
+            });
+        } catch (data::DatabaseTimeout const&) {
+            LOG(log_.warn()) << "Not restoring close time index: timed out reading ledger " << seq;
+            return false;
+        }
+
+        if (not header.has_value() or header->closeTime != fromFile.closeTime(seq)) {
+            LOG(log_.warn()) << "Not restoring close time index: close time of ledger " << seq
+                             << " does not match the database";
+            return false;
+        }
+
+        LOG(log_.info()) << "Restored close times of ledgers " << loaded->minSequence << "-" << loaded->maxSequence;
+        return index.prepend(fromFile);
+    }
+
+    /**
+     * Reads the close times of [first, last] in chunks, newest first, and prepends every chunk to the index once all
+     * newer chunks are in. A chunk that can not be read is retried a few times; if it still fails, the backfill stops
+     * and the index keeps the newer ledgers it already has.
+     */
+    bool
+    fetchCloseTimes(std::uint32_t first, std::uint32_t last)
+    {
+        LOG(log_.info()) << "Reading close times of ledgers " << first << "-" << last;
+
+        // a limited number of chunks is in flight to not overload the database
+        std::deque<Chunk> inFlight;
+        auto nextLast = static_cast<std::int64_t>(last);
+        auto const startNext = [&] {
+            auto const chunkLast = static_cast<std::uint32_t>(nextLast);
+            auto const chunkFirst = chunkLast - std::min(chunkLast - first, LEDGERS_PER_TASK - 1);
+            inFlight.push_back({chunkFirst, chunkLast, readChunk(chunkFirst, chunkLast)});
+            nextLast = static_cast<std::int64_t>(chunkFirst) - 1;
+        };
+
+        while (not stopping_ and (not inFlight.empty() or nextLast >= first)) {
+            while (inFlight.size() < MAX_CONCURRENT_TASKS and nextLast >= first)
+                startNext();
+
+            auto& chunk = inFlight.front();
+            auto closeTimes = chunk.operation.get();
+            if (not closeTimes.has_value() or not closeTimes->has_value()) {
+                if (stopping_)
+                    break;
+
+                if (chunk.attempts == MAX_TASK_ATTEMPTS) {
+                    LOG(log_.error()) << "Could not read close times of ledgers " << chunk.first << "-" << chunk.last
+                                      << ". Close time index stops at ledger " << chunk.last + 1;
+                    break;
+                }
+
+                ++chunk.attempts;
+                chunk.operation = readChunk(chunk.first, chunk.last);
+                continue;
+            }
+
+            if (not prepend(data::LedgerCloseTimeIndex{chunk.first, std::move(*closeTimes).value()}))
+                break;
+
+            LOG(log_.debug()) << "Close time index reaches back to ledger " << chunk.first;
+            inFlight.pop_front();
+        }
+
+        for (auto& chunk : inFlight) {
+            chunk.operation.abort();
+            chunk.operation.wait();
+        }
+
+        return not stopping_ and inFlight.empty() and nextLast < first;
+    }
+
+    util::async::AnyOperation<std::optional<CloseTimes>>
+    readChunk(std::uint32_t first, std::uint32_t last)
+    {
+        return util::async::AnyExecutionContext{ctx_}.execute(
+            [this, first, last](auto token) -> std::optional<CloseTimes> {
+                CloseTimes closeTimes;
+                closeTimes.reserve(last - first + 1);
+
+                for (auto seq = first; seq <= last; ++seq) {
+                    if (stopping_ or token.isStopRequested())
+                        return std::nullopt;
+
+                    // a timeout fails the chunk; it is retried a limited number of times by fetchCloseTimes
+                    std::optional<ripple::LedgerHeader> header;
+                    try {
+                        header = backend_->hardFetchLedgerBySequence(seq, token);
+                    } catch (data::DatabaseTimeout const&) {
+                        LOG(log_.warn()) << "Timed out reading ledger " << seq << " to backfill close time index";
+                        return std::nullopt;
+                    }
+
+                    if (not header.has_value()) {
+                        LOG(log_.error()) << "Could not read ledger " << seq << " to backfill close time index";
+                        return std::nullopt;
+                    }
+                    closeTimes.push_back(header->closeTime.time_since_epoch().count());
+                }
+                return closeTimes;
+            }
+        );
+    }
+
+    bool
+    prepend(data::LedgerCloseTimeIndex const& older)
+    {
+        if (backend_->closeTimeIndex().prepend(older))
+            return true;
+
+        LOG(log_.warn()) << "Ledgers are missing between the backfilled and the published ones. "
+                            "Close time index only covers published ledgers";
+        return false;
+    }
+};
+
+}  // namespace etl::impl
@@ -19,7 +19,7 @@
 
 #pragma once
 
-#include "etl/ETLHelpers.hpp"
+#include "etl/impl/SpscQueue.hpp"
 #include "util/log/Logger.hpp"
 
 #include <cstddef>
@@ -32,12 +32,16 @@ namespace etl::impl {
 
 /**
  * @brief A collection of thread safe async queues used by Extractor and Transformer to communicate
+ *
+ * Each queue has exactly one producer, the extractor of its stride, and one consumer, the transformer.
+ *
+ * @tparam RawDataType The type of the extracted data
+ * @tparam QueueType The type of the queues; a single producer single consumer queue by default
  */
-template <typename RawDataType>
+template <typename RawDataType, typename QueueType = SpscQueue<std::optional<RawDataType>>>
 class ExtractionDataPipe {
 public:
     using DataType = std::optional<RawDataType>;
-    using QueueType = ThreadSafeQueue<DataType>;  // TODO: probably should use boost::lockfree::queue instead?
 
     constexpr static auto TOTAL_MAX_IN_QUEUE = 1000u;
 
@@ -60,7 +64,7 @@ public:
     {
         auto const maxQueueSize = TOTAL_MAX_IN_QUEUE / stride;
         for (size_t i = 0; i < stride_; ++i)
-            queues_.push_back(std::make_unique<QueueType>(maxQueueSize));
+            queues_.push_back(std::make_shared<QueueType>(maxQueueSize));
     }
 
     /**
@@ -120,6 +124,7 @@ public:
     cleanup()
     {
         // TODO: this should not have to be called by hand. it should be done via RAII
+        // the transformer has exited, so this thread is the only consumer now
         for (auto i = 0u; i < stride_; ++i)
             getQueue(i)->tryPop();  // pop from each queue that might be blocked on a push
     }
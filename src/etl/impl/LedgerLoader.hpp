@@ -28,6 +28,7 @@
 #include "util/Assert.hpp"
 #include "util/LedgerUtils.hpp"
 #include "util/Profiler.hpp"
+#include "util/async/context/BasicExecutionContext.hpp"
 #include "util/log/Logger.hpp"
 
 #include <xrpl/basics/base_uint.h>
@@ -38,13 +39,17 @@
 #include <xrpl/protocol/Serializer.h>
 #include <xrpl/protocol/TxMeta.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -69,7 +74,27 @@ public:
     using OptionalGetLedgerResponseType = typename LoadBalancerType::OptionalGetLedgerResponseType;
     using RawLedgerObjectType = typename LoadBalancerType::RawLedgerObjectType;
 
+    static constexpr std::uint32_t DEFAULT_NUM_THREADS = 4;
+    static constexpr std::size_t MIN_TRANSACTIONS_PER_TASK = 32;
+
 private:
+    /**
+     * @brief The transactions of a contiguous range of a ledger, ready to be written, and the rows derived from them.
+     */
+    struct ParsedTransactions {
+        struct TransactionRecord {
+            std::string key;
+            std::string blob;
+            std::string metadata;
+        };
+
+        FormattedTransactionsData data;
+        std::vector<TransactionRecord> transactions;
+    };
+
+    using TransactionsType = std::remove_reference_t<
+        decltype(*std::declval<GetLedgerResponseType&>().mutable_transactions_list()->mutable_transactions())>;
+
     util::Logger log_{"ETL"};
 
     std::shared_ptr<BackendInterface> backend_;
@@ -77,21 +102,35 @@ private:
     std::reference_wrapper<LedgerFetcherType> fetcher_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
 
+    std::uint32_t numThreads_;
+    std::optional<util::async::PoolExecutionContext> ctx_;  // not started when parsing on the calling thread only
+
 public:
     /**
      * @brief Create an instance of the loader
+     *
+     * @param backend The backend to write to
+     * @param balancer The load balancer to download the initial ledger from
+     * @param fetcher The fetcher of ledger data
+     * @param state The shared state of ETL
+     * @param numThreads The number of threads parsing the transactions of a ledger, including the calling thread; no
+     * thread pool is started when it is 1
      */
     LedgerLoader(
         std::shared_ptr<BackendInterface> backend,
         std::shared_ptr<LoadBalancerType> balancer,
         LedgerFetcherType& fetcher,
-        SystemState const& state
+        SystemState const& state,
+        std::uint32_t numThreads = DEFAULT_NUM_THREADS
     )
         : backend_{std::move(backend)}
         , loadBalancer_{std::move(balancer)}
         , fetcher_{std::ref(fetcher)}
         , state_{std::cref(state)}
+        , numThreads_{std::max(numThreads, 1u)}
     {
+        if (numThreads_ > 1)
+            ctx_.emplace(numThreads_ - 1);
     }
 
     /**
@@ -100,6 +139,8 @@ public:
      * Insert all of the extracted transactions into the ledger, returning transactions related to accounts,
      * transactions related to NFTs, and NFTs themselves for later processsing.
      *
+     * Contiguous ranges of transactions are parsed in parallel; the results are merged and written in ledger order.
+     *
      * @param ledger ledger to insert transactions into
      * @param data data extracted from an ETL source
      * @return The neccessary info to write the account_transactions/account_tx and nft_token_transactions tables
@@ -107,33 +148,58 @@ public:
     FormattedTransactionsData
     insertTransactions(ripple::LedgerHeader const& ledger, GetLedgerResponseType& data)
     {
-        FormattedTransactionsData result;
-
-        for (auto& txn : *(data.mutable_transactions_list()->mutable_transactions())) {
-            std::string* raw = txn.mutable_transaction_blob();
+        auto& txns = *data.mutable_transactions_list()->mutable_transactions();
+        auto const numTxns = static_cast<std::size_t>(txns.size());
+        auto const numTasks = std::clamp<std::size_t>(numTxns / MIN_TRANSACTIONS_PER_TASK, 1, numThreads_);
+        auto const taskSize = (numTxns + numTasks - 1) / numTasks;
+
+        std::vector<ParsedTransactions> parsed(numTasks);
+        std::vector<std::exception_ptr> errors(numTasks);
+        auto const parseRange = [&](std::size_t index) {
+            auto const begin = index * taskSize;
+            try {
+                parsed[index] = parseTransactions(ledger, txns, begin, std::min(begin + taskSize, numTxns));
+            } catch (...) {
+                errors[index] = std::current_exception();
+            }
+        };
+
+        // the first range is parsed on the calling thread while the pool parses the others
+        std::vector<util::async::PoolExecutionContext::Operation<void>> operations;
+        operations.reserve(numTasks - 1);
+        for (std::size_t index = 1; index < numTasks; ++index) {
+            ASSERT(ctx_.has_value(), "Parsing {} ranges requires the thread pool", numTasks);
+            operations.push_back(ctx_->execute([&parseRange, index]() { parseRange(index); }));
+        }
 
-            ripple::SerialIter it{raw->data(), raw->size()};
-            ripple::STTx const sttx{it};
+        parseRange(0);
 
-            LOG(log_.trace()) << "Inserting transaction = " << sttx.getTransactionID();
+        // every range must be done before returning because the tasks reference the ledger data
+        for (auto& operation : operations)
+            operation.wait();
 
-            ripple::TxMeta txMeta{sttx.getTransactionID(), ledger.seq, txn.metadata_blob()};
+        // the error of the earliest failing range is reported, as it would be if the ledger was parsed sequentially
+        for (auto const& error : errors) {
+            if (error)
+                std::rethrow_exception(error);
+        }
 
-            auto const [nftTxs, maybeNFT] = getNFTDataFromTx(txMeta, sttx);
-            result.nfTokenTxData.insert(result.nfTokenTxData.end(), nftTxs.begin(), nftTxs.end());
-            if (maybeNFT)
-                result.nfTokensData.push_back(*maybeNFT);
+        // merging and writing in the order of the ledger keeps the writes deterministic
+        FormattedTransactionsData result;
+        for (auto& range : parsed) {
+            for (auto& txn : range.transactions) {
+                backend_->writeTransaction(
+                    std::move(txn.key),
+                    ledger.seq,
+                    ledger.closeTime.time_since_epoch().count(),
+                    std::move(txn.blob),
+                    std::move(txn.metadata)
+                );
+            }
 
-            result.accountTxData.emplace_back(txMeta, sttx.getTransactionID());
-            static constexpr std::size_t KEY_SIZE = 32;
-            std::string keyStr{reinterpret_cast<char const*>(sttx.getTransactionID().data()), KEY_SIZE};
-            backend_->writeTransaction(
-                std::move(keyStr),
-                ledger.seq,
-                ledger.closeTime.time_since_epoch().count(),
-                std::move(*raw),
-                std::move(*txn.mutable_metadata_blob())
-            );
+            std::ranges::move(range.data.accountTxData, std::back_inserter(result.accountTxData));
+            std::ranges::move(range.data.nfTokenTxData, std::back_inserter(result.nfTokenTxData));
+            std::ranges::move(range.data.nfTokensData, std::back_inserter(result.nfTokensData));
         }
 
         result.nfTokensData = getUniqueNFTsDatas(result.nfTokensData);
@@ -248,6 +314,42 @@ public:
         LOG(log_.debug()) << "Time to download and store ledger = " << timeDiff;
         return lgrInfo;
     }
+
+private:
+    ParsedTransactions
+    parseTransactions(ripple::LedgerHeader const& ledger, TransactionsType& txns, std::size_t begin, std::size_t end)
+        const
+    {
+        ParsedTransactions result;
+        result.transactions.reserve(end - begin);
+
+        for (auto i = begin; i < end; ++i) {
+            auto& txn = *txns.Mutable(static_cast<int>(i));
+            std::string* raw = txn.mutable_transaction_blob();
+
+            ripple::SerialIter it{raw->data(), raw->size()};
+            ripple::STTx const sttx{it};
+
+            LOG(log_.trace()) << "Inserting transaction = " << sttx.getTransactionID();
+
+            ripple::TxMeta txMeta{sttx.getTransactionID(), ledger.seq, txn.metadata_blob()};
+
+            auto const [nftTxs, maybeNFT] = getNFTDataFromTx(txMeta, sttx);
+            result.data.nfTokenTxData.insert(result.data.nfTokenTxData.end(), nftTxs.begin(), nftTxs.end());
+            if (maybeNFT)
+                result.data.nfTokensData.push_back(*maybeNFT);
+
+            result.data.accountTxData.emplace_back(txMeta, sttx.getTransactionID());
+            static constexpr std::size_t KEY_SIZE = 32;
+            result.transactions.push_back(
+                {std::string{reinterpret_cast<char const*>(sttx.getTransactionID().data()), KEY_SIZE},
+                 std::move(*raw),
+                 std::move(*txn.mutable_metadata_blob())}
+            );
+        }
+
+        return result;
+    }
 };
 
 }  // namespace etl::impl
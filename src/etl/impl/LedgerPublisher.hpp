@@ -169,6 +169,9 @@ public:
                 LOG(log_.info()) << "Updating ledger range for read node.";
 
                 if (!cache_.get().isDisabled()) {
+                    // the cache may still be catching up from a snapshot and ledgers must be applied in order
+                    cache_.get().waitUntilCacheContainsSeq(lgrInfo.seq - 1);
+
                     std::vector<data::LedgerObject> const diff = data::synchronousAndRetryOnTimeout([&](auto yield) {
                         return backend_->fetchLedgerDiff(lgrInfo.seq, yield);
                     });
@@ -179,6 +182,11 @@ public:
                 backend_->updateRange(lgrInfo.seq);
             }
 
+            if (not backend_->closeTimeIndex().add(lgrInfo.seq, lgrInfo.closeTime)) {
+                LOG(log_.warn()) << "Ledger " << lgrInfo.seq
+                                 << " does not follow the close time index. Not adding it to the index";
+            }
+            backend_->ledgerHeaderCache().put(lgrInfo);
             setLastClose(lgrInfo.closeTime);
             auto age = lastCloseAgeSeconds();
 
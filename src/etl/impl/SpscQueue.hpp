@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/Assert.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace etl::impl {
+
+/**
+ * @brief Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Each side owns one index of the ring and keeps a cached copy of the other side's index, so a push or a pop only
+ * touches the cache line of the other side when the cached index says the ring looks full or empty. A side that has
+ * to wait spins for a short while and then parks on the index of the other side with `std::atomic::wait`.
+ *
+ * @tparam T The type of the elements
+ */
+template <typename T>
+class SpscQueue {
+    static constexpr std::uint32_t SPIN_ITERATIONS = 256;
+
+    std::vector<std::optional<T>> slots_;
+
+    alignas(64) std::atomic_size_t head_{0};  // next slot to pop; written by the consumer only
+    std::size_t cachedTail_ = 0;              // consumer's copy of tail_
+
+    alignas(64) std::atomic_size_t tail_{0};  // next slot to push; written by the producer only
+    std::size_t cachedHead_ = 0;              // producer's copy of head_
+
+public:
+    /**
+     * @brief Create an instance of the queue.
+     *
+     * @param capacity The maximum number of elements in the queue. A push to a full queue blocks until the consumer
+     * popped an element.
+     */
+    explicit SpscQueue(std::size_t capacity) : slots_(capacity)
+    {
+        ASSERT(capacity > 0, "Capacity of SpscQueue must be positive");
+    }
+
+    /**
+     * @brief Push element onto the queue; must only be called by the producer thread.
+     *
+     * Note: This method will block until free space is available.
+     *
+     * @param elt Element to push onto queue. Ownership is transferred
+     */
+    void
+    push(T&& elt)
+    {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == slots_.size()) {
+            cachedHead_ = waitForChange(head_, tail - slots_.size());
+        }
+
+        slots_[tail % slots_.size()].emplace(std::move(elt));
+        tail_.store(tail + 1, std::memory_order_release);
+        tail_.notify_one();
+    }
+
+    /**
+     * @brief Pop element from the queue; must only be called by the consumer thread.
+     *
+     * Note: Will block until queue is non-empty.
+     *
+     * @return Element popped from queue
+     */
+    T
+    pop()
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_)
+            cachedTail_ = waitForChange(tail_, head);
+
+        return take(head);
+    }
+
+    /**
+     * @brief Attempt to pop an element; must only be called by the consumer thread.
+     *
+     * @return Element popped from queue or empty optional if queue was empty
+     */
+    std::optional<T>
+    tryPop()
+    {
+        auto const head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+                return std::nullopt;
+        }
+
+        return take(head);
+    }
+
+    /**
+     * @return The number of elements in the queue; only exact when neither side is running
+     */
+    std::size_t
+    size() const
+    {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+
+private:
+    T
+    take(std::size_t head)
+    {
+        auto& slot = slots_[head % slots_.size()];
+        T elt = std::move(*slot);
+        slot.reset();
+
+        head_.store(head + 1, std::memory_order_release);
+        head_.notify_one();
+        return elt;
+    }
+
+    static std::size_t
+    waitForChange(std::atomic_size_t const& index, std::size_t old)
+    {
+        for (std::uint32_t i = 0; i < SPIN_ITERATIONS; ++i) {
+            if (auto const current = index.load(std::memory_order_acquire); current != old)
+                return current;
+            std::this_thread::yield();
+        }
+
+        index.wait(old, std::memory_order_acquire);
+        return index.load(std::memory_order_acquire);
+    }
+};
+
+}  // namespace etl::impl
@@ -22,6 +22,7 @@
 #include "data/BackendInterface.hpp"
 #include "data/DBHelpers.hpp"
 #include "data/Types.hpp"
+#include "etl/ETLHelpers.hpp"
 #include "etl/SystemState.hpp"
 #include "etl/impl/AmendmentBlockHandler.hpp"
 #include "etl/impl/LedgerLoader.hpp"
@@ -61,6 +62,10 @@ namespace etl::impl {
 
 /**
  * @brief Transformer thread that prepares new ledger out of raw data from GRPC.
+ *
+ * Ledgers are committed by a second thread: while the writes of a ledger drain, the transformer thread already builds
+ * the next ledgers and issues their writes. Ledgers are committed and published strictly in order, and at most
+ * @ref MAX_PENDING_COMMITS built ledgers wait for their commit.
  */
 template <
     typename DataPipeType,
@@ -71,6 +76,16 @@ class Transformer {
     using GetLedgerResponseType = typename LedgerLoaderType::GetLedgerResponseType;
     using RawLedgerObjectType = typename LedgerLoaderType::RawLedgerObjectType;
 
+    /**
+     * @brief A ledger whose writes were issued and that waits to be committed.
+     */
+    struct PendingCommit {
+        ripple::LedgerHeader lgrInfo;
+        std::chrono::system_clock::time_point start;
+        int numTxns;
+        int numObjects;
+    };
+
     util::Logger log_{"ETL"};
 
     std::reference_wrapper<DataPipeType> pipe_;
@@ -82,14 +97,20 @@ class Transformer {
     uint32_t startSequence_;
     std::reference_wrapper<SystemState> state_;  // shared state for ETL
 
+    // an empty optional tells the commit thread that the transformer thread has stopped
+    ThreadSafeQueue<std::optional<PendingCommit>> commits_;
+
     std::thread thread_;
+    std::thread commitThread_;
 
 public:
+    static constexpr std::uint32_t MAX_PENDING_COMMITS = 2;
+
     /**
      * @brief Create an instance of the transformer.
      *
-     * This spawns a new thread that reads from the data pipe and writes ledgers to the DB using LedgerLoader and
-     * LedgerPublisher.
+     * This spawns a new thread that reads from the data pipe and writes ledgers to the DB using LedgerLoader, and a
+     * thread that commits the written ledgers and publishes them using LedgerPublisher.
      */
     Transformer(
         DataPipeType& pipe,
@@ -107,27 +128,32 @@ public:
         , amendmentBlockHandler_{std::ref(amendmentBlockHandler)}
         , startSequence_{startSequence}
         , state_{std::ref(state)}
+        , commits_{MAX_PENDING_COMMITS - 1}
     {
+        commitThread_ = std::thread([this]() { commit(); });
         thread_ = std::thread([this]() { process(); });
     }
 
     /**
-     * @brief Joins the transformer thread.
+     * @brief Joins the transformer and commit threads.
      */
     ~Transformer()
     {
         if (thread_.joinable())
             thread_.join();
+        if (commitThread_.joinable())
+            commitThread_.join();
     }
 
     /**
-     * @brief Block calling thread until transformer thread exits.
+     * @brief Block calling thread until transformer thread exits and all built ledgers are committed.
      */
     void
     waitTillFinished()
     {
         ASSERT(thread_.joinable(), "Transformer thread must be joinable");
         thread_.join();
+        commitThread_.join();
     }
 
 private:
@@ -150,38 +176,70 @@ private:
                 continue;
 
             auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            auto const lgrInfo = buildNextLedger(*fetchResponse);
+            if (not lgrInfo) {
+                setWriteConflict(true);
+                break;
+            }
+
+            // blocks while MAX_PENDING_COMMITS ledgers wait for their commit
+            commits_.push(PendingCommit{
+                .lgrInfo = *lgrInfo,
+                .start = start,
+                .numTxns = fetchResponse->transactions_list().transactions_size(),
+                .numObjects = fetchResponse->ledger_objects().objects_size()
+            });
+        }
+
+        commits_.push(std::nullopt);
+    }
+
+    void
+    commit()
+    {
+        beast::setCurrentThreadName("ETLService commit");
+
+        auto failed = false;
+        while (auto pending = commits_.pop()) {
+            // a later ledger must not be committed once an earlier one failed
+            if (failed)
+                continue;
+
+            auto const& lgrInfo = pending->lgrInfo;
+            auto [success, duration] =
+                ::util::timed<std::chrono::duration<double>>([&]() { return backend_->finishWrites(lgrInfo.seq); });
+
+            LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
 
             if (success) {
-                auto const numTxns = fetchResponse->transactions_list().transactions_size();
-                auto const numObjects = fetchResponse->ledger_objects().objects_size();
                 auto const end = std::chrono::system_clock::now();
-                auto const duration = ((end - start).count()) / 1000000000.0;
+                auto const loadTime = ((end - pending->start).count()) / 1000000000.0;
 
                 LOG(log_.info()) << "Load phase of ETL. Successfully wrote ledger! Ledger info: "
-                                 << util::toString(lgrInfo) << ". txn count = " << numTxns
-                                 << ". object count = " << numObjects << ". load time = " << duration
-                                 << ". load txns per second = " << numTxns / duration
-                                 << ". load objs per second = " << numObjects / duration;
+                                 << util::toString(lgrInfo) << ". txn count = " << pending->numTxns
+                                 << ". object count = " << pending->numObjects << ". load time = " << loadTime
+                                 << ". load txns per second = " << pending->numTxns / loadTime
+                                 << ". load objs per second = " << pending->numObjects / loadTime;
 
-                // success is false if the ledger was already written
                 publisher_.get().publish(lgrInfo);
             } else {
                 LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
+                failed = true;
+                setWriteConflict(true);
             }
-
-            setWriteConflict(not success);
         }
     }
 
     /**
-     * @brief Build the next ledger using the previous ledger and the extracted data.
+     * @brief Build the next ledger using the previous ledger and the extracted data and issue its writes.
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
      *
+     * The ledger is committed separately, once its writes are finished.
+     *
      * @param rawData Data extracted from an ETL source
-     * @return The newly built ledger and data to write to the database
+     * @return The newly built ledger; an empty optional if it could not be built
      */
-    std::pair<ripple::LedgerHeader, bool>
+    std::optional<ripple::LedgerHeader>
     buildNextLedger(GetLedgerResponseType& rawData)
     {
         LOG(log_.debug()) << "Beginning ledger update";
@@ -204,7 +262,8 @@ private:
             LOG(log_.fatal()) << "Failed to build next ledger: " << e.what();
 
             amendmentBlockHandler_.get().onAmendmentBlock();
-            return {ripple::LedgerHeader{}, false};
+            LOG(log_.error()) << "Error writing ledger. " << util::toString(lgrInfo);
+            return std::nullopt;
         }
 
         LOG(log_.debug()) << "Inserted all transactions. Number of transactions  = "
@@ -214,13 +273,8 @@ private:
         backend_->writeNFTs(insertTxResultOp->nfTokensData);
         backend_->writeNFTTransactions(insertTxResultOp->nfTokenTxData);
 
-        auto [success, duration] =
-            ::util::timed<std::chrono::duration<double>>([&]() { return backend_->finishWrites(lgrInfo.seq); });
-
-        LOG(log_.debug()) << "Finished writes. Total time: " << std::to_string(duration);
-        LOG(log_.debug()) << "Finished ledger update: " << ::util::toString(lgrInfo);
-
-        return {lgrInfo, success};
+        LOG(log_.debug()) << "Issued all writes of ledger update: " << ::util::toString(lgrInfo);
+        return lgrInfo;
     }
 
     /**
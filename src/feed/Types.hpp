@@ -20,6 +20,7 @@
 #pragma once
 
 #include "web/interface/ConnectionBase.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <memory>
 
@@ -27,5 +28,6 @@ namespace feed {
 using Subscriber = web::ConnectionBase;
 using SubscriberPtr = Subscriber*;
 using SubscriberSharedPtr = std::shared_ptr<Subscriber>;
+using MessagePtr = std::shared_ptr<web::SubscriptionMessage const>;
 
 }  // namespace feed
@@ -24,6 +24,7 @@
 #include "feed/impl/SingleFeedBase.hpp"
 #include "rpc/RPCHelpers.hpp"
 #include "util/Assert.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
@@ -96,6 +97,9 @@ LedgerFeed::pub(
     std::uint32_t const txnCount
 ) const
 {
-    SingleFeedBase::pub(boost::json::serialize(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)));
+    SingleFeedBase::pub(
+        boost::json::serialize(makeLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)),
+        web::SubscriptionMessage::Kind::Ledger
+    );
 }
 }  // namespace feed::impl
@@ -22,6 +22,7 @@
 #include "feed/Types.hpp"
 #include "rpc/RPCHelpers.hpp"
 #include "util/log/Logger.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/json/object.hpp>
 #include <boost/json/serialize.hpp>
@@ -39,7 +40,7 @@ void
 ProposedTransactionFeed::sub(SubscriberSharedPtr const& subscriber)
 {
     auto const weakPtr = std::weak_ptr(subscriber);
-    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](std::shared_ptr<std::string> const& msg) {
+    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](MessagePtr const& msg) {
         if (auto connectionPtr = weakPtr.lock()) {
             connectionPtr->send(msg);
         }
@@ -59,7 +60,7 @@ ProposedTransactionFeed::sub(ripple::AccountID const& account, SubscriberSharedP
     auto const added = accountSignal_.connectTrackableSlot(
         subscriber,
         account,
-        [this, weakPtr](std::shared_ptr<std::string> const& msg) {
+        [this, weakPtr](MessagePtr const& msg) {
             if (auto connectionPtr = weakPtr.lock()) {
                 // Check if this connection already sent
                 if (notified_.contains(connectionPtr.get()))
@@ -94,7 +95,7 @@ ProposedTransactionFeed::unsub(ripple::AccountID const& account, SubscriberShare
 void
 ProposedTransactionFeed::pub(boost::json::object const& receivedTxJson)
 {
-    auto pubMsg = std::make_shared<std::string>(boost::json::serialize(receivedTxJson));
+    auto pubMsg = std::make_shared<web::SubscriptionMessage const>(boost::json::serialize(receivedTxJson));
 
     auto const transaction = receivedTxJson.at("transaction").as_object();
     auto const accounts = rpc::getAccountsFromTransaction(transaction);
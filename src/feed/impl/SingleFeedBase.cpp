@@ -24,6 +24,7 @@
 #include "feed/impl/Util.hpp"
 #include "util/async/AnyExecutionContext.hpp"
 #include "util/log/Logger.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <cstdint>
 #include <memory>
@@ -41,7 +42,7 @@ void
 SingleFeedBase::sub(SubscriberSharedPtr const& subscriber)
 {
     auto const weakPtr = std::weak_ptr(subscriber);
-    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](std::shared_ptr<std::string> const& msg) {
+    auto const added = signal_.connectTrackableSlot(subscriber, [weakPtr](MessagePtr const& msg) {
         if (auto connectionPtr = weakPtr.lock())
             connectionPtr->send(msg);
     });
@@ -62,10 +63,10 @@ SingleFeedBase::unsub(SubscriberSharedPtr const& subscriber)
 }
 
 void
-SingleFeedBase::pub(std::string msg) const
+SingleFeedBase::pub(std::string msg, web::SubscriptionMessage::Kind kind) const
 {
-    [[maybe_unused]] auto task = strand_.execute([this, msg = std::move(msg)]() {
-        auto const msgPtr = std::make_shared<std::string>(msg);
+    [[maybe_unused]] auto task = strand_.execute([this, msg = std::move(msg), kind]() {
+        auto const msgPtr = std::make_shared<web::SubscriptionMessage const>(msg, kind);
         signal_.emit(msgPtr);
     });
 }
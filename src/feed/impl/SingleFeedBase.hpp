@@ -25,6 +25,7 @@
 #include "util/async/AnyStrand.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Gauge.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/strand.hpp>
@@ -42,7 +43,7 @@ namespace feed::impl {
 class SingleFeedBase {
     util::async::AnyStrand strand_;
     std::reference_wrapper<util::prometheus::GaugeInt> subCount_;
-    TrackableSignal<Subscriber, std::shared_ptr<std::string> const&> signal_;
+    TrackableSignal<Subscriber, MessagePtr const&> signal_;
     util::Logger logger_{"Subscriptions"};
     std::string name_;
 
@@ -71,9 +72,10 @@ public:
     /**
      * @brief Publishes the feed in strand.
      * @param msg The message.
+     * @param kind The kind of the message.
      */
     void
-    pub(std::string msg) const;
+    pub(std::string msg, web::SubscriptionMessage::Kind kind = web::SubscriptionMessage::Kind::Other) const;
 
     /**
      * @brief Get the count of subscribers.
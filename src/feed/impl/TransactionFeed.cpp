@@ -25,6 +25,7 @@
 #include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
 #include "util/log/Logger.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
@@ -233,8 +234,8 @@ TransactionFeed::pub(
     };
 
     AllVersionTransactionsType allVersionsMsgs{
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(1u))),
-        std::make_shared<std::string>(boost::json::serialize(genJsonByVersion(2u)))
+        std::make_shared<web::SubscriptionMessage const>(boost::json::serialize(genJsonByVersion(1u))),
+        std::make_shared<web::SubscriptionMessage const>(boost::json::serialize(genJsonByVersion(2u)))
     };
 
     auto const affectedAccountsFlat = meta->getAffectedAccounts();
@@ -48,7 +48,7 @@ namespace feed::impl {
 
 class TransactionFeed {
     // Hold two versions of transaction messages
-    using AllVersionTransactionsType = std::array<std::shared_ptr<std::string>, 2>;
+    using AllVersionTransactionsType = std::array<MessagePtr, 2>;
 
     struct TransactionSlot {
         std::reference_wrapper<TransactionFeed> feed;
@@ -44,13 +44,17 @@ try {
             }
             util::LogService::init(config);
             app::ClioApplication clio{config};
-            return clio.run();
+            auto const exitCode = clio.run();
+            util::LogService::flush();
+            return exitCode;
         }
     );
 } catch (std::exception const& e) {
     LOG(util::LogService::fatal()) << "Exit on exception: " << e.what();
+    util::LogService::flush();
     return EXIT_FAILURE;
 } catch (...) {
     LOG(util::LogService::fatal()) << "Exit on exception: unknown";
+    util::LogService::flush();
     return EXIT_FAILURE;
 }
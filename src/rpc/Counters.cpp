@@ -28,17 +28,44 @@
 #include <fmt/core.h>
 #include <xrpl/protocol/jss.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace rpc {
 
 using util::prometheus::Label;
 using util::prometheus::Labels;
 
+namespace {
+
+// microseconds, from fast cached responses up to requests that run into timeouts
+std::vector<std::int64_t> const DURATION_BUCKETS{
+    100, 250, 500, 1'000, 2'500, 5'000, 10'000, 25'000, 50'000, 100'000, 250'000, 500'000, 1'000'000, 2'500'000,
+    5'000'000, 10'000'000
+};
+
+std::atomic_uint64_t nextCountersId{1};
+
+util::prometheus::HistogramInt&
+makeDurationHistogram(std::string const& method, std::string const& stage, std::string const& description)
+{
+    return PrometheusService::histogramInt(
+        "rpc_method_duration_microseconds_histogram",
+        Labels({Label{"method", method}, Label{"stage", stage}}),
+        DURATION_BUCKETS,
+        fmt::format("{} of calls to the method {}", description, method)
+    );
+}
+
+}  // namespace
+
 Counters::MethodInfo::MethodInfo(std::string const& method)
     : started(PrometheusService::counterInt(
           "rpc_method_total_number",
@@ -75,21 +102,41 @@ Counters::MethodInfo::MethodInfo(std::string const& method)
           Labels({util::prometheus::Label{"method", method}}),
           fmt::format("Total duration of calls to the method {}", method)
       ))
+    , queueWait(makeDurationHistogram(method, "queue", "The time spent in the work queue"))
+    , execution(makeDurationHistogram(method, "execution", "The execution time"))
+    , serialization(makeDurationHistogram(method, "serialization", "The response serialization time"))
 {
 }
 
 Counters::MethodInfo&
 Counters::getMethodInfo(std::string const& method)
 {
+    struct Cache {
+        std::uint64_t owner = 0;
+        std::unordered_map<std::string, MethodInfo*> methods;
+    };
+    thread_local Cache cache;
+
+    if (cache.owner != id_) {
+        cache.methods.clear();
+        cache.owner = id_;
+    }
+
+    if (auto const it = cache.methods.find(method); it != cache.methods.end())
+        return *it->second;
+
+    std::scoped_lock const lk(mutex_);
     auto it = methodInfo_.find(method);
     if (it == methodInfo_.end()) {
         it = methodInfo_.emplace(method, MethodInfo(method)).first;
     }
+    cache.methods.emplace(method, &it->second);
     return it->second;
 }
 
 Counters::Counters(WorkQueue const& wq)
-    : tooBusyCounter_(PrometheusService::counterInt(
+    : id_(nextCountersId++)
+    , tooBusyCounter_(PrometheusService::counterInt(
           "rpc_error_total_number",
           Labels({Label{"error_type", "too_busy"}}),
           "Total number of too busy errors"
@@ -114,6 +161,31 @@ Counters::Counters(WorkQueue const& wq)
           Labels({Label{"error_type", "internal_error"}}),
           "Total number of internal errors"
       ))
+    , singleFlightHitCounter_(PrometheusService::counterInt(
+          "rpc_single_flight_total_number",
+          Labels({Label{"result", "hit"}}),
+          "Total number of requests answered with the response of an identical in-flight request"
+      ))
+    , singleFlightMissCounter_(PrometheusService::counterInt(
+          "rpc_single_flight_total_number",
+          Labels({Label{"result", "miss"}}),
+          "Total number of coalescable requests that executed their handler"
+      ))
+    , singleFlightCoalescedCounter_(PrometheusService::counterInt(
+          "rpc_single_flight_total_number",
+          Labels({Label{"result", "coalesced"}}),
+          "Total number of executed requests whose response was shared with identical requests"
+      ))
+    , responseCacheHitCounter_(PrometheusService::counterInt(
+          "rpc_response_cache_total_number",
+          Labels({Label{"result", "hit"}}),
+          "Total number of requests answered from the ledger response cache"
+      ))
+    , responseCacheMissCounter_(PrometheusService::counterInt(
+          "rpc_response_cache_total_number",
+          Labels({Label{"result", "miss"}}),
+          "Total number of cacheable requests not found in the ledger response cache"
+      ))
     , workQueue_(std::cref(wq))
     , startupTime_{std::chrono::system_clock::now()}
 {
@@ -122,7 +194,6 @@ Counters::Counters(WorkQueue const& wq)
 void
 Counters::rpcFailed(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.failed.get();
@@ -131,7 +202,6 @@ Counters::rpcFailed(std::string const& method)
 void
 Counters::rpcErrored(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.errored.get();
@@ -140,17 +210,28 @@ Counters::rpcErrored(std::string const& method)
 void
 Counters::rpcComplete(std::string const& method, std::chrono::microseconds const& rpcDuration)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.started.get();
     ++counters.finished.get();
     counters.duration.get() += rpcDuration.count();
+    counters.execution.get().observe(rpcDuration.count());
+}
+
+void
+Counters::rpcQueued(std::string const& method, std::chrono::microseconds const& wait)
+{
+    getMethodInfo(method).queueWait.get().observe(wait.count());
+}
+
+void
+Counters::rpcSerialized(std::string const& method, std::chrono::microseconds const& duration)
+{
+    getMethodInfo(method).serialization.get().observe(duration.count());
 }
 
 void
 Counters::rpcForwarded(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.forwarded.get();
 }
@@ -158,7 +239,6 @@ Counters::rpcForwarded(std::string const& method)
 void
 Counters::rpcFailedToForward(std::string const& method)
 {
-    std::scoped_lock const lk(mutex_);
     MethodInfo const& counters = getMethodInfo(method);
     ++counters.failedForward.get();
 }
@@ -193,6 +273,36 @@ Counters::onInternalError()
     ++internalErrorCounter_.get();
 }
 
+void
+Counters::onSingleFlightHit()
+{
+    ++singleFlightHitCounter_.get();
+}
+
+void
+Counters::onSingleFlightMiss()
+{
+    ++singleFlightMissCounter_.get();
+}
+
+void
+Counters::onSingleFlightCoalesced()
+{
+    ++singleFlightCoalescedCounter_.get();
+}
+
+void
+Counters::onResponseCacheHit()
+{
+    ++responseCacheHitCounter_.get();
+}
+
+void
+Counters::onResponseCacheMiss()
+{
+    ++responseCacheMissCounter_.get();
+}
+
 std::chrono::seconds
 Counters::uptime() const
 {
@@ -226,6 +336,11 @@ Counters::report() const
     obj["bad_syntax_errors"] = std::to_string(badSyntaxCounter_.get().value());
     obj["unknown_command_errors"] = std::to_string(unknownCommandCounter_.get().value());
     obj["internal_errors"] = std::to_string(internalErrorCounter_.get().value());
+    obj["single_flight_hits"] = std::to_string(singleFlightHitCounter_.get().value());
+    obj["single_flight_misses"] = std::to_string(singleFlightMissCounter_.get().value());
+    obj["single_flight_coalesced"] = std::to_string(singleFlightCoalescedCounter_.get().value());
+    obj["response_cache_hits"] = std::to_string(responseCacheHitCounter_.get().value());
+    obj["response_cache_misses"] = std::to_string(responseCacheMissCounter_.get().value());
 
     obj["work_queue"] = workQueue_.get().report();
 
@@ -21,11 +21,13 @@
 
 #include "rpc/WorkQueue.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <string>
@@ -35,9 +37,13 @@ namespace rpc {
 
 /**
  * @brief Holds information about successful, failed, forwarded, etc. RPC handler calls.
+ *
+ * Besides the totals, the latency of every method is recorded in histograms split into the time spent waiting in the
+ * work queue, executing the handler and serializing the response.
  */
 class Counters {
     using CounterType = std::reference_wrapper<util::prometheus::CounterInt>;
+    using HistogramType = std::reference_wrapper<util::prometheus::HistogramInt>;
     /**
      * @brief All counters the system keeps track of for each RPC method.
      */
@@ -51,13 +57,24 @@ class Counters {
         CounterType forwarded;
         CounterType failedForward;
         CounterType duration;
+        HistogramType queueWait;
+        HistogramType execution;
+        HistogramType serialization;
     };
 
+    /**
+     * @brief Find or create the counters of a method.
+     *
+     * Every thread caches the methods it has seen, so the mutex is only taken the first time a thread records a call
+     * to a method. The cached pointers stay valid because elements of the map are never moved or erased.
+     */
     MethodInfo&
     getMethodInfo(std::string const& method);
 
+    // guards insertion into methodInfo_; recording calls goes through the per-thread cache instead
     mutable std::mutex mutex_;
     std::unordered_map<std::string, MethodInfo> methodInfo_;
+    std::uint64_t id_; /**< Tells the per-thread caches of different instances apart */
 
     // counters that don't carry RPC method information
     CounterType tooBusyCounter_;
@@ -65,6 +82,11 @@ class Counters {
     CounterType badSyntaxCounter_;
     CounterType unknownCommandCounter_;
     CounterType internalErrorCounter_;
+    CounterType singleFlightHitCounter_;
+    CounterType singleFlightMissCounter_;
+    CounterType singleFlightCoalescedCounter_;
+    CounterType responseCacheHitCounter_;
+    CounterType responseCacheMissCounter_;
 
     std::reference_wrapper<WorkQueue const> workQueue_;
     std::chrono::time_point<std::chrono::system_clock> startupTime_;
@@ -114,6 +136,24 @@ public:
     void
     rpcComplete(std::string const& method, std::chrono::microseconds const& rpcDuration);
 
+    /**
+     * @brief Records how long a call to a particular RPC method waited in the work queue.
+     *
+     * @param method The method to record the wait for
+     * @param wait The time between scheduling the call and starting it
+     */
+    void
+    rpcQueued(std::string const& method, std::chrono::microseconds const& wait);
+
+    /**
+     * @brief Records how long it took to build and serialize the response of a particular RPC method.
+     *
+     * @param method The method to record the duration for
+     * @param duration The time spent turning the handler result into the response sent to the client
+     */
+    void
+    rpcSerialized(std::string const& method, std::chrono::microseconds const& duration);
+
     /**
      * @brief Increments the forwarded count for a particular RPC method.
      *
@@ -150,6 +190,26 @@ public:
     void
     onInternalError();
 
+    /** @brief Increments the counter of requests answered with the response of an identical in-flight request. */
+    void
+    onSingleFlightHit();
+
+    /** @brief Increments the counter of coalescable requests that executed their handler. */
+    void
+    onSingleFlightMiss();
+
+    /** @brief Increments the counter of executed requests whose response was shared with identical requests. */
+    void
+    onSingleFlightCoalesced();
+
+    /** @brief Increments the counter of requests answered from the ledger response cache. */
+    void
+    onResponseCacheHit();
+
+    /** @brief Increments the counter of cacheable requests that were not found in the ledger response cache. */
+    void
+    onResponseCacheMiss();
+
     /** @return Uptime of this instance in seconds. */
     std::chrono::seconds
     uptime() const;
@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/LedgerResponseCache.hpp"
+
+#include "rpc/common/Types.hpp"
+#include "util/Mutex.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/kind.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/value.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rpc {
+
+namespace {
+
+// a rough average length of serialized numbers; the estimate only has to be in the right ballpark
+constexpr std::size_t NUMBER_SIZE = 10;
+
+std::size_t
+estimateValueSize(std::vector<boost::json::value const*> pending, std::size_t limit)
+{
+    std::size_t size = 0;
+    while (not pending.empty() and size <= limit) {
+        auto const& value = *pending.back();
+        pending.pop_back();
+
+        switch (value.kind()) {
+            case boost::json::kind::object:
+                size += 2;
+                for (auto const& [key, member] : value.get_object()) {
+                    if (size > limit)
+                        break;
+                    size += key.size() + 4;  // quotes, colon and comma
+                    pending.push_back(&member);
+                }
+                break;
+            case boost::json::kind::array:
+                size += 2;
+                for (auto const& element : value.get_array()) {
+                    if (size > limit)
+                        break;
+                    size += 1;
+                    pending.push_back(&element);
+                }
+                break;
+            case boost::json::kind::string:
+                size += value.get_string().size() + 2;
+                break;
+            case boost::json::kind::null:
+            case boost::json::kind::bool_:
+                size += 5;
+                break;
+            default:
+                size += NUMBER_SIZE;
+                break;
+        }
+    }
+
+    return size;
+}
+
+}  // namespace
+
+LedgerResponseCache::LedgerResponseCache(std::size_t maxSize, std::size_t numShards)
+    : shardMaxSize_(maxSize / std::max<std::size_t>(numShards, 1)), shards_(std::max<std::size_t>(numShards, 1))
+{
+}
+
+std::shared_ptr<ReturnType const>
+LedgerResponseCache::get(std::string const& key, std::uint32_t latestSequence)
+{
+    auto state = shardOf(key).lock();
+    advance(*state, observe(latestSequence));
+
+    auto const it = state->entries.find(key);
+    if (it == state->entries.end())
+        return nullptr;
+
+    state->recentlyUsed.splice(state->recentlyUsed.begin(), state->recentlyUsed, it->second.position);
+    return it->second.response;
+}
+
+void
+LedgerResponseCache::put(
+    std::string const& key,
+    std::shared_ptr<ReturnType const> const& response,
+    bool latest,
+    std::uint32_t latestSequence
+)
+{
+    if (response == nullptr or not *response)
+        return;
+
+    auto const size = estimateSize(*response, shardMaxSize_ - std::min(key.size(), shardMaxSize_)) + key.size();
+    if (size > shardMaxSize_)
+        return;
+
+    auto state = shardOf(key).lock();
+    advance(*state, observe(latestSequence));
+
+    // a newer ledger arrived while the request was executed, so its response is already outdated
+    if (latest and latestSequence < state->latestSequence)
+        return;
+
+    if (auto const it = state->entries.find(key); it != state->entries.end())
+        erase(*state, it);
+
+    while (state->size + size > shardMaxSize_)
+        erase(*state, state->entries.find(state->recentlyUsed.back()));
+
+    state->recentlyUsed.push_front(key);
+    state->entries.emplace(key, Entry{response, size, latest, state->recentlyUsed.begin()});
+    state->size += size;
+
+    if (latest)
+        state->latestKeys.push_back(key);
+}
+
+std::size_t
+LedgerResponseCache::size() const
+{
+    std::size_t size = 0;
+    for (auto const& shard : shards_)
+        size += shard.lock()->size;
+
+    return size;
+}
+
+std::size_t
+LedgerResponseCache::estimateSize(ReturnType const& response, std::size_t limit)
+{
+    if (not response)
+        return 0;
+
+    std::vector<boost::json::value const*> pending{&*response.result};
+    for (auto const& warning : response.warnings)
+        pending.push_back(&warning);
+
+    return estimateValueSize(std::move(pending), limit) + 2;
+}
+
+std::uint32_t
+LedgerResponseCache::observe(std::uint32_t latestSequence)
+{
+    auto current = latestSequence_.load(std::memory_order_relaxed);
+    while (current < latestSequence and
+           not latestSequence_.compare_exchange_weak(current, latestSequence, std::memory_order_relaxed)) {
+    }
+    return std::max(current, latestSequence);
+}
+
+util::Mutex<LedgerResponseCache::State>&
+LedgerResponseCache::shardOf(std::string const& key)
+{
+    return shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+void
+LedgerResponseCache::advance(State& state, std::uint32_t latestSequence)
+{
+    if (latestSequence <= state.latestSequence)
+        return;
+
+    state.latestSequence = latestSequence;
+    for (auto const& key : state.latestKeys) {
+        if (auto const it = state.entries.find(key); it != state.entries.end() and it->second.latest)
+            erase(state, it);
+    }
+    state.latestKeys.clear();
+}
+
+void
+LedgerResponseCache::erase(State& state, std::unordered_map<std::string, Entry>::iterator it)
+{
+    state.size -= it->second.size;
+    state.recentlyUsed.erase(it->second.position);
+    state.entries.erase(it);
+}
+
+}  // namespace rpc
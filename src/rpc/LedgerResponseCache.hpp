@@ -0,0 +1,134 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "rpc/common/Types.hpp"
+#include "util/Mutex.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rpc {
+
+/**
+ * @brief Cache of successful responses keyed by the full request and the ledger it was executed against.
+ *
+ * Responses for a ledger given by sequence or hash never change, so they stay in the cache until they are evicted by
+ * the least recently used policy once the cache exceeds its size. Responses for the latest ledger ("validated",
+ * "current", "closed" or no ledger at all) are only valid until a new ledger is available and are dropped as soon as a
+ * request sees a newer latest ledger sequence.
+ *
+ * Entries are spread over shards by the hash of their key, each with its own lock and an equal part of the size. The
+ * cached responses are immutable and shared with the requests they are returned to.
+ */
+class LedgerResponseCache {
+    struct Entry {
+        std::shared_ptr<ReturnType const> response;
+        std::size_t size;
+        bool latest;
+        std::list<std::string>::iterator position;
+    };
+
+    struct State {
+        std::unordered_map<std::string, Entry> entries;
+        std::list<std::string> recentlyUsed;  // most recently used first
+        std::vector<std::string> latestKeys;
+        std::size_t size = 0;
+        std::uint32_t latestSequence = 0;
+    };
+
+    std::size_t shardMaxSize_;
+    std::atomic_uint32_t latestSequence_ = 0;
+    std::vector<util::Mutex<State>> shards_;
+
+public:
+    static constexpr std::size_t DEFAULT_NUM_SHARDS = 16;
+
+    /**
+     * @brief Construct a new cache
+     *
+     * @param maxSize The maximum size of all cached responses in bytes
+     * @param numShards The number of shards; a response larger than the size of one shard is not cached
+     */
+    explicit LedgerResponseCache(std::size_t maxSize, std::size_t numShards = DEFAULT_NUM_SHARDS);
+
+    /**
+     * @brief Get a cached response
+     *
+     * @param key The key of the request
+     * @param latestSequence The latest ledger sequence available when the request arrived
+     * @return The response if it is cached; nullptr otherwise
+     */
+    [[nodiscard]] std::shared_ptr<ReturnType const>
+    get(std::string const& key, std::uint32_t latestSequence);
+
+    /**
+     * @brief Put a successful response into the cache
+     *
+     * @param key The key of the request
+     * @param response The response to store; responses carrying an error are not cached
+     * @param latest Whether the request was for the latest ledger
+     * @param latestSequence The latest ledger sequence available when the request arrived
+     */
+    void
+    put(std::string const& key,
+        std::shared_ptr<ReturnType const> const& response,
+        bool latest,
+        std::uint32_t latestSequence);
+
+    /**
+     * @brief Get the size of all cached responses
+     *
+     * @return The size in bytes
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @brief Estimate the size of a response once serialized without serializing it
+     *
+     * @param response The response to estimate the size of
+     * @param limit The size above which estimating stops
+     * @return The estimated size in bytes; a value larger than limit if the response is larger than limit
+     */
+    [[nodiscard]] static std::size_t
+    estimateSize(ReturnType const& response, std::size_t limit);
+
+private:
+    std::uint32_t
+    observe(std::uint32_t latestSequence);
+
+    util::Mutex<State>&
+    shardOf(std::string const& key);
+
+    static void
+    advance(State& state, std::uint32_t latestSequence);
+
+    static void
+    erase(State& state, std::unordered_map<std::string, Entry>::iterator it);
+};
+
+}  // namespace rpc
@@ -21,24 +21,33 @@
 
 #include "data/BackendInterface.hpp"
 #include "rpc/Errors.hpp"
+#include "rpc/LedgerResponseCache.hpp"
 #include "rpc/RPCHelpers.hpp"
 #include "rpc/WorkQueue.hpp"
 #include "rpc/common/HandlerProvider.hpp"
 #include "rpc/common/Types.hpp"
 #include "rpc/common/impl/ForwardingProxy.hpp"
+#include "util/JsonUtils.hpp"
 #include "util/ResponseExpirationCache.hpp"
+#include "util/SingleFlight.hpp"
 #include "util/log/Logger.hpp"
 #include "web/Context.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/json.hpp>
 #include <fmt/core.h>
 #include <fmt/format.h>
 #include <xrpl/protocol/ErrorCodes.h>
+#include <xrpl/protocol/jss.h>
 
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -61,7 +70,7 @@ class RPCEngine {
     util::Logger log_{"RPC"};
 
     std::shared_ptr<BackendInterface> backend_;
-    std::reference_wrapper<web::dosguard::DOSGuardInterface const> dosGuard_;
+    std::reference_wrapper<web::dosguard::DOSGuardInterface> dosGuard_;
     std::reference_wrapper<WorkQueue> workQueue_;
     std::reference_wrapper<CountersType> counters_;
 
@@ -70,6 +79,32 @@ class RPCEngine {
     impl::ForwardingProxy<LoadBalancerType, CountersType, HandlerProvider> forwardingProxy_;
 
     std::optional<util::ResponseExpirationCache> responseCache_;
+    std::optional<LedgerResponseCache> ledgerResponseCache_;
+    std::optional<util::SingleFlight<ReturnType>> singleFlight_;
+
+    // methods whose response only depends on the parameters and the ledger they are executed against
+    static inline std::unordered_set<std::string> const LEDGER_BOUND_METHODS{
+        "account_channels",
+        "account_currencies",
+        "account_info",
+        "account_lines",
+        "account_nfts",
+        "account_objects",
+        "account_offers",
+        "amm_info",
+        "book_changes",
+        "book_offers",
+        "deposit_authorized",
+        "gateway_balances",
+        "ledger",
+        "ledger_data",
+        "ledger_entry",
+        "nft_buy_offers",
+        "nft_info",
+        "nft_sell_offers",
+        "noripple_check",
+        "transaction_entry",
+    };
 
 public:
     /**
@@ -87,13 +122,13 @@ public:
         util::Config const& config,
         std::shared_ptr<BackendInterface> const& backend,
         std::shared_ptr<LoadBalancerType> const& balancer,
-        web::dosguard::DOSGuardInterface const& dosGuard,
+        web::dosguard::DOSGuardInterface& dosGuard,
         WorkQueue& workQueue,
         CountersType& counters,
         std::shared_ptr<HandlerProvider const> const& handlerProvider
     )
         : backend_{backend}
-        , dosGuard_{std::cref(dosGuard)}
+        , dosGuard_{std::ref(dosGuard)}
         , workQueue_{std::ref(workQueue)}
         , counters_{std::ref(counters)}
         , handlerProvider_{handlerProvider}
@@ -109,6 +144,16 @@ public:
                 util::Config::toMilliseconds(cacheTimeout), std::unordered_set<std::string>{"server_info"}
             );
         }
+
+        if (auto const cacheSize = config.valueOr<std::size_t>("rpc.ledger_response_cache_size_mb", 0); cacheSize > 0) {
+            LOG(log_.info()) << "Init RPC ledger response cache, size: " << cacheSize << " MB";
+            ledgerResponseCache_.emplace(cacheSize * 1024 * 1024);
+        }
+
+        if (config.valueOr("rpc.single_flight", false)) {
+            LOG(log_.info()) << "Coalescing identical in-flight RPC requests";
+            singleFlight_.emplace();
+        }
     }
 
     /**
@@ -128,7 +173,7 @@ public:
         util::Config const& config,
         std::shared_ptr<BackendInterface> const& backend,
         std::shared_ptr<LoadBalancerType> const& balancer,
-        web::dosguard::DOSGuardInterface const& dosGuard,
+        web::dosguard::DOSGuardInterface& dosGuard,
         WorkQueue& workQueue,
         CountersType& counters,
         std::shared_ptr<HandlerProvider const> const& handlerProvider
@@ -159,6 +204,15 @@ public:
                 return Result{std::move(res).value()};
         }
 
+        auto const key = requestKey(ctx);
+        if (key.has_value() and ledgerResponseCache_) {
+            if (auto res = ledgerResponseCache_->get(key->value, ctx.range.maxSequence); res != nullptr) {
+                counters_.get().onResponseCacheHit();
+                return Result{std::move(res)};
+            }
+            counters_.get().onResponseCacheMiss();
+        }
+
         if (backend_->isTooBusy()) {
             LOG(log_.error()) << "Database is too busy. Rejecting request";
             notifyTooBusy();  // TODO: should we add ctx.method if we have it?
@@ -171,18 +225,38 @@ public:
             return Result{Status{RippledError::rpcUNKNOWN_COMMAND}};
         }
 
+        // cached responses above are cheap, only executed methods are charged
+        if (not dosGuard_.get().requestMethod(ctx.clientIp, ctx.method))
+            return Result{Status{RippledError::rpcSLOW_DOWN}};
+
         try {
             LOG(perfLog_.debug()) << ctx.tag() << " start executing rpc `" << ctx.method << '`';
 
             auto const context = Context{ctx.yield, ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
-            auto v = (*method).process(ctx.params, context);
+            auto v = [&]() {
+                if (not key.has_value() or not singleFlight_)
+                    return (*method).process(ctx.params, context);
+
+                auto [result, outcome] = singleFlight_->execute(ctx.yield, key->value, [&]() {
+                    return (*method).process(ctx.params, context);
+                });
+                notifySingleFlight(outcome);
+                return std::move(result);
+            }();
 
             LOG(perfLog_.debug()) << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
 
             if (not v) {
                 notifyErrored(ctx.method);
-            } else if (not ctx.isAdmin and responseCache_) {
-                responseCache_->put(ctx.method, v.result->as_object());
+            } else {
+                if (not ctx.isAdmin and responseCache_)
+                    responseCache_->put(ctx.method, v.result->as_object());
+
+                if (key.has_value() and ledgerResponseCache_ and readKeyLedger(*key, v, ctx.range.maxSequence)) {
+                    auto shared = std::make_shared<ReturnType const>(std::move(v));
+                    ledgerResponseCache_->put(key->value, shared, key->latest, ctx.range.maxSequence);
+                    return Result{std::move(shared)};
+                }
             }
 
             return Result{std::move(v)};
@@ -192,6 +266,14 @@ public:
 
             return Result{Status{RippledError::rpcTOO_BUSY}};
         } catch (std::exception const& ex) {
+            // operations of a request that passed its deadline fail with operation_aborted, that is not an error
+            if (ctx.yield.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none) {
+                LOG(perfLog_.warn()) << ctx.tag() << "Request cancelled after its deadline: " << ex.what();
+                notifyTooBusy();
+
+                return Result{Status{RippledError::rpcTOO_BUSY}};
+            }
+
             LOG(log_.error()) << ctx.tag() << "Caught exception: " << ex.what();
             notifyInternalError();
 
@@ -205,13 +287,61 @@ public:
      * @tparam FnType The type of function
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param method The method of the request
+     * @param isAdmin Whether the request comes from an admin
      * @return true if the request was successfully scheduled; false otherwise
      */
     template <typename FnType>
     bool
-    post(FnType&& func, std::string const& ip)
+    post(FnType&& func, std::string const& ip, std::string const& method, bool isAdmin)
     {
-        return workQueue_.get().postCoro(std::forward<FnType>(func), dosGuard_.get().isWhiteListed(ip));
+        auto const priority = [&] {
+            if (isAdmin)
+                return WorkQueue::Priority::Admin;
+            if (dosGuard_.get().isWhiteListed(ip))
+                return WorkQueue::Priority::WhiteListed;
+            if (dosGuard_.get().methodWeight(method) > 0)
+                return WorkQueue::Priority::Expensive;
+            return WorkQueue::Priority::Cheap;
+        }();
+
+        return workQueue_.get().postCoro(
+            [this, func = std::forward<FnType>(func), method, queued = std::chrono::steady_clock::now()](
+                boost::asio::yield_context yield
+            ) mutable {
+                auto const wait = std::chrono::steady_clock::now() - queued;
+                notifyQueued(method, std::chrono::duration_cast<std::chrono::microseconds>(wait));
+                func(yield);
+            },
+            priority,
+            method
+        );
+    }
+
+    /**
+     * @brief Notify the system how long a request for the specified method waited in the work queue.
+     *
+     * @param method
+     * @param wait The time between posting the request and starting to handle it
+     */
+    void
+    notifyQueued(std::string const& method, std::chrono::microseconds const& wait)
+    {
+        if (validHandler(method))
+            counters_.get().rpcQueued(method, wait);
+    }
+
+    /**
+     * @brief Notify the system how long it took to build and serialize the response for the specified method.
+     *
+     * @param method
+     * @param duration The time it took to turn the result into the response in microseconds
+     */
+    void
+    notifySerialized(std::string const& method, std::chrono::microseconds const& duration)
+    {
+        if (validHandler(method))
+            counters_.get().rpcSerialized(method, duration);
     }
 
     /**
@@ -304,6 +434,98 @@ public:
     }
 
 private:
+    void
+    notifySingleFlight(util::SingleFlightOutcome outcome)
+    {
+        switch (outcome) {
+            case util::SingleFlightOutcome::Executed:
+                counters_.get().onSingleFlightMiss();
+                break;
+            case util::SingleFlightOutcome::ExecutedAndShared:
+                counters_.get().onSingleFlightMiss();
+                counters_.get().onSingleFlightCoalesced();
+                break;
+            case util::SingleFlightOutcome::Shared:
+                counters_.get().onSingleFlightHit();
+                break;
+        }
+    }
+
+    /**
+     * @brief Identifies a request whose response only depends on its parameters and ledger.
+     */
+    struct RequestKey {
+        std::string value;
+        bool latest; /**< Whether the request reads the latest ledger */
+    };
+
+    /**
+     * @brief Build the key under which identical requests share a response.
+     *
+     * Fields that only matter to the transport are dropped. A request for the latest ledger ("validated", "current",
+     * "closed" or no ledger at all) is keyed by the latest ledger at the time it arrived, so it never shares a response
+     * with a request that arrived after a new ledger. Its response is only cached if the handler reported that ledger
+     * as the `ledger_index` of the result, see readKeyLedger.
+     *
+     * @param ctx The context of the request
+     * @return The key; nullopt if the response of the request must not be shared
+     */
+    std::optional<RequestKey>
+    requestKey(web::Context const& ctx) const
+    {
+        if ((not singleFlight_ and not ledgerResponseCache_) or not LEDGER_BOUND_METHODS.contains(ctx.method))
+            return std::nullopt;
+
+        auto params = ctx.params;
+        for (auto const* field : {"id", "command", "method", "api_version", "jsonrpc", "ripplerpc"})
+            params.erase(field);
+
+        auto const isShortcut = [](boost::json::string const& index) {
+            return index.empty() or not std::ranges::all_of(index, [](unsigned char c) { return std::isdigit(c); });
+        };
+
+        auto const* ledgerIndex = params.if_contains(JS(ledger_index));
+        auto const latest = not params.contains(JS(ledger_hash)) and
+            (ledgerIndex == nullptr or (ledgerIndex->is_string() and isShortcut(ledgerIndex->as_string())));
+
+        auto value =
+            fmt::format("{}:{}:{}:{}", ctx.method, ctx.apiVersion, ctx.isAdmin, util::serializeNormalized(params));
+        if (latest)
+            value += fmt::format("@{}", ctx.range.maxSequence);
+
+        return RequestKey{.value = std::move(value), .latest = latest};
+    }
+
+    /**
+     * @brief Check that a response was produced from the ledger its request key names.
+     *
+     * Handlers asked for the latest ledger look it up themselves, so they may read a newer ledger than the one the
+     * request was keyed by. Such a response is returned to the client but must not be stored under the older key.
+     *
+     * @param key The key of the request
+     * @param response The successful response of the handler
+     * @param latestSequence The latest ledger sequence available when the request arrived
+     * @return true if the response may be stored under the key; false otherwise
+     */
+    static bool
+    readKeyLedger(RequestKey const& key, ReturnType const& response, std::uint32_t latestSequence)
+    {
+        if (not key.latest)
+            return true;
+
+        if (not response.result->is_object())
+            return false;
+
+        auto const* ledgerIndex = response.result->as_object().if_contains(JS(ledger_index));
+        if (ledgerIndex == nullptr)
+            return false;
+
+        if (ledgerIndex->is_uint64())
+            return ledgerIndex->as_uint64() == latestSequence;
+
+        return ledgerIndex->is_int64() and ledgerIndex->as_int64() == latestSequence;
+    }
+
     bool
     validHandler(std::string const& method) const
     {
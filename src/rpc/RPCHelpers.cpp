@@ -25,6 +25,7 @@
 #include "rpc/JS.hpp"
 #include "rpc/common/Types.hpp"
 #include "util/AccountUtils.hpp"
+#include "util/Assert.hpp"
 #include "util/Profiler.hpp"
 #include "util/log/Logger.hpp"
 #include "web/Context.hpp"
@@ -241,9 +242,7 @@ deserializeTxPlusMeta(data::TransactionAndMetadata const& blobs, std::uint32_t s
 boost::json::object
 toJson(ripple::STBase const& obj)
 {
-    boost::json::value value = boost::json::parse(obj.getJson(ripple::JsonOptions::none).toStyledString());
-
-    return value.as_object();
+    return toBoostJson(obj.getJson(ripple::JsonOptions::none)).as_object();
 }
 
 std::pair<boost::json::object, boost::json::object>
@@ -328,23 +327,51 @@ insertDeliverMaxAlias(boost::json::object& txJson, std::uint32_t const apiVersio
 boost::json::object
 toJson(ripple::TxMeta const& meta)
 {
-    boost::json::value value = boost::json::parse(meta.getJson(ripple::JsonOptions::none).toStyledString());
-
-    return value.as_object();
+    return toBoostJson(meta.getJson(ripple::JsonOptions::none)).as_object();
 }
 
 boost::json::value
 toBoostJson(Json::Value const& value)
 {
-    boost::json::value boostValue = boost::json::parse(value.toStyledString());
-
-    return boostValue;
+    // builds the same value that parsing value.toStyledString() would give, without printing and parsing the text
+    switch (value.type()) {
+        case Json::nullValue:
+            return nullptr;
+        case Json::intValue:
+            return static_cast<std::int64_t>(value.asInt());
+        case Json::uintValue:
+            // a parser reads any integer that fits into int64 as signed
+            return static_cast<std::int64_t>(value.asUInt());
+        case Json::realValue:
+            // the styled writer prints doubles with %.16g which may turn them into integers; keep that behaviour
+            return boost::json::parse(fmt::format("{:.16g}", value.asDouble()));
+        case Json::stringValue:
+            return boost::json::string{value.asString()};
+        case Json::booleanValue:
+            return value.asBool();
+        case Json::arrayValue: {
+            boost::json::array array;
+            array.reserve(value.size());
+            for (auto const& item : value)
+                array.push_back(toBoostJson(item));
+            return array;
+        }
+        case Json::objectValue: {
+            boost::json::object object;
+            object.reserve(value.size());
+            for (auto it = value.begin(); it != value.end(); ++it)
+                object.emplace(it.memberName(), toBoostJson(*it));
+            return object;
+        }
+    }
+    ASSERT(false, "Unknown Json::Value type: {}", static_cast<int>(value.type()));
+    return nullptr;
 }
 
 boost::json::object
 toJson(ripple::SLE const& sle)
 {
-    boost::json::value value = boost::json::parse(sle.getJson(ripple::JsonOptions::none).toStyledString());
+    boost::json::value value = toBoostJson(sle.getJson(ripple::JsonOptions::none));
     if (sle.getType() == ripple::ltACCOUNT_ROOT) {
         if (sle.isFieldPresent(ripple::sfEmailHash)) {
             auto const& hash = sle.getFieldH128(ripple::sfEmailHash);
@@ -541,7 +568,7 @@ traverseNFTObjects(
     ripple::uint256 const currentPage = nextPage == beast::zero ? lastNFTPage.key : nextPage;
 
     // read the current page
-    auto page = backend.fetchLedgerObject(currentPage, sequence, yield);
+    auto page = backend.fetchLedgerObjectView(currentPage, sequence, yield);
 
     if (!page) {
         if (nextPage == beast::zero) {  // no nft objects in lastNFTPage
@@ -564,7 +591,7 @@ traverseNFTObjects(
         if (count == limit or nftPreviousPage == beast::zero)
             return AccountCursor{nftPreviousPage, count};
 
-        page = backend.fetchLedgerObject(nftPreviousPage, sequence, yield);
+        page = backend.fetchLedgerObjectView(nftPreviousPage, sequence, yield);
         pageSLE = ripple::SLE{ripple::SerialIter{page->data(), page->size()}, nftPreviousPage};
     }
 
@@ -655,7 +682,7 @@ traverseOwnedNodes(
     // If startAfter is not zero try jumping to that page using the hint
     if (hexMarker.isNonZero()) {
         auto const hintIndex = ripple::keylet::page(rootIndex, startHint);
-        auto hintDir = backend.fetchLedgerObject(hintIndex.key, sequence, yield);
+        auto hintDir = backend.fetchLedgerObjectView(hintIndex.key, sequence, yield);
 
         if (!hintDir)
             return Status(ripple::rpcINVALID_PARAMS, "Invalid marker.");
@@ -672,7 +699,7 @@ traverseOwnedNodes(
         currentIndex = hintIndex;
         bool found = false;
         for (;;) {
-            auto const ownerDir = backend.fetchLedgerObject(currentIndex.key, sequence, yield);
+            auto const ownerDir = backend.fetchLedgerObjectView(currentIndex.key, sequence, yield);
 
             if (!ownerDir)
                 return Status(ripple::rpcINVALID_PARAMS, "Owner directory not found.");
@@ -707,7 +734,7 @@ traverseOwnedNodes(
         }
     } else {
         for (;;) {
-            auto const ownerDir = backend.fetchLedgerObject(currentIndex.key, sequence, yield);
+            auto const ownerDir = backend.fetchLedgerObjectView(currentIndex.key, sequence, yield);
 
             if (!ownerDir)
                 break;
@@ -743,7 +770,7 @@ traverseOwnedNodes(
         keys.size()
     );
 
-    auto [objects, timeDiff] = util::timed([&]() { return backend.fetchLedgerObjects(keys, sequence, yield); });
+    auto [objects, timeDiff] = util::timed([&]() { return backend.fetchLedgerObjectViews(keys, sequence, yield); });
 
     LOG(gLog.debug()) << "Time loading owned entries: " << timeDiff << " milliseconds";
 
@@ -766,7 +793,7 @@ read(
     web::Context const& context
 )
 {
-    if (auto const blob = backend->fetchLedgerObject(keylet.key, lgrInfo.seq, context.yield); blob) {
+    if (auto const blob = backend->fetchLedgerObjectView(keylet.key, lgrInfo.seq, context.yield); blob) {
         return std::make_shared<ripple::SLE const>(ripple::SerialIter{blob->data(), blob->size()}, keylet.key);
     }
 
@@ -824,7 +851,7 @@ isGlobalFrozen(
         return false;
 
     auto key = ripple::keylet::account(issuer).key;
-    auto blob = backend.fetchLedgerObject(key, sequence, yield);
+    auto blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
     if (!blob)
         return false;
@@ -849,7 +876,7 @@ isFrozen(
         return false;
 
     auto key = ripple::keylet::account(issuer).key;
-    auto blob = backend.fetchLedgerObject(key, sequence, yield);
+    auto blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
     if (!blob)
         return false;
@@ -862,7 +889,7 @@ isFrozen(
 
     if (issuer != account) {
         key = ripple::keylet::line(account, issuer, currency).key;
-        blob = backend.fetchLedgerObject(key, sequence, yield);
+        blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
         if (!blob)
             return false;
@@ -888,7 +915,7 @@ xrpLiquid(
 )
 {
     auto const key = ripple::keylet::account(id).key;
-    auto blob = backend.fetchLedgerObject(key, sequence, yield);
+    auto blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
     if (!blob)
         return beast::zero;
@@ -946,7 +973,7 @@ accountHolds(
         return {xrpLiquid(backend, sequence, account, yield)};
 
     auto const key = ripple::keylet::line(account, issuer, currency).key;
-    auto const blob = backend.fetchLedgerObject(key, sequence, yield);
+    auto const blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
     if (!blob) {
         amount.clear({currency, issuer});
@@ -979,7 +1006,7 @@ transferRate(
 )
 {
     auto key = ripple::keylet::account(issuer).key;
-    auto blob = backend.fetchLedgerObject(key, sequence, yield);
+    auto blob = backend.fetchLedgerObjectView(key, sequence, yield);
 
     if (blob) {
         ripple::SerialIter it{blob->data(), blob->size()};
@@ -19,21 +19,92 @@
 
 #include "rpc/WorkQueue.hpp"
 
+#include "util/Assert.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "util/prometheus/Label.hpp"
 #include "util/prometheus/Prometheus.hpp"
 
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/system_timer.hpp>
 #include <boost/json/object.hpp>
+#include <boost/system/error_code.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <thread>
 #include <utility>
 
 namespace rpc {
 
+namespace {
+
+constexpr std::array<char const*, WorkQueue::NUM_PRIORITIES> PRIORITY_NAMES = {
+    "admin",
+    "whitelisted",
+    "cheap",
+    "expensive",
+};
+
+// runs the given function when leaving the scope, including when a job throws
+template <typename FnType>
+class ScopeGuard {
+    FnType fn_;
+
+public:
+    explicit ScopeGuard(FnType fn) : fn_{std::move(fn)}
+    {
+    }
+
+    ~ScopeGuard()
+    {
+        fn_();
+    }
+
+    ScopeGuard(ScopeGuard const&) = delete;
+    ScopeGuard&
+    operator=(ScopeGuard const&) = delete;
+};
+
+}  // namespace
+
+WorkQueue::SchedulingSettings
+WorkQueue::SchedulingSettings::make(util::Config const& serverConfig)
+{
+    SchedulingSettings settings;
+    for (std::size_t i = 0; i < NUM_PRIORITIES; ++i) {
+        auto const name = std::string{PRIORITY_NAMES[i]};
+        settings.weights[i] = serverConfig.valueOr<std::uint32_t>("queue_weights." + name, DEFAULT_WEIGHTS[i]);
+    }
+
+    // admin and whitelisted jobs are never rejected
+    for (auto const priority : {Priority::Cheap, Priority::Expensive}) {
+        auto const i = static_cast<std::size_t>(priority);
+        auto const key = std::string{"max_queue_wait_ms."} + PRIORITY_NAMES[i];
+        settings.maxQueueWait[i] = std::chrono::milliseconds{serverConfig.valueOr<std::uint32_t>(key, 0)};
+    }
+
+    for (auto const& entry : serverConfig.arrayOr("method_concurrency", {}))
+        settings.methodConcurrency[entry.value<std::string>("method")] = entry.value<std::uint32_t>("max");
+
+    settings.requestDeadline = std::chrono::milliseconds{serverConfig.valueOr<std::uint32_t>("request_deadline_ms", 0)};
+
+    return settings;
+}
+
 void
 WorkQueue::OneTimeCallable::setCallable(std::function<void()> func)
 {
@@ -53,7 +124,7 @@ WorkQueue::OneTimeCallable::operator bool() const
     return func_.operator bool();
 }
 
-WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
+WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize, SchedulingSettings scheduling)
     : queued_{PrometheusService::counterInt(
           "work_queue_queued_total_number",
           util::prometheus::Labels(),
@@ -69,10 +140,27 @@ WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
           util::prometheus::Labels(),
           "The current number of tasks in the queue"
       )}
+    , shed_{PrometheusService::counterInt(
+          "work_queue_shed_total_number",
+          util::prometheus::Labels(),
+          "The total number of tasks rejected because their lane waited too long"
+      )}
+    , expired_{PrometheusService::counterInt(
+          "work_queue_expired_total_number",
+          util::prometheus::Labels(),
+          "The total number of tasks cancelled because their deadline passed"
+      )}
+    , requestDeadline_{scheduling.requestDeadline}
+    , methodConcurrency_{std::move(scheduling.methodConcurrency)}
     , ioc_{numWorkers}
 {
     if (maxSize != 0)
         maxSize_ = maxSize;
+
+    for (std::size_t i = 0; i < NUM_PRIORITIES; ++i) {
+        lanes_[i].weight = std::max<std::int64_t>(1, scheduling.weights[i]);
+        lanes_[i].maxQueueWait = scheduling.maxQueueWait[i];
+    }
 }
 
 WorkQueue::~WorkQueue()
@@ -100,7 +188,7 @@ WorkQueue::make_WorkQueue(util::Config const& config)
     auto const maxQueueSize = serverConfig.valueOr<uint32_t>("max_queue_size", 0);  // 0 is no limit
 
     LOG(log.info()) << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize;
-    return WorkQueue{numThreads, maxQueueSize};
+    return WorkQueue{numThreads, maxQueueSize, SchedulingSettings::make(serverConfig)};
 }
 
 boost::json::object
@@ -113,6 +201,14 @@ WorkQueue::report() const
     obj["current_queue_size"] = curSize_.get().value();
     obj["max_queue_size"] = maxSize_;
 
+    boost::json::object lanes;
+    {
+        std::scoped_lock const lock{lanesMutex_};
+        for (std::size_t i = 0; i < NUM_PRIORITIES; ++i)
+            lanes[PRIORITY_NAMES[i]] = lanes_[i].jobs.size();
+    }
+    obj["lanes"] = std::move(lanes);
+
     return obj;
 }
 
@@ -128,4 +224,174 @@ WorkQueue::size() const
     return curSize_.get().value();
 }
 
+bool
+WorkQueue::isLaneOverdue(Priority priority) const
+{
+    std::scoped_lock const lock{lanesMutex_};
+    auto const& lane = lanes_[static_cast<std::size_t>(priority)];
+    if (lane.maxQueueWait.count() == 0 or lane.jobs.empty())
+        return false;
+
+    return std::chrono::system_clock::now() - lane.jobs.front().start > lane.maxQueueWait;
+}
+
+void
+WorkQueue::enqueue(Job job, Priority priority)
+{
+    {
+        std::scoped_lock const lock{lanesMutex_};
+        lanes_[static_cast<std::size_t>(priority)].jobs.push_back(std::move(job));
+    }
+
+    spawnWorker();
+}
+
+void
+WorkQueue::spawnWorker()
+{
+    // Each time we enqueue a job, we post a symmetrical worker that will dequeue and run the job picked by the
+    // scheduler, which is not necessarily the job that was just enqueued.
+    auto const onDone = [this](std::exception_ptr const& ex) {
+        if (not ex)
+            return;
+
+        try {
+            std::rethrow_exception(ex);
+        } catch (std::exception const& e) {
+            LOG(log_.error()) << "WorkQueue job threw: " << e.what();
+        } catch (...) {
+            LOG(log_.error()) << "WorkQueue job threw an unknown exception";
+        }
+        std::rethrow_exception(ex);
+    };
+
+    if (requestDeadline_.count() == 0) {
+        boost::asio::spawn(ioc_, [this](auto yield) { runNext(yield, nullptr); }, onDone);
+        return;
+    }
+
+    // The worker and its deadline timer share a strand so that the cancellation is never emitted concurrently with
+    // the coroutine.
+    auto const strand = boost::asio::make_strand(ioc_);
+    auto const cancellation = std::make_shared<boost::asio::cancellation_signal>();
+
+    boost::asio::spawn(
+        strand,
+        [this, cancellation](auto yield) { runNext(yield, cancellation); },
+        boost::asio::bind_cancellation_slot(cancellation->slot(), onDone)
+    );
+}
+
+template <typename YieldType>
+void
+WorkQueue::runNext(YieldType yield, std::shared_ptr<boost::asio::cancellation_signal> const& cancellation)
+{
+    auto job = pop();
+    if (not job.has_value())
+        return;
+
+    auto const run = std::chrono::system_clock::now();
+    auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - job->start).count();
+
+    ++queued_.get();
+    durationUs_.get() += wait;
+    LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
+
+    std::optional<boost::asio::system_timer> deadline;
+    ScopeGuard const done{[this, &job, &deadline] {
+        finish(*job);
+
+        if (deadline.has_value())
+            deadline->cancel();
+
+        --curSize_.get();
+        if (curSize_.get().value() == 0 && stopping_) {
+            auto onTasksComplete = onQueueEmpty_.lock();
+            ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
+            onTasksComplete->operator()();
+        }
+    }};
+
+    if (cancellation != nullptr) {
+        auto const expiry = job->start + requestDeadline_;
+        if (expiry <= run) {
+            ++expired_.get();
+            cancellation->emit(boost::asio::cancellation_type::terminal);
+        } else {
+            // runs on the strand of the worker; emitting after the job finished is a no-op
+            deadline.emplace(yield.get_executor(), expiry);
+            deadline->async_wait([this, cancellation](boost::system::error_code ec) {
+                if (ec)
+                    return;
+
+                ++expired_.get();
+                cancellation->emit(boost::asio::cancellation_type::terminal);
+            });
+        }
+    }
+
+    job->func(yield);
+}
+
+std::optional<WorkQueue::Job>
+WorkQueue::pop()
+{
+    std::scoped_lock const lock{lanesMutex_};
+
+    auto const isRunnable = [this](Job const& job) {
+        auto const cap = methodConcurrency_.find(job.method);
+        return cap == methodConcurrency_.end() or running_[job.method] < cap->second;
+    };
+
+    // smooth weighted round robin over the lanes that have a runnable job
+    Lane* best = nullptr;
+    std::deque<Job>::iterator bestJob;
+    std::int64_t totalWeight = 0;
+    for (auto& lane : lanes_) {
+        auto const it = std::find_if(lane.jobs.begin(), lane.jobs.end(), isRunnable);
+        if (it == lane.jobs.end())
+            continue;
+
+        lane.current += lane.weight;
+        totalWeight += lane.weight;
+        if (best == nullptr or lane.current > best->current) {
+            best = &lane;
+            bestJob = it;
+        }
+    }
+
+    if (best == nullptr) {
+        // all queued jobs wait for a concurrency cap; finish() spawns a new worker when a capped job is done
+        ++deferred_;
+        return std::nullopt;
+    }
+
+    best->current -= totalWeight;
+    auto job = std::move(*bestJob);
+    best->jobs.erase(bestJob);
+
+    if (methodConcurrency_.contains(job.method))
+        ++running_[job.method];
+
+    return job;
+}
+
+void
+WorkQueue::finish(Job const& job)
+{
+    {
+        std::scoped_lock const lock{lanesMutex_};
+        if (not methodConcurrency_.contains(job.method))
+            return;
+
+        --running_[job.method];
+        if (deferred_ == 0)
+            return;
+
+        --deferred_;
+    }
+
+    spawnWorker();
+}
+
 }  // namespace rpc
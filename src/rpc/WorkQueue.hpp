@@ -19,7 +19,6 @@
 
 #pragma once
 
-#include "util/Assert.hpp"
 #include "util/Mutex.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
@@ -27,30 +26,109 @@
 #include "util/prometheus/Gauge.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/json.hpp>
 #include <boost/json/object.hpp>
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace rpc {
 
 /**
  * @brief An asynchronous, thread-safe queue for RPC requests.
+ *
+ * Jobs are queued in one lane per priority. Every queued job is matched by one worker coroutine that, once it starts,
+ * runs the next job picked by smooth weighted round robin over the lanes, so a flood of jobs in one lane only takes
+ * its share of the workers. Methods can have a concurrency cap; their jobs wait in the lane while the cap is reached.
  */
 class WorkQueue {
+public:
+    /**
+     * @brief The priority of a job.
+     */
+    enum class Priority { Admin, WhiteListed, Cheap, Expensive };
+
+    static constexpr std::size_t NUM_PRIORITIES = 4;
+
+    /**
+     * @brief How jobs of the different priorities are scheduled.
+     */
+    struct SchedulingSettings {
+        static constexpr std::array<std::uint32_t, NUM_PRIORITIES> DEFAULT_WEIGHTS = {8, 4, 4, 1};
+
+        std::array<std::uint32_t, NUM_PRIORITIES> weights = DEFAULT_WEIGHTS; /**< Share of the workers per lane */
+
+        /**
+         * @brief Jobs are rejected while the oldest job of their lane waited longer; 0 is no limit.
+         *
+         * Not used for the admin and whitelisted lanes.
+         */
+        std::array<std::chrono::milliseconds, NUM_PRIORITIES> maxQueueWait{};
+
+        std::unordered_map<std::string, std::uint32_t> methodConcurrency; /**< Max concurrently running jobs */
+
+        /**
+         * @brief Time after which a job is cancelled, counted from when it was queued; 0 is no deadline.
+         *
+         * Jobs run in coroutines that receive a terminal cancellation once the deadline passed, including jobs that
+         * expired while waiting in the queue which are cancelled before they start.
+         */
+        std::chrono::milliseconds requestDeadline{0};
+
+        /**
+         * @brief Read the settings from the server section of the config.
+         *
+         * @param serverConfig The server section of the config
+         * @return The settings
+         */
+        static SchedulingSettings
+        make(util::Config const& serverConfig);
+    };
+
+private:
+    struct Job {
+        std::function<void(boost::asio::yield_context)> func;
+        std::string method;
+        std::chrono::system_clock::time_point start;
+    };
+
+    struct Lane {
+        std::deque<Job> jobs;
+        std::int64_t weight = 1;
+        std::int64_t current = 0;
+        std::chrono::milliseconds maxQueueWait{0};
+    };
+
     // these are cumulative for the lifetime of the process
     std::reference_wrapper<util::prometheus::CounterInt> queued_;
     std::reference_wrapper<util::prometheus::CounterInt> durationUs_;
 
     std::reference_wrapper<util::prometheus::GaugeInt> curSize_;
+    std::reference_wrapper<util::prometheus::CounterInt> shed_;
+    std::reference_wrapper<util::prometheus::CounterInt> expired_;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
+    std::chrono::milliseconds requestDeadline_;
+
+    mutable std::mutex lanesMutex_;
+    std::array<Lane, NUM_PRIORITIES> lanes_;
+    std::unordered_map<std::string, std::uint32_t> methodConcurrency_;
+    std::unordered_map<std::string, std::uint32_t> running_;  // only methods with a concurrency cap
+    std::size_t deferred_ = 0;                                 // workers that found only capped jobs
 
     util::Logger log_{"RPC"};
     boost::asio::thread_pool ioc_;
@@ -78,8 +156,9 @@ public:
      *
      * @param numWorkers The amount of threads to spawn in the pool
      * @param maxSize The maximum capacity of the queue; 0 means unlimited
+     * @param scheduling How jobs of the different priorities are scheduled
      */
-    WorkQueue(std::uint32_t numWorkers, uint32_t maxSize = 0);
+    WorkQueue(std::uint32_t numWorkers, uint32_t maxSize = 0, SchedulingSettings scheduling = {});
     ~WorkQueue();
 
     /**
@@ -112,41 +191,46 @@ public:
     template <typename FnType>
     bool
     postCoro(FnType&& func, bool isWhiteListed)
+    {
+        return postCoro(std::forward<FnType>(func), isWhiteListed ? Priority::WhiteListed : Priority::Cheap);
+    }
+
+    /**
+     * @brief Submit a job with the given priority to the work queue.
+     *
+     * Jobs other than admin and whitelisted ones are rejected if the current size of the queue reached capacity or if
+     * the oldest job of their lane waited longer than the lane allows.
+     *
+     * @tparam FnType The function object type
+     * @param func The function object to queue as a job
+     * @param priority The priority of the job
+     * @param method The RPC method executed by the job; used for the concurrency caps
+     * @return true if the job was successfully queued; false otherwise
+     */
+    template <typename FnType>
+    bool
+    postCoro(FnType&& func, Priority priority, std::string method = {})
     {
         if (stopping_) {
             LOG(log_.warn()) << "Queue is stopping, rejecting incoming task.";
             return false;
         }
 
-        if (curSize_.get().value() >= maxSize_ && !isWhiteListed) {
+        auto const limited = priority != Priority::Admin and priority != Priority::WhiteListed;
+        if (curSize_.get().value() >= maxSize_ && limited) {
             LOG(log_.warn()) << "Queue is full. rejecting job. current size = " << curSize_.get().value()
                              << "; max size = " << maxSize_;
             return false;
         }
 
-        ++curSize_.get();
+        if (limited and isLaneOverdue(priority)) {
+            ++shed_.get();
+            LOG(log_.warn()) << "Queue wait is over the limit of the lane. rejecting job.";
+            return false;
+        }
 
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(
-            ioc_,
-            [this, func = std::forward<FnType>(func), start = std::chrono::system_clock::now()](auto yield) mutable {
-                auto const run = std::chrono::system_clock::now();
-                auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-                ++queued_.get();
-                durationUs_.get() += wait;
-                LOG(log_.info()) << "WorkQueue wait time = " << wait << " queue size = " << curSize_.get().value();
-
-                func(yield);
-                --curSize_.get();
-                if (curSize_.get().value() == 0 && stopping_) {
-                    auto onTasksComplete = onQueueEmpty_.lock();
-                    ASSERT(onTasksComplete->operator bool(), "onTasksComplete must be set when stopping is true.");
-                    onTasksComplete->operator()();
-                }
-            }
-        );
+        ++curSize_.get();
+        enqueue(Job{std::forward<FnType>(func), std::move(method), std::chrono::system_clock::now()}, priority);
 
         return true;
     }
@@ -172,6 +256,26 @@ public:
      */
     size_t
     size() const;
+
+private:
+    bool
+    isLaneOverdue(Priority priority) const;
+
+    void
+    enqueue(Job job, Priority priority);
+
+    void
+    spawnWorker();
+
+    template <typename YieldType>
+    void
+    runNext(YieldType yield, std::shared_ptr<boost::asio::cancellation_signal> const& cancellation);
+
+    std::optional<Job>
+    pop();
+
+    void
+    finish(Job const& job);
 };
 
 }  // namespace rpc
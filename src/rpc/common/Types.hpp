@@ -160,7 +160,17 @@ struct Result {
     {
     }
 
-    std::variant<Status, boost::json::object> response;
+    /**
+     * @brief Construct a new Result object from a successful response shared with the ledger response cache
+     *
+     * @param shared The shared response to construct the result from; the response itself is not copied
+     */
+    explicit Result(std::shared_ptr<ReturnType const> shared) : warnings{shared->warnings}
+    {
+        response = std::move(shared);
+    }
+
+    std::variant<Status, boost::json::object, std::shared_ptr<ReturnType const>> response;
     boost::json::array warnings;
 };
 
@@ -69,7 +69,8 @@ AccountInfoHandler::process(AccountInfoHandler::Input input, Context const& ctx)
     auto const accountStr = input.account.value_or(input.ident.value_or(""));
     auto const accountID = accountFromStringStrict(accountStr);
     auto const accountKeylet = ripple::keylet::account(*accountID);
-    auto const accountLedgerObject = sharedPtrBackend_->fetchLedgerObject(accountKeylet.key, lgrInfo.seq, ctx.yield);
+    auto const accountLedgerObject =
+        sharedPtrBackend_->fetchLedgerObjectView(accountKeylet.key, lgrInfo.seq, ctx.yield);
 
     if (!accountLedgerObject)
         return Error{Status{RippledError::rpcACT_NOT_FOUND}};
@@ -96,7 +97,7 @@ AccountInfoHandler::process(AccountInfoHandler::Input input, Context const& ctx)
 
         // This code will need to be revisited if in the future we
         // support multiple SignerLists on one account.
-        auto const signers = sharedPtrBackend_->fetchLedgerObject(signersKey.key, lgrInfo.seq, ctx.yield);
+        auto const signers = sharedPtrBackend_->fetchLedgerObjectView(signersKey.key, lgrInfo.seq, ctx.yield);
         std::vector<ripple::STLedgerEntry> signerList;
 
         if (signers) {
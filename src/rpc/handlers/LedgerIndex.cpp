@@ -57,13 +57,35 @@ LedgerIndexHandler::process(LedgerIndexHandler::Input input, Context const& ctx)
     if (!input.date)
         return fillOutputByIndex(maxIndex);
 
-    auto const convertISOTimeStrToTicks = [](std::string const& isoTimeStr) {
-        auto const systemTime = util::SystemTpFromUTCStr(isoTimeStr, DATE_FORMAT);
-        // systemTime must be valid after validation passed
-        return systemTime->time_since_epoch().count();
-    };
-
-    auto const ticks = convertISOTimeStrToTicks(*input.date);
+    // systemTime must be valid after validation passed
+    auto const systemTime = *util::SystemTpFromUTCStr(*input.date, DATE_FORMAT);
+    auto const ticks = systemTime.time_since_epoch().count();
+
+    // the ledgers to search in the database; narrowed down or skipped entirely if the close time index covers the date
+    auto lo = minIndex;
+    auto hi = maxIndex;
+
+    auto const& closeTimeIndex = sharedPtrBackend_->closeTimeIndex();
+    auto const closeTime = util::LedgerCloseTimeFromSystemTp(systemTime);
+    if (auto const indexed = closeTimeIndex.range(); indexed.has_value() and closeTime.has_value()) {
+        auto const seq = closeTimeIndex.lastLedgerClosedBy(*closeTime);
+        if (not seq.has_value()) {
+            // every indexed ledger closed after the date
+            if (indexed->minSequence <= minIndex)
+                return Error{Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotInRange"}};
+            hi = std::min(hi, indexed->minSequence - 1);
+        } else if (*seq < indexed->maxSequence) {
+            // the ledger following seq closed after the date
+            if (*seq < minIndex)
+                return Error{Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotInRange"}};
+            return fillOutputByIndex(std::min(*seq, maxIndex));
+        } else if (*seq >= maxIndex) {
+            return fillOutputByIndex(maxIndex);
+        } else {
+            // ledgers newer than the index may have closed by the date as well
+            lo = std::max(lo, *seq);
+        }
+    }
 
     auto const earlierThan = [&](std::uint32_t ledgerIndex) {
         auto const header = sharedPtrBackend_->fetchLedgerBySequence(ledgerIndex, ctx.yield);
@@ -72,19 +94,19 @@ LedgerIndexHandler::process(LedgerIndexHandler::Input input, Context const& ctx)
     };
 
     // If the given date is earlier than the first valid ledger, return lgrNotFound
-    if (earlierThan(minIndex))
+    if (earlierThan(lo))
         return Error{Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotInRange"}};
 
-    auto const view = std::ranges::iota_view{minIndex, maxIndex + 1};
+    auto const view = std::ranges::iota_view{lo, hi + 1};
 
     auto const greaterEqLedgerIter = std::ranges::lower_bound(
         view, ticks, [&](std::uint32_t ledgerIndex, std::int64_t) { return not earlierThan(ledgerIndex); }
     );
 
     if (greaterEqLedgerIter != view.end())
-        return fillOutputByIndex(std::max(static_cast<std::uint32_t>(*greaterEqLedgerIter) - 1, minIndex));
+        return fillOutputByIndex(std::max(static_cast<std::uint32_t>(*greaterEqLedgerIter) - 1, lo));
 
-    return fillOutputByIndex(maxIndex);
+    return fillOutputByIndex(hi);
 }
 
 LedgerIndexHandler::Input
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <cctype>
 #include <string>
+#include <vector>
 
 /**
  * @brief This namespace contains various utilities.
@@ -86,4 +87,48 @@ removeSecret(boost::json::object const& object)
     return newObject;
 }
 
+/**
+ * @brief Serialize a JSON value with the members of every object ordered by key.
+ *
+ * Documents that only differ in the order of their members produce the same string, which makes the result usable as
+ * a key for the document.
+ *
+ * @param value The JSON value to serialize
+ * @return The serialized value
+ */
+inline std::string
+serializeNormalized(boost::json::value const& value)
+{
+    if (value.is_object()) {
+        std::vector<boost::json::key_value_pair const*> members;
+        members.reserve(value.as_object().size());
+        for (auto const& member : value.as_object())
+            members.push_back(&member);
+
+        std::ranges::sort(members, {}, [](auto const* member) { return member->key(); });
+
+        std::string result = "{";
+        for (auto const* member : members) {
+            if (result.size() > 1)
+                result += ',';
+            result += boost::json::serialize(boost::json::string{member->key()});
+            result += ':';
+            result += serializeNormalized(member->value());
+        }
+        return result + '}';
+    }
+
+    if (value.is_array()) {
+        std::string result = "[";
+        for (auto const& element : value.as_array()) {
+            if (result.size() > 1)
+                result += ',';
+            result += serializeNormalized(element);
+        }
+        return result + ']';
+    }
+
+    return boost::json::serialize(value);
+}
+
 }  // namespace util
@@ -0,0 +1,195 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief How a call to SingleFlight::execute obtained its value.
+ */
+enum class SingleFlightOutcome {
+    Executed,          /**< The function was executed and no other caller waited for it */
+    ExecutedAndShared, /**< The function was executed and its value was shared with other callers */
+    Shared             /**< The value of a function executed by another caller was used */
+};
+
+/**
+ * @brief Coalesces concurrent executions of the same work.
+ *
+ * The first coroutine to execute a key runs the function. Coroutines executing the same key while it runs are
+ * suspended and receive a copy of its value instead of running the function themselves. If the function throws, the
+ * exception is propagated to the coroutine that ran it and every waiting coroutine runs the function on its own.
+ * A waiting coroutine that is cancelled stops waiting and gets boost::asio::error::operation_aborted.
+ *
+ * @tparam ValueType The type of value produced by the function
+ */
+template <typename ValueType>
+class SingleFlight {
+    struct Flight {
+        bool done = false;
+        std::optional<ValueType> value;
+        std::vector<std::function<bool()>> waiters;  // return false if the waiter was cancelled before
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+
+public:
+    /**
+     * @brief Execute the function or wait for the value of a concurrent execution of the same key.
+     *
+     * @param yield The coroutine to suspend while waiting
+     * @param key The key identifying the work
+     * @param fn The function producing the value
+     * @return The value and how it was obtained
+     * @throws boost::system::system_error with boost::asio::error::operation_aborted if the coroutine is cancelled
+     * while it waits for another execution
+     */
+    template <typename FnType>
+    std::pair<ValueType, SingleFlightOutcome>
+    execute(boost::asio::yield_context yield, std::string const& key, FnType&& fn)
+    {
+        std::shared_ptr<Flight> flight;
+        bool leader = false;
+        {
+            std::scoped_lock const lock{mutex_};
+            auto [it, inserted] = flights_.try_emplace(key);
+            if (inserted)
+                it->second = std::make_shared<Flight>();
+
+            flight = it->second;
+            leader = inserted;
+        }
+
+        if (leader)
+            return lead(key, flight, std::forward<FnType>(fn));
+
+        wait(yield, flight);
+        if (flight->value.has_value())
+            return {*flight->value, SingleFlightOutcome::Shared};
+
+        return {std::invoke(std::forward<FnType>(fn)), SingleFlightOutcome::Executed};
+    }
+
+private:
+    template <typename FnType>
+    std::pair<ValueType, SingleFlightOutcome>
+    lead(std::string const& key, std::shared_ptr<Flight> const& flight, FnType&& fn)
+    {
+        try {
+            auto value = std::invoke(std::forward<FnType>(fn));
+            auto const shared = finish(key, flight, &value);
+            return {std::move(value), shared ? SingleFlightOutcome::ExecutedAndShared : SingleFlightOutcome::Executed};
+        } catch (...) {
+            finish(key, flight, nullptr);
+            throw;
+        }
+    }
+
+    bool
+    finish(std::string const& key, std::shared_ptr<Flight> const& flight, ValueType const* value)
+    {
+        std::vector<std::function<bool()>> waiters;
+        {
+            std::scoped_lock const lock{mutex_};
+            flights_.erase(key);
+            waiters = std::move(flight->waiters);
+            flight->done = true;
+
+            // nobody can join the flight once it is erased, so the value is only copied if somebody waits for it
+            if (value != nullptr and not waiters.empty())
+                flight->value = *value;
+        }
+
+        bool shared = false;
+        for (auto& waiter : waiters)
+            shared = waiter() or shared;
+
+        return shared;
+    }
+
+    void
+    wait(boost::asio::yield_context yield, std::shared_ptr<Flight> const& flight)
+    {
+        auto init = [this, &flight]<typename Self>(Self& self) {
+            auto slot = self.get_cancellation_state().slot();
+            auto const cancelled = self.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none;
+            auto sself = std::make_shared<Self>(std::move(self));
+
+            // completed by whichever comes first: the end of the flight or the cancellation
+            auto waiting = std::make_shared<std::atomic_bool>(true);
+            auto resume = [sself, waiting](boost::system::error_code ec) {
+                if (not waiting->exchange(false))
+                    return false;
+
+                boost::asio::post(boost::asio::get_associated_executor(*sself), [sself, ec]() {
+                    sself->get_cancellation_state().slot().clear();
+                    sself->complete(ec);
+                });
+                return true;
+            };
+
+            if (cancelled) {
+                resume(boost::asio::error::operation_aborted);
+                return;
+            }
+
+            if (slot.is_connected()) {
+                slot.assign([resume](boost::asio::cancellation_type) {
+                    resume(boost::asio::error::operation_aborted);
+                });
+            }
+
+            std::unique_lock lock{mutex_};
+            if (not flight->done) {
+                flight->waiters.push_back([resume]() { return resume({}); });
+                return;
+            }
+
+            lock.unlock();
+            resume({});
+        };
+
+        boost::asio::async_compose<boost::asio::yield_context, void(boost::system::error_code)>(
+            init, yield, boost::asio::get_associated_executor(yield)
+        );
+    }
+};
+
+}  // namespace util
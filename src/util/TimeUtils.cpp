@@ -23,6 +23,7 @@
 
 #include <chrono>
 #include <ctime>
+#include <limits>
 #include <optional>
 #include <string>
 
@@ -44,4 +45,15 @@ SystemTpFromLedgerCloseTime(ripple::NetClock::time_point closeTime)
     return std::chrono::system_clock::time_point{closeTime.time_since_epoch() + ripple::epoch_offset};
 }
 
+[[nodiscard]] std::optional<ripple::NetClock::time_point>
+LedgerCloseTimeFromSystemTp(std::chrono::system_clock::time_point systemTime)
+{
+    auto const sinceEpoch =
+        std::chrono::duration_cast<std::chrono::seconds>(systemTime.time_since_epoch()) - ripple::epoch_offset;
+    if (sinceEpoch.count() < 0 or sinceEpoch.count() > std::numeric_limits<ripple::NetClock::rep>::max())
+        return std::nullopt;
+
+    return ripple::NetClock::time_point{ripple::NetClock::duration{sinceEpoch.count()}};
+}
+
 }  // namespace util
@@ -43,4 +43,12 @@ SystemTpFromUTCStr(std::string const& dateStr, std::string const& format);
 [[nodiscard]] std::chrono::system_clock::time_point
 SystemTpFromLedgerCloseTime(ripple::NetClock::time_point closeTime);
 
+/**
+ * @brief Convert a system_clock::time_point to XRPL network clock, truncating it to whole seconds.
+ * @param systemTime The system_clock::time_point to convert.
+ * @return The network clock time point if the time can be represented by the network clock, otherwise std::nullopt.
+ */
+[[nodiscard]] std::optional<ripple::NetClock::time_point>
+LedgerCloseTimeFromSystemTp(std::chrono::system_clock::time_point systemTime);
+
 }  // namespace util
@@ -21,8 +21,12 @@
 
 #include "util/SourceLocation.hpp"
 #include "util/config/Config.hpp"
+#include "util/log/impl/RingBufferQueue.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/core/null_deleter.hpp>
 #include <boost/date_time/posix_time/posix_time_duration.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
@@ -41,7 +45,12 @@
 #include <boost/log/keywords/target.hpp>
 #include <boost/log/keywords/target_file_name.hpp>
 #include <boost/log/keywords/time_based_rotation.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
 #include <boost/log/utility/setup/console.hpp>
 #include <boost/log/utility/setup/file.hpp>
@@ -49,10 +58,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -61,6 +74,86 @@
 
 namespace util {
 
+namespace {
+
+/**
+ * @brief How the console and file sinks hand records over to their backends.
+ */
+struct SinkSettings {
+    std::string format;
+    std::optional<impl::OverflowPolicy> overflow; /**< Records are written on a writer thread if set */
+    std::size_t queueSize = impl::RingBufferQueue<impl::OverflowPolicy::Block>::DEFAULT_CAPACITY;
+};
+
+template <typename BackendType, typename FilterType>
+void
+addSink(boost::shared_ptr<BackendType> backend, SinkSettings const& settings, FilterType const& filter)
+{
+    auto const add = [&]<typename SinkType>(boost::shared_ptr<SinkType> sink) {
+        sink->set_formatter(boost::log::parse_formatter(settings.format));
+        sink->set_filter(filter);
+        boost::log::core::get()->add_sink(std::move(sink));
+    };
+
+    namespace sinks = boost::log::sinks;
+    using impl::OverflowPolicy;
+    using impl::RingBufferQueue;
+
+    if (not settings.overflow.has_value()) {
+        add(boost::make_shared<sinks::synchronous_sink<BackendType>>(std::move(backend)));
+    } else if (*settings.overflow == OverflowPolicy::Drop) {
+        add(boost::make_shared<sinks::asynchronous_sink<BackendType, RingBufferQueue<OverflowPolicy::Drop>>>(
+            std::move(backend), boost::log::keywords::max_size = settings.queueSize
+        ));
+    } else {
+        add(boost::make_shared<sinks::asynchronous_sink<BackendType, RingBufferQueue<OverflowPolicy::Block>>>(
+            std::move(backend), boost::log::keywords::max_size = settings.queueSize
+        ));
+    }
+}
+
+SinkSettings
+makeSinkSettings(util::Config const& config, std::string format)
+{
+    SinkSettings settings{.format = std::move(format)};
+    if (not config.valueOr("log_async", true))
+        return settings;
+
+    auto const overflow = config.valueOr<std::string>("log_queue_overflow", "block");
+    if (overflow == "block") {
+        settings.overflow = impl::OverflowPolicy::Block;
+    } else if (overflow == "drop") {
+        settings.overflow = impl::OverflowPolicy::Drop;
+    } else {
+        throw std::runtime_error("Could not parse `log_queue_overflow`: expected `block` or `drop`");
+    }
+
+    settings.queueSize = config.valueOr<std::size_t>("log_queue_size", settings.queueSize);
+    return settings;
+}
+
+/**
+ * @brief The minimal severities shared by the loggers of each channel.
+ *
+ * Everything passes until LogService::init applies the configured levels; channels registered afterwards take their
+ * configured level, or the default one.
+ */
+struct ChannelSeverities {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<std::atomic<Severity>>> channels;
+    std::unordered_map<std::string, Severity> configured;
+    Severity defaultSeverity = Severity::TRC;
+};
+
+ChannelSeverities&
+channelSeverities()
+{
+    static ChannelSeverities instance;
+    return instance;
+}
+
+}  // namespace
+
 Logger LogService::general_log_ = Logger{"General"};
 Logger LogService::alert_log_ = Logger{"Alert"};
 boost::log::filter LogService::filter_{};
@@ -116,13 +209,17 @@ LogService::init(util::Config const& config)
     auto const defaultFormat = "%TimeStamp% (%SourceLocation%) [%ThreadID%] %Channel%:%Severity% %Message%";
     std::string format = config.valueOr<std::string>("log_format", defaultFormat);
 
+    // the sinks for console and file are written to by a writer thread each unless `log_async` is false; only the
+    // record is built on the logging thread, formatting and I/O happen on the writer thread
+    auto const sinkSettings = makeSinkSettings(config, format);
+
     if (config.valueOr("log_to_console", false)) {
-        boost::log::add_console_log(
-            std::cout, keywords::format = format, keywords::filter = log_severity < Severity::FTL
-        );
+        auto backend = boost::make_shared<sinks::text_ostream_backend>();
+        backend->add_stream(boost::shared_ptr<std::ostream>(&std::cout, boost::null_deleter()));
+        addSink(std::move(backend), sinkSettings, log_severity < Severity::FTL);
     }
 
-    // Always print fatal logs to cerr
+    // Always print fatal logs to cerr, synchronously so that they are not lost when the process aborts
     boost::log::add_console_log(std::cerr, keywords::format = format, keywords::filter = log_severity >= Severity::FTL);
 
     if (auto logDir = config.maybeValue<std::string>("log_directory"); logDir) {
@@ -132,20 +229,20 @@ LogService::init(util::Config const& config)
         auto const rotationSize = config.valueOr<uint64_t>("log_rotation_size", 2048u) * 1024u * 1024u;
         auto const rotationPeriod = config.valueOr<uint32_t>("log_rotation_hour_interval", 12u);
         auto const dirSize = config.valueOr<uint64_t>("log_directory_max_size", 50u * 1024u) * 1024u * 1024u;
-        auto fileSink = boost::log::add_file_log(
+        auto fileBackend = boost::make_shared<sinks::text_file_backend>(
             keywords::file_name = dirPath / "clio.log",
             keywords::target_file_name = dirPath / "clio_%Y-%m-%d_%H-%M-%S.log",
             keywords::auto_flush = true,
-            keywords::format = format,
             keywords::open_mode = std::ios_base::app,
             keywords::rotation_size = rotationSize,
             keywords::time_based_rotation =
                 sinks::file::rotation_at_time_interval(boost::posix_time::hours(rotationPeriod))
         );
-        fileSink->locked_backend()->set_file_collector(
+        fileBackend->set_file_collector(
             sinks::file::make_collector(keywords::target = dirPath, keywords::max_size = dirSize)
         );
-        fileSink->locked_backend()->scan_for_files();
+        fileBackend->scan_for_files();
+        addSink(std::move(fileBackend), sinkSettings, boost::log::filter{});
     }
 
     // get default severity, can be overridden per channel using the `log_channels` array
@@ -164,6 +261,8 @@ LogService::init(util::Config const& config)
         min_severity[name] = cfg.valueOr<Severity>("log_level", defaultSeverity);
     }
 
+    Logger::setChannelSeverities(min_severity, defaultSeverity);
+
     auto log_filter = [min_severity = std::move(min_severity),
                        defaultSeverity](boost::log::attribute_value_set const& attributes) -> bool {
         auto const channel = attributes[log_channel];
@@ -180,36 +279,60 @@ LogService::init(util::Config const& config)
     LOG(LogService::info()) << "Default log level = " << defaultSeverity;
 }
 
-Logger::Pump
-Logger::trace(SourceLocationType const& loc) const
-{
-    return {logger_, Severity::TRC, loc};
-};
-Logger::Pump
-Logger::debug(SourceLocationType const& loc) const
-{
-    return {logger_, Severity::DBG, loc};
-};
-Logger::Pump
-Logger::info(SourceLocationType const& loc) const
+void
+LogService::flush()
 {
-    return {logger_, Severity::NFO, loc};
-};
-Logger::Pump
-Logger::warn(SourceLocationType const& loc) const
+    using impl::OverflowPolicy;
+    using impl::RingBufferQueue;
+
+    if (auto const dropped = RingBufferQueue<OverflowPolicy::Drop>::dropped(); dropped > 0)
+        LOG(LogService::warn()) << "Dropped " << dropped << " log records because the log queue was full";
+
+    boost::log::core::get()->flush();
+}
+
+void
+LogService::registerMetrics()
 {
-    return {logger_, Severity::WRN, loc};
-};
-Logger::Pump
-Logger::error(SourceLocationType const& loc) const
+    using impl::OverflowPolicy;
+    using impl::RingBufferQueue;
+
+    RingBufferQueue<OverflowPolicy::Drop>::exportDropped(&PrometheusService::counterInt(
+        "log_records_dropped_total_number",
+        util::prometheus::Labels(),
+        "Total number of log records dropped because the log queue was full"
+    ));
+}
+
+std::atomic<Severity> const&
+Logger::channelSeverity(std::string const& channel)
 {
-    return {logger_, Severity::ERR, loc};
-};
-Logger::Pump
-Logger::fatal(SourceLocationType const& loc) const
+    auto& severities = channelSeverities();
+    std::scoped_lock const lock{severities.mutex};
+
+    auto& severity = severities.channels[channel];
+    if (not severity) {
+        auto const it = severities.configured.find(channel);
+        severity = std::make_unique<std::atomic<Severity>>(
+            it != severities.configured.end() ? it->second : severities.defaultSeverity
+        );
+    }
+    return *severity;
+}
+
+void
+Logger::setChannelSeverities(std::unordered_map<std::string, Severity> severities, Severity defaultSeverity)
 {
-    return {logger_, Severity::FTL, loc};
-};
+    auto& state = channelSeverities();
+    std::scoped_lock const lock{state.mutex};
+
+    state.configured = std::move(severities);
+    state.defaultSeverity = defaultSeverity;
+    for (auto const& [channel, severity] : state.channels) {
+        auto const it = state.configured.find(channel);
+        severity->store(it != state.configured.end() ? it->second : defaultSeverity, std::memory_order_relaxed);
+    }
+}
 
 std::string
 Logger::Pump::pretty_path(SourceLocationType const& loc, size_t max_depth)
@@ -45,10 +45,12 @@
 #include <boost/log/utility/setup/formatter_parser.hpp>
 
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <optional>
 #include <ostream>
 #include <string>
+#include <unordered_map>
 
 namespace util {
 
@@ -80,6 +82,17 @@ enum class Severity {
     FTL,
 };
 
+#ifndef CLIO_MIN_LOG_SEVERITY
+#define CLIO_MIN_LOG_SEVERITY 0
+#endif
+
+/**
+ * @brief Log records below this severity are removed at compile time.
+ *
+ * Set with the `min_log_level` CMake option; the arguments of a removed @ref LOG statement are never evaluated.
+ */
+static constexpr Severity MIN_SEVERITY = static_cast<Severity>(CLIO_MIN_LOG_SEVERITY);
+
 /** @cond */
 BOOST_LOG_ATTRIBUTE_KEYWORD(log_severity, "Severity", Severity);
 BOOST_LOG_ATTRIBUTE_KEYWORD(log_channel, "Channel", std::string);
@@ -106,6 +119,7 @@ operator<<(std::ostream& stream, Severity sev);
 class Logger final {
     using LoggerType = boost::log::sources::severity_channel_logger_mt<Severity, std::string>;
     mutable LoggerType logger_;
+    std::atomic<Severity> const* minSeverity_; /**< Shared by all loggers of the channel */
 
     friend class LogService;  // to expose the Pump interface
 
@@ -121,6 +135,9 @@ class Logger final {
     public:
         ~Pump() = default;
 
+        /** @brief Construct a disabled pump that discards everything. */
+        Pump() = default;
+
         Pump(LoggerType& logger, Severity sev, SourceLocationType const& loc)
             : rec_{logger.open_record(boost::log::keywords::severity = sev)}
         {
@@ -196,7 +213,8 @@ public:
      *
      * @param channel The channel this logger will report into.
      */
-    Logger(std::string channel) : logger_{boost::log::keywords::channel = channel}
+    Logger(std::string channel)
+        : logger_{boost::log::keywords::channel = channel}, minSeverity_{&channelSeverity(channel)}
     {
     }
 
@@ -217,7 +235,10 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    trace(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    trace(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::TRC>(loc);
+    }
 
     /**
      * @brief Interface for logging at Severity::DBG severity
@@ -226,7 +247,10 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    debug(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    debug(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::DBG>(loc);
+    }
 
     /**
      * @brief Interface for logging at Severity::NFO severity
@@ -235,7 +259,10 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    info(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    info(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::NFO>(loc);
+    }
 
     /**
      * @brief Interface for logging at Severity::WRN severity
@@ -244,7 +271,10 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    warn(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    warn(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::WRN>(loc);
+    }
 
     /**
      * @brief Interface for logging at Severity::ERR severity
@@ -253,7 +283,10 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    error(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    error(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::ERR>(loc);
+    }
 
     /**
      * @brief Interface for logging at Severity::FTL severity
@@ -262,7 +295,48 @@ public:
      * @return The pump to use for logging
      */
     [[nodiscard]] Pump
-    fatal(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const;
+    fatal(SourceLocationType const& loc = CURRENT_SRC_LOCATION) const
+    {
+        return makePump<Severity::FTL>(loc);
+    }
+
+private:
+    /**
+     * @brief Open a record unless the severity is compiled out or below the minimal severity of the channel.
+     *
+     * The per-channel check is a relaxed atomic load, so a disabled statement costs neither the lock of the Boost.Log
+     * logger nor the evaluation of the filter of the logging core.
+     */
+    template <Severity Sev>
+    Pump
+    makePump(SourceLocationType const& loc) const
+    {
+        if constexpr (Sev < MIN_SEVERITY) {
+            return Pump{};
+        } else {
+            if (Sev < minSeverity_->load(std::memory_order_relaxed))
+                return Pump{};
+            return Pump{logger_, Sev, loc};
+        }
+    }
+
+    /**
+     * @brief The minimal severity of a channel; everything passes until @ref LogService::init sets them.
+     *
+     * @param channel The channel
+     * @return The minimal severity shared by all loggers of the channel
+     */
+    static std::atomic<Severity> const&
+    channelSeverity(std::string const& channel);
+
+    /**
+     * @brief Set the minimal severity of every channel, including channels of loggers created later.
+     *
+     * @param severities The minimal severity of the configured channels
+     * @param defaultSeverity The minimal severity of all other channels
+     */
+    static void
+    setChannelSeverities(std::unordered_map<std::string, Severity> severities, Severity defaultSeverity);
 };
 
 /**
@@ -287,6 +361,22 @@ public:
     static void
     init(Config const& config);
 
+    /**
+     * @brief Write out the records still queued in asynchronous sinks.
+     *
+     * Must be called before the process exits; records that are queued when the sinks are destroyed are lost.
+     */
+    static void
+    flush();
+
+    /**
+     * @brief Export the number of log records dropped because the log queue was full as a Prometheus counter.
+     *
+     * Must be called after PrometheusService::init(); records dropped before that are included in the counter.
+     */
+    static void
+    registerMetrics();
+
     /**
      * @brief Globally accesible General logger at Severity::TRC severity
      *
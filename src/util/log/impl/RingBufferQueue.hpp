@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/prometheus/Counter.hpp"
+
+#include <boost/log/core/record_view.hpp>
+#include <boost/log/keywords/max_size.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace util::impl {
+
+/**
+ * @brief What an asynchronous log sink does with a record when its queue is full.
+ */
+enum class OverflowPolicy {
+    Drop, /**< The record is discarded and counted */
+    Block /**< The logging thread waits until the writer thread made space */
+};
+
+/**
+ * @brief A Boost.Log queueing strategy for `asynchronous_sink` backed by a bounded lock-free ring buffer.
+ *
+ * Logging threads claim a slot with a single compare-and-swap and only touch the futex of the writer thread when it is
+ * waiting for records. The writer thread of the sink formats the records and writes them to the backend. The capacity
+ * is taken from the `max_size` named parameter of the sink and rounded up to a power of two.
+ *
+ * @tparam Policy What to do when the queue is full
+ */
+template <OverflowPolicy Policy>
+class RingBufferQueue {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+private:
+    struct Cell {
+        std::atomic_size_t sequence;
+        boost::log::record_view record;
+    };
+
+    static inline std::atomic_uint64_t dropped_{0};
+    static inline std::atomic<prometheus::CounterInt*> droppedCounter_{nullptr};
+
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    alignas(64) std::atomic_size_t enqueuePos_{0};
+    alignas(64) std::atomic_size_t dequeuePos_{0};
+
+    // bumped after every enqueue and dequeue so that the other side can wait for a change
+    alignas(64) std::atomic_uint32_t published_{0};
+    alignas(64) std::atomic_uint32_t consumed_{0};
+    std::atomic_bool interrupted_{false};
+
+public:
+    /**
+     * @return The number of records dropped by all queues with this policy
+     */
+    static std::uint64_t
+    dropped()
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Count the records dropped by all queues with this policy in a Prometheus counter as well.
+     *
+     * The records dropped so far are added to the counter right away.
+     *
+     * @param counter The counter to increase; it must stay alive until it is replaced. nullptr stops the export
+     */
+    static void
+    exportDropped(prometheus::CounterInt* counter)
+    {
+        droppedCounter_.store(counter, std::memory_order_release);
+        if (counter != nullptr)
+            *counter += dropped();
+    }
+
+    /**
+     * @return The number of records the queue can hold
+     */
+    std::size_t
+    capacity() const
+    {
+        return mask_ + 1;
+    }
+
+protected:
+    /**
+     * @brief Construct a queue.
+     *
+     * @param capacity The minimal number of records the queue can hold
+     */
+    explicit RingBufferQueue(std::size_t capacity = DEFAULT_CAPACITY)
+        : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1))
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Construct a queue from the named parameters of the sink.
+     *
+     * @param args The named parameters; `max_size` sets the capacity
+     */
+    template <typename ArgsT>
+    explicit RingBufferQueue(ArgsT const& args)
+        : RingBufferQueue(static_cast<std::size_t>(args[boost::log::keywords::max_size | DEFAULT_CAPACITY]))
+    {
+    }
+
+    // the interface asynchronous_sink expects from its queueing strategy
+
+    void
+    enqueue(boost::log::record_view const& rec)
+    {
+        while (not tryPush(rec)) {
+            if constexpr (Policy == OverflowPolicy::Drop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                if (auto* counter = droppedCounter_.load(std::memory_order_acquire); counter != nullptr)
+                    ++*counter;
+                return;
+            } else {
+                auto const consumed = consumed_.load(std::memory_order_acquire);
+                if (tryPush(rec))
+                    break;
+                consumed_.wait(consumed, std::memory_order_acquire);
+            }
+        }
+        notify(published_);
+    }
+
+    bool
+    try_enqueue(boost::log::record_view const& rec)
+    {
+        if (not tryPush(rec))
+            return false;
+
+        notify(published_);
+        return true;
+    }
+
+    bool
+    try_dequeue_ready(boost::log::record_view& rec)
+    {
+        return try_dequeue(rec);
+    }
+
+    bool
+    try_dequeue(boost::log::record_view& rec)
+    {
+        if (not tryPop(rec))
+            return false;
+
+        notify(consumed_);
+        return true;
+    }
+
+    bool
+    dequeue_ready(boost::log::record_view& rec)
+    {
+        while (true) {
+            auto const published = published_.load(std::memory_order_acquire);
+            if (try_dequeue(rec))
+                return true;
+
+            if (interrupted_.exchange(false, std::memory_order_acq_rel))
+                return false;
+
+            published_.wait(published, std::memory_order_acquire);
+        }
+    }
+
+    void
+    interrupt_dequeue()
+    {
+        interrupted_.store(true, std::memory_order_release);
+        notify(published_);
+    }
+
+private:
+    static void
+    notify(std::atomic_uint32_t& counter)
+    {
+        counter.fetch_add(1, std::memory_order_release);
+        counter.notify_all();
+    }
+
+    // bounded queue of Dmitry Vyukov: the sequence of a cell tells whether it is free for the lap of the producer or
+    // filled for the lap of the consumer
+    bool
+    tryPush(boost::log::record_view const& rec)
+    {
+        auto pos = enqueuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos & mask_];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.record = rec;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < pos) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool
+    tryPop(boost::log::record_view& rec)
+    {
+        auto pos = dequeuePos_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[pos & mask_];
+            auto const sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == pos + 1) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    rec.swap(cell.record);
+                    cell.record = boost::log::record_view{};
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < pos + 1) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+};
+
+}  // namespace util::impl
@@ -79,6 +79,31 @@ static constexpr std::array<char const*, 3> LOAD_CACHE_MODE = {
  */
 static constexpr std::array<char const*, 1> DATABASE_TYPE = {"cassandra"};
 
+/**
+ * @brief specific values that are accepted for the websocket slow client policy in config.
+ */
+static constexpr std::array<char const*, 3> SLOW_CLIENT_POLICY = {
+    "drop_oldest",
+    "coalesce_ledgers",
+    "disconnect",
+};
+
+/**
+ * @brief specific values that are accepted for the DOS guard rate limiter in config.
+ */
+static constexpr std::array<char const*, 2> RATE_LIMITER = {
+    "interval",
+    "token_bucket",
+};
+
+/**
+ * @brief specific values that are accepted for the overflow policy of the log queue in config.
+ */
+static constexpr std::array<char const*, 2> LOG_QUEUE_OVERFLOW = {
+    "block",
+    "drop",
+};
+
 /**
  * @brief An interface to enforce constraints on certain values within ClioConfigDefinition.
  */
@@ -346,6 +371,9 @@ static constinit OneOf validateLogLevelName{"log_level", LOG_LEVELS};
 static constinit OneOf validateCassandraName{"database.type", DATABASE_TYPE};
 static constinit OneOf validateLoadMode{"cache.load", LOAD_CACHE_MODE};
 static constinit OneOf validateLogTag{"log_tag_style", LOG_TAGS};
+static constinit OneOf validateSlowClientPolicy{"server.ws_slow_client_policy", SLOW_CLIENT_POLICY};
+static constinit OneOf validateRateLimiter{"dos_guard.rate_limiter", RATE_LIMITER};
+static constinit OneOf validateLogQueueOverflow{"log_queue_overflow", LOG_QUEUE_OVERFLOW};
 
 static constinit PositiveDouble validatePositiveDouble{};
 
@@ -358,5 +386,6 @@ static constinit NumberValueConstraint<uint32_t> validateUint32{
     std::numeric_limits<uint32_t>::max()
 };
 static constinit NumberValueConstraint<uint32_t> validateApiVersion{rpc::API_VERSION_MIN, rpc::API_VERSION_MAX};
+static constinit NumberValueConstraint<uint32_t> validateCompressionLevel{0, 9};
 
 }  // namespace util::config
@@ -72,6 +72,8 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"database.cassandra.queue_size_io", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint16)},
      {"database.cassandra.write_batch_size",
       ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(validateUint16)},
+     {"database.cassandra.read_batch_size",
+      ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)},
      {"etl_source.[].ip", Array{ConfigValue{ConfigType::String}.withConstraint(validateIP)}},
      {"etl_source.[].ws_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
      {"etl_source.[].grpc_port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
@@ -85,14 +87,43 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"dos_guard.max_requests", ConfigValue{ConfigType::Integer}.defaultValue(20).withConstraint(validateUint32)},
      {"dos_guard.sweep_interval",
       ConfigValue{ConfigType::Double}.defaultValue(1.0).withConstraint(validatePositiveDouble)},
+     {"dos_guard.rate_limiter",
+      ConfigValue{ConfigType::String}.defaultValue("interval").withConstraint(validateRateLimiter)},
+     {"dos_guard.max_method_cost", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"dos_guard.method_weights.[].method", Array{ConfigValue{ConfigType::String}}},
+     {"dos_guard.method_weights.[].weight", Array{ConfigValue{ConfigType::Integer}.withConstraint(validateUint32)}},
      {"cache.peers.[].ip", Array{ConfigValue{ConfigType::String}.withConstraint(validateIP)}},
      {"cache.peers.[].port", Array{ConfigValue{ConfigType::String}.withConstraint(validatePort)}},
      {"server.ip", ConfigValue{ConfigType::String}.withConstraint(validateIP)},
      {"server.port", ConfigValue{ConfigType::Integer}.withConstraint(validatePort)},
      {"server.workers", ConfigValue{ConfigType::Integer}.withConstraint(validateUint32)},
      {"server.max_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"server.queue_weights.admin", ConfigValue{ConfigType::Integer}.defaultValue(8).withConstraint(validateUint32)},
+     {"server.queue_weights.whitelisted",
+      ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(validateUint32)},
+     {"server.queue_weights.cheap", ConfigValue{ConfigType::Integer}.defaultValue(4).withConstraint(validateUint32)},
+     {"server.queue_weights.expensive",
+      ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(validateUint32)},
+     {"server.max_queue_wait_ms.cheap",
+      ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"server.max_queue_wait_ms.expensive",
+      ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
+     {"server.method_concurrency.[].method", Array{ConfigValue{ConfigType::String}}},
+     {"server.method_concurrency.[].max", Array{ConfigValue{ConfigType::Integer}.withConstraint(validateUint32)}},
+     {"server.request_deadline_ms", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint32)},
      {"server.local_admin", ConfigValue{ConfigType::Boolean}.optional()},
      {"server.admin_password", ConfigValue{ConfigType::String}.optional()},
+     {"server.ws_max_queue_messages",
+      ConfigValue{ConfigType::Integer}.defaultValue(10000).withConstraint(validateUint32)},
+     {"server.ws_max_queue_size_kb",
+      ConfigValue{ConfigType::Integer}.defaultValue(64 * 1024).withConstraint(validateUint32)},
+     {"server.ws_slow_client_policy",
+      ConfigValue{ConfigType::String}.defaultValue("disconnect").withConstraint(validateSlowClientPolicy)},
+     {"server.ws_permessage_deflate", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
+     {"server.ws_compression_level",
+      ConfigValue{ConfigType::Integer}.defaultValue(1).withConstraint(validateCompressionLevel)},
+     {"server.ws_compression_threshold",
+      ConfigValue{ConfigType::Integer}.defaultValue(1024).withConstraint(validateUint32)},
      {"prometheus.enabled", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
      {"prometheus.compress_reply", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
      {"io_threads", ConfigValue{ConfigType::Integer}.defaultValue(2).withConstraint(validateUint16)},
@@ -102,7 +133,13 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
      {"cache.num_cursors_from_account", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)
      },
      {"cache.page_fetch_size", ConfigValue{ConfigType::Integer}.defaultValue(512).withConstraint(validateUint16)},
+     {"cache.history_window", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)},
+     {"cache.snapshot_path", ConfigValue{ConfigType::String}.optional()},
+     {"cache.snapshot_interval", ConfigValue{ConfigType::Integer}.defaultValue(600).withConstraint(validateUint32)},
      {"cache.load", ConfigValue{ConfigType::String}.defaultValue("async").withConstraint(validateLoadMode)},
+     {"cache.ledger_headers", ConfigValue{ConfigType::Integer}.defaultValue(16384).withConstraint(validateUint32)},
+     {"close_time_index.path", ConfigValue{ConfigType::String}.optional()},
+     {"close_time_index.backfill_depth", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint32)},
      {"log_channels.[].channel", Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateChannelName)}},
      {"log_channels.[].log_level",
       Array{ConfigValue{ConfigType::String}.optional().withConstraint(validateLogLevelName)}},
@@ -118,7 +155,12 @@ static ClioConfigDefinition ClioConfig = ClioConfigDefinition{
       ConfigValue{ConfigType::Integer}.defaultValue(50u * 1024u).withConstraint(validateUint32)},
      {"log_rotation_hour_interval", ConfigValue{ConfigType::Integer}.defaultValue(12).withConstraint(validateUint32)},
      {"log_tag_style", ConfigValue{ConfigType::String}.defaultValue("uint").withConstraint(validateLogTag)},
+     {"log_async", ConfigValue{ConfigType::Boolean}.defaultValue(true)},
+     {"log_queue_size", ConfigValue{ConfigType::Integer}.defaultValue(64u * 1024u).withConstraint(validateUint32)},
+     {"log_queue_overflow",
+      ConfigValue{ConfigType::String}.defaultValue("block").withConstraint(validateLogQueueOverflow)},
      {"extractor_threads", ConfigValue{ConfigType::Integer}.defaultValue(2u).withConstraint(validateUint32)},
+     {"transformer_threads", ConfigValue{ConfigType::Integer}.defaultValue(4u).withConstraint(validateUint32)},
      {"read_only", ConfigValue{ConfigType::Boolean}.defaultValue(false)},
      {"txn_threshold", ConfigValue{ConfigType::Integer}.defaultValue(0).withConstraint(validateUint16)},
      {"start_sequence", ConfigValue{ConfigType::Integer}.optional().withConstraint(validateUint32)},
@@ -75,6 +75,9 @@ private:
         KV{"database.cassandra.core_connections_per_host", "Number of core connections per host for Cassandra."},
         KV{"database.cassandra.queue_size_io", "Queue size for I/O operations in Cassandra."},
         KV{"database.cassandra.write_batch_size", "Batch size for write operations in Cassandra."},
+        KV{"database.cassandra.read_batch_size",
+           "Number of keys per IN query for reads in Cassandra; 0 disables. IN queries fan out from the coordinator to "
+           "the replicas of every key: 10 to 50 keys save round trips, more than about 100 keys slow the coordinator."},
         KV{"etl_source.[].ip", "IP address of the ETL source."},
         KV{"etl_source.[].ws_port", "WebSocket port of the ETL source."},
         KV{"etl_source.[].grpc_port", "gRPC port of the ETL source."},
@@ -85,14 +88,41 @@ private:
         KV{"dos_guard.max_connections", "Maximum number of concurrent connections allowed by DOS guard."},
         KV{"dos_guard.max_requests", "Maximum number of requests allowed by DOS guard."},
         KV{"dos_guard.sweep_interval", "Interval in seconds for DOS guard to sweep/clear its state."},
+        KV{"dos_guard.rate_limiter",
+           "How the DOS guard refills the budgets of clients ('interval' resets them on every sweep, 'token_bucket' "
+           "refills them continuously)."},
+        KV{"dos_guard.max_method_cost", "Maximum cost of expensive methods allowed by DOS guard; 0 means no limit."},
+        KV{"dos_guard.method_weights.[].method", "Name of a method charged to the budget of expensive methods."},
+        KV{"dos_guard.method_weights.[].weight", "Cost of one call of the method."},
         KV{"cache.peers.[].ip", "IP address of peer nodes to cache."},
         KV{"cache.peers.[].port", "Port number of peer nodes to cache."},
         KV{"server.ip", "IP address of the Clio HTTP server."},
         KV{"server.port", "Port number of the Clio HTTP server."},
         KV{"server.max_queue_size", "Maximum size of the server's request queue."},
+        KV{"server.queue_weights.admin", "Share of the workers given to requests from admins."},
+        KV{"server.queue_weights.whitelisted", "Share of the workers given to requests from whitelisted clients."},
+        KV{"server.queue_weights.cheap", "Share of the workers given to requests of cheap methods."},
+        KV{"server.queue_weights.expensive", "Share of the workers given to requests of expensive methods."},
+        KV{"server.max_queue_wait_ms.cheap",
+           "Reject cheap requests while the oldest queued one waited longer (in milliseconds); 0 means no limit."},
+        KV{"server.max_queue_wait_ms.expensive",
+           "Reject expensive requests while the oldest queued one waited longer (in milliseconds); 0 means no limit."},
+        KV{"server.method_concurrency.[].method", "Name of a method with a concurrency cap."},
+        KV{"server.method_concurrency.[].max", "Maximum number of requests of the method executed at the same time."},
+        KV{"server.request_deadline_ms",
+           "Time in milliseconds after which a queued or running request is abandoned; 0 means no deadline."},
         KV{"server.workers", "Maximum number of threads for server to run with."},
         KV{"server.local_admin", "Indicates if the server should run with admin privileges."},
         KV{"server.admin_password", "Password for Clio admin-only APIs."},
+        KV{"server.ws_max_queue_messages", "Maximum number of messages queued for a websocket client."},
+        KV{"server.ws_max_queue_size_kb", "Maximum size in KB of the messages queued for a websocket client."},
+        KV{"server.ws_slow_client_policy",
+           "What to do when a websocket client exceeds its queue ('drop_oldest', 'coalesce_ledgers' or 'disconnect')."},
+        KV{"server.ws_permessage_deflate",
+           "Offer the permessage-deflate extension to websocket clients. A subscription message is compressed once and "
+           "shared by all subscribers that accept it."},
+        KV{"server.ws_compression_level", "Deflate level (0-9) of websocket messages."},
+        KV{"server.ws_compression_threshold", "Websocket messages smaller than this many bytes are sent uncompressed."},
         KV{"prometheus.enabled", "Enable or disable Prometheus metrics."},
         KV{"prometheus.compress_reply", "Enable or disable compression of Prometheus responses."},
         KV{"io_threads", "Number of I/O threads."},
@@ -101,7 +131,15 @@ private:
         KV{"cache.num_cursors_from_diff", "Num of cursors that are different."},
         KV{"cache.num_cursors_from_account", "Number of cursors from an account."},
         KV{"cache.page_fetch_size", "Page fetch size for cache operations."},
+        KV{"cache.history_window", "Number of past ledgers for which replaced and deleted objects stay in the cache."},
+        KV{"cache.snapshot_path", "File the cache is periodically saved to and restored from on startup."},
+        KV{"cache.snapshot_interval", "Interval in seconds between cache snapshots."},
         KV{"cache.load", "Cache loading strategy ('sync' or 'async')."},
+        KV{"cache.ledger_headers", "Number of ledger headers kept in memory; 0 disables the ledger header cache."},
+        KV{"close_time_index.path",
+           "File the ledger close time index is saved to on shutdown and restored from on startup."},
+        KV{"close_time_index.backfill_depth",
+           "Number of the newest ledgers whose close times are read from the database on startup; 100000 by default."},
         KV{"log_channels.[].channel", "Name of the log channel."},
         KV{"log_channels.[].log_level", "Log level for the log channel."},
         KV{"log_level", "General logging level of Clio."},
@@ -112,7 +150,11 @@ private:
         KV{"log_directory_max_size", "Maximum size of the log directory in megabytes."},
         KV{"log_rotation_hour_interval", "Interval in hours for log rotation."},
         KV{"log_tag_style", "Style for log tags."},
+        KV{"log_async", "Write console and file logs on a dedicated writer thread instead of the logging thread."},
+        KV{"log_queue_size", "Number of log records the queue of the log writer thread can hold."},
+        KV{"log_queue_overflow", "What to do with log records when the log queue is full: `block` or `drop`."},
         KV{"extractor_threads", "Number of extractor threads."},
+        KV{"transformer_threads", "Number of threads parsing the transactions of each new ledger."},
         KV{"read_only", "Indicates if the server should have read-only privileges."},
         KV{"txn_threshold", "Transaction threshold value."},
         KV{"start_sequence", "Starting ledger index."},
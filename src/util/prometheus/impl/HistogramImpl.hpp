@@ -20,13 +20,14 @@
 #pragma once
 
 #include "util/Assert.hpp"
+#include "util/Atomic.hpp"
 #include "util/Concepts.hpp"
 #include "util/prometheus/OStream.hpp"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#include <limits>
 #include <memory>
-#include <mutex>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -43,6 +44,13 @@ concept SomeHistogramImpl = requires(T t) {
     { t.serializeValue(std::string{}, std::string{}, std::declval<OStream&>()) } -> std::same_as<void>;
 };
 
+/**
+ * @brief The default histogram implementation.
+ *
+ * Observing a value does not take a lock: every bucket is an atomic counter, so observations from many threads only
+ * contend on the cache line of the bucket they hit. A concurrent serialization may see the sum and the counts of
+ * slightly different moments, which Prometheus tolerates.
+ */
 template <SomeNumberType NumberType>
 class HistogramImpl {
 public:
@@ -61,28 +69,18 @@ public:
     void
     setBuckets(std::vector<ValueType> const& bounds)
     {
-        std::scoped_lock const lock{*mutex_};
-        ASSERT(buckets_.empty(), "Buckets can be set only once.");
-        buckets_.reserve(bounds.size());
-        for (auto const& bound : bounds) {
-            buckets_.emplace_back(bound);
-        }
+        ASSERT(bounds_.empty(), "Buckets can be set only once.");
+        bounds_ = bounds;
+        // the last counter is the implicit +Inf bucket
+        counts_ = std::make_unique<Atomic<std::uint64_t>[]>(bounds_.size() + 1);
     }
 
     void
     observe(ValueType const value)
     {
-        auto const bucket =
-            std::lower_bound(buckets_.begin(), buckets_.end(), value, [](Bucket const& bucket, ValueType const& value) {
-                return bucket.upperBound < value;
-            });
-        std::scoped_lock const lock{*mutex_};
-        if (bucket != buckets_.end()) {
-            ++bucket->count;
-        } else {
-            ++lastBucket_.count;
-        }
-        sum_ += value;
+        auto const bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value);
+        counts_[static_cast<std::size_t>(bucket - bounds_.begin())].add(1);
+        sum_->add(value);
     }
 
     void
@@ -98,15 +96,13 @@ public:
             labelsString.back() = ',';
         }
 
-        std::scoped_lock const lock{*mutex_};
         std::uint64_t cumulativeCount = 0;
 
-        for (auto const& bucket : buckets_) {
-            cumulativeCount += bucket.count;
-            stream << name << "_bucket" << labelsString << "le=\"" << bucket.upperBound << "\"} " << cumulativeCount
-                   << '\n';
+        for (std::size_t i = 0; i < bounds_.size(); ++i) {
+            cumulativeCount += counts_[i].value();
+            stream << name << "_bucket" << labelsString << "le=\"" << bounds_[i] << "\"} " << cumulativeCount << '\n';
         }
-        cumulativeCount += lastBucket_.count;
+        cumulativeCount += counts_[bounds_.size()].value();
         stream << name << "_bucket" << labelsString << "le=\"+Inf\"} " << cumulativeCount << '\n';
 
         if (labelsString.size() == 1) {
@@ -114,24 +110,14 @@ public:
         } else {
             labelsString.back() = '}';
         }
-        stream << name << "_sum" << labelsString << " " << sum_ << '\n';
+        stream << name << "_sum" << labelsString << " " << sum_->value() << '\n';
         stream << name << "_count" << labelsString << " " << cumulativeCount << '\n';
     }
 
 private:
-    struct Bucket {
-        Bucket(ValueType upperBound) : upperBound(upperBound)
-        {
-        }
-
-        ValueType upperBound;
-        std::uint64_t count = 0;
-    };
-
-    std::vector<Bucket> buckets_;
-    Bucket lastBucket_{std::numeric_limits<ValueType>::max()};
-    ValueType sum_ = 0;
-    mutable std::unique_ptr<std::mutex> mutex_ = std::make_unique<std::mutex>();
+    std::vector<ValueType> bounds_;
+    std::unique_ptr<Atomic<std::uint64_t>[]> counts_;
+    AtomicPtr<ValueType> sum_ = std::make_unique<Atomic<ValueType>>(0);
 };
 
 }  // namespace util::prometheus::impl
@@ -22,6 +22,8 @@
 #include "util/Taggable.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/WsBase.hpp"
+#include "web/impl/WsFrameStream.hpp"
+#include "web/impl/WsSettings.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/asio/ip/tcp.hpp>
@@ -49,7 +51,7 @@ namespace web {
  */
 template <SomeServerHandler HandlerType>
 class PlainWsSession : public impl::WsBase<PlainWsSession, HandlerType> {
-    using StreamType = boost::beast::websocket::stream<boost::beast::tcp_stream>;
+    using StreamType = boost::beast::websocket::stream<impl::WsFrameStream<boost::beast::tcp_stream>>;
     StreamType ws_;
 
 public:
@@ -63,6 +65,7 @@ public:
      * @param handler The server handler to use
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges
+     * @param wsSettings The settings of the websocket session
      */
     explicit PlainWsSession(
         boost::asio::ip::tcp::socket&& socket,
@@ -71,9 +74,10 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
-        bool isAdmin
+        bool isAdmin,
+        impl::WsSettings const& wsSettings
     )
-        : impl::WsBase<PlainWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer))
+        : impl::WsBase<PlainWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer), wsSettings)
         , ws_(std::move(socket))
     {
         ConnectionBase::isAdmin_ = isAdmin;  // NOLINT(cppcoreguidelines-prefer-member-initializer)
@@ -107,6 +111,7 @@ class WsUpgrader : public std::enable_shared_from_this<WsUpgrader<HandlerType>>
     std::string ip_;
     std::shared_ptr<HandlerType> const handler_;
     bool isAdmin_;
+    impl::WsSettings wsSettings_;
 
 public:
     /**
@@ -120,6 +125,7 @@ public:
      * @param buffer Buffer with initial data received from the peer. Ownership is transferred
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
+     * @param wsSettings The settings of the websocket session
      */
     WsUpgrader(
         boost::beast::tcp_stream&& stream,
@@ -129,7 +135,8 @@ public:
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
-        bool isAdmin
+        bool isAdmin,
+        impl::WsSettings const& wsSettings
     )
         : http_(std::move(stream))
         , buffer_(std::move(buffer))
@@ -139,6 +146,7 @@ public:
         , ip_(std::move(ip))
         , handler_(handler)
         , isAdmin_(isAdmin)
+        , wsSettings_(wsSettings)
     {
     }
 
@@ -175,7 +183,7 @@ private:
         boost::beast::get_lowest_layer(http_).expires_never();
 
         std::make_shared<PlainWsSession<HandlerType>>(
-            http_.release_socket(), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_
+            http_.release_socket(), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_, wsSettings_
         )
             ->run(std::move(req_));
     }
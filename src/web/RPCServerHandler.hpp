@@ -24,6 +24,7 @@
 #include "rpc/Factories.hpp"
 #include "rpc/JS.hpp"
 #include "rpc/RPCHelpers.hpp"
+#include "rpc/common/Types.hpp"
 #include "rpc/common/impl/APIVersionParser.hpp"
 #include "util/JsonUtils.hpp"
 #include "util/Profiler.hpp"
@@ -33,6 +34,7 @@
 #include "web/impl/ErrorHandling.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
+#include <boost/asio/cancellation_type.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/beast/core/error.hpp>
 #include <boost/json/array.hpp>
@@ -108,11 +110,14 @@ public:
             if (not connection->upgraded and shouldReplaceParams(req))
                 req[JS(params)] = boost::json::array({boost::json::object{}});
 
+            auto const method = methodName(req);
             if (!rpcEngine_->post(
                     [this, request = std::move(req), connection](boost::asio::yield_context yield) mutable {
                         handleRequest(yield, std::move(request), connection);
                     },
-                    connection->clientIp
+                    connection->clientIp,
+                    method,
+                    connection->isAdmin()
                 )) {
                 rpcEngine_->notifyTooBusy();
                 web::impl::ErrorHelper(connection).sendTooBusyError();
@@ -146,6 +151,14 @@ private:
                          << " received request from work queue: " << util::removeSecret(request)
                          << " ip = " << connection->clientIp;
 
+        if (yield.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none) {
+            // the request passed its deadline while it was waiting in the work queue
+            LOG(perfLog_.warn()) << connection->tag() << "Request expired in the work queue";
+            rpcEngine_->notifyTooBusy();
+            web::impl::ErrorHelper(connection, std::move(request)).sendTooBusyError();
+            return;
+        }
+
         try {
             auto const range = backend_->fetchLedgerRange();
             if (!range) {
@@ -192,10 +205,12 @@ private:
                 return;
             }
 
-            auto [result, timeDiff] = util::timed([&]() { return rpcEngine_->buildResponse(*context); });
+            auto [result, timeDiff] =
+                util::timed<std::chrono::microseconds>([&]() { return rpcEngine_->buildResponse(*context); });
 
-            auto us = std::chrono::duration<int, std::milli>(timeDiff);
+            auto const us = std::chrono::microseconds(timeDiff);
             rpc::logDuration(*context, us);
+            auto const serializationStart = std::chrono::steady_clock::now();
 
             boost::json::object response;
 
@@ -210,26 +225,31 @@ private:
                 // This can still technically be an error. Clio counts forwarded requests as successful.
                 rpcEngine_->notifyComplete(context->method, us);
 
-                auto& json = std::get<boost::json::object>(result.response);
-                auto const isForwarded =
-                    json.contains("forwarded") && json.at("forwarded").is_bool() && json.at("forwarded").as_bool();
-
-                if (isForwarded)
-                    json.erase("forwarded");
-
-                // if the result is forwarded - just use it as is
-                // if forwarded request has error, for http, error should be in "result"; for ws, error should
-                // be at top
-                if (isForwarded && (json.contains(JS(result)) || connection->upgraded)) {
-                    for (auto const& [k, v] : json)
-                        response.insert_or_assign(k, v);
+                if (auto const shared = std::get_if<std::shared_ptr<rpc::ReturnType const>>(&result.response)) {
+                    // shared with the ledger response cache, which only holds responses computed locally
+                    response[JS(result)] = (*shared)->result->as_object();
                 } else {
-                    response[JS(result)] = json;
+                    auto& json = std::get<boost::json::object>(result.response);
+                    auto const isForwarded = json.contains("forwarded") && json.at("forwarded").is_bool() &&
+                        json.at("forwarded").as_bool();
+
+                    if (isForwarded)
+                        json.erase("forwarded");
+
+                    // if the result is forwarded - just use it as is
+                    // if forwarded request has error, for http, error should be in "result"; for ws, error should
+                    // be at top
+                    if (isForwarded && (json.contains(JS(result)) || connection->upgraded)) {
+                        for (auto const& [k, v] : json)
+                            response.insert_or_assign(k, v);
+                    } else {
+                        response[JS(result)] = json;
+                    }
+
+                    if (isForwarded)
+                        response["forwarded"] = true;
                 }
 
-                if (isForwarded)
-                    response["forwarded"] = true;
-
                 // for ws there is an additional field "status" in the response,
                 // otherwise the "status" is in the "result" field
                 if (connection->upgraded) {
@@ -258,7 +278,15 @@ private:
                 warnings.emplace_back(rpc::makeWarning(rpc::warnRPC_OUTDATED));
 
             response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+            connection->send(std::move(response));
+
+            // large responses are streamed, for them this covers the first chunk only
+            rpcEngine_->notifySerialized(
+                context->method,
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - serializationStart
+                )
+            );
         } catch (std::exception const& ex) {
             // note: while we are catching this in buildResponse too, this is here to make sure
             // that any other code that may throw is outside of buildResponse is also worked around.
@@ -292,6 +320,17 @@ private:
         return not hasParams or paramsIsEmptyString or paramsIsNull or paramsIsEmptyObject or arrayIsEmpty or
             firstArgIsEmptyString or firstArgIsNull;
     }
+
+    static std::string
+    methodName(boost::json::object const& req)
+    {
+        // the context factories validate the request; this is only used to pick the work queue lane
+        for (auto const* key : {"command", "method"}) {
+            if (auto const* value = req.if_contains(key); value != nullptr and value->is_string())
+                return std::string{value->as_string()};
+        }
+        return {};
+    }
 };
 
 }  // namespace web
@@ -22,6 +22,8 @@
 #include "util/Taggable.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/WsBase.hpp"
+#include "web/impl/WsFrameStream.hpp"
+#include "web/impl/WsSettings.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
 #include <boost/beast/core/flat_buffer.hpp>
@@ -50,7 +52,8 @@ namespace web {
  */
 template <SomeServerHandler HandlerType>
 class SslWsSession : public impl::WsBase<SslWsSession, HandlerType> {
-    using StreamType = boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>>;
+    using StreamType =
+        boost::beast::websocket::stream<impl::WsFrameStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>>;
     StreamType ws_;
 
 public:
@@ -64,6 +67,7 @@ public:
      * @param handler The server handler to use
      * @param buffer Buffer with initial data received from the peer
      * @param isAdmin Whether the connection has admin privileges
+     * @param wsSettings The settings of the websocket session
      */
     explicit SslWsSession(
         boost::beast::ssl_stream<boost::beast::tcp_stream>&& stream,
@@ -72,9 +76,10 @@ public:
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
         boost::beast::flat_buffer&& buffer,
-        bool isAdmin
+        bool isAdmin,
+        impl::WsSettings const& wsSettings
     )
-        : impl::WsBase<SslWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer))
+        : impl::WsBase<SslWsSession, HandlerType>(ip, tagFactory, dosGuard, handler, std::move(buffer), wsSettings)
         , ws_(std::move(stream))
     {
         ConnectionBase::isAdmin_ = isAdmin;  // NOLINT(cppcoreguidelines-prefer-member-initializer)
@@ -106,6 +111,7 @@ class SslWsUpgrader : public std::enable_shared_from_this<SslWsUpgrader<HandlerT
     std::shared_ptr<HandlerType> const handler_;
     http::request<http::string_body> req_;
     bool isAdmin_;
+    impl::WsSettings wsSettings_;
 
 public:
     /**
@@ -119,6 +125,7 @@ public:
      * @param buffer Buffer with initial data received from the peer. Ownership is transferred
      * @param request The request. Ownership is transferred
      * @param isAdmin Whether the connection has admin privileges
+     * @param wsSettings The settings of the websocket session
      */
     SslWsUpgrader(
         boost::beast::ssl_stream<boost::beast::tcp_stream> stream,
@@ -128,7 +135,8 @@ public:
         std::shared_ptr<HandlerType> handler,
         boost::beast::flat_buffer&& buffer,
         http::request<http::string_body> request,
-        bool isAdmin
+        bool isAdmin,
+        impl::WsSettings const& wsSettings
     )
         : https_(std::move(stream))
         , buffer_(std::move(buffer))
@@ -138,6 +146,7 @@ public:
         , handler_(std::move(handler))
         , req_(std::move(request))
         , isAdmin_(isAdmin)
+        , wsSettings_(wsSettings)
     {
     }
 
@@ -179,7 +188,7 @@ private:
         boost::beast::get_lowest_layer(https_).expires_never();
 
         std::make_shared<SslWsSession<HandlerType>>(
-            std::move(https_), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_
+            std::move(https_), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_), isAdmin_, wsSettings_
         )
             ->run(std::move(req_));
     }
@@ -22,24 +22,53 @@
 #include "util/Assert.hpp"
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
+#include "web/dosguard/TokenBucket.hpp"
 #include "web/dosguard/WhitelistHandlerInterface.hpp"
 
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/address_v6.hpp>
 #include <boost/iterator/transform_iterator.hpp>
+#include <boost/system/error_code.hpp>
+#include <fmt/core.h>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace web::dosguard {
 
+namespace {
+
+// relative cost of the handlers that read the most data; every other method is free
+std::unordered_map<std::string, std::uint32_t> const DEFAULT_METHOD_WEIGHTS{
+    {"account_tx", 10},
+    {"nft_history", 10},
+    {"nfts_by_issuer", 10},
+    {"ledger_data", 10},
+    {"book_offers", 5},
+    {"account_objects", 5},
+};
+
+}  // namespace
+
 DOSGuard::DOSGuard(util::Config const& config, WhitelistHandlerInterface const& whitelistHandler)
     : whitelistHandler_{std::cref(whitelistHandler)}
     , maxFetches_{config.valueOr("dos_guard.max_fetches", DEFAULT_MAX_FETCHES)}
     , maxConnCount_{config.valueOr("dos_guard.max_connections", DEFAULT_MAX_CONNECTIONS)}
     , maxRequestCount_{config.valueOr("dos_guard.max_requests", DEFAULT_MAX_REQUESTS)}
+    , maxMethodCost_{config.valueOr("dos_guard.max_method_cost", DEFAULT_MAX_METHOD_COST)}
+    , rateLimiter_{getRateLimiter(config)}
+    , sweepIntervalSeconds_{std::max(0.001, config.valueOr("dos_guard.sweep_interval", 1.0))}
+    , methodWeights_{getMethodWeights(config)}
 {
 }
 
@@ -55,26 +84,10 @@ DOSGuard::isOk(std::string const& ip) const noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        if (ipState_.find(ip) != ipState_.end()) {
-            auto [transferedByte, requests] = ipState_.at(ip);
-            if (transferedByte > maxFetches_ || requests > maxRequestCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Transfered Byte: " << transferedByte << "; Requests: " << requests;
-                return false;
-            }
-        }
-        auto it = ipConnCount_.find(ip);
-        if (it != ipConnCount_.end()) {
-            if (it->second > maxConnCount_) {
-                LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
-                                 << " Concurrent connection: " << it->second;
-                return false;
-            }
-        }
-    }
-    return true;
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    std::scoped_lock const lck(shard.mtx);
+    return isOk(ip, key, shard, TokenBucket::ClockType::now());
 }
 
 void
@@ -82,8 +95,11 @@ DOSGuard::increment(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    std::scoped_lock const lck{mtx_};
-    ipConnCount_[ip]++;
+
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    std::scoped_lock const lck{shard.mtx};
+    shard.ipConnCount[key]++;
 }
 
 void
@@ -91,11 +107,15 @@ DOSGuard::decrement(std::string const& ip) noexcept
 {
     if (whitelistHandler_.get().isWhiteListed(ip))
         return;
-    std::scoped_lock const lck{mtx_};
-    ASSERT(ipConnCount_[ip] > 0, "Connection count for ip {} can't be 0", ip);
-    ipConnCount_[ip]--;
-    if (ipConnCount_[ip] == 0)
-        ipConnCount_.erase(ip);
+
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    std::scoped_lock const lck{shard.mtx};
+    auto& count = shard.ipConnCount[key];
+    ASSERT(count > 0, "Connection count for ip {} can't be 0", ip);
+    count--;
+    if (count == 0)
+        shard.ipConnCount.erase(key);
 }
 
 [[maybe_unused]] bool
@@ -104,12 +124,12 @@ DOSGuard::add(std::string const& ip, uint32_t numObjects) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].transferedByte += numObjects;
-    }
-
-    return isOk(ip);
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    auto const now = TokenBucket::ClockType::now();
+    std::scoped_lock const lck(shard.mtx);
+    stateFor(key, shard, now).transferedBytes.consume(numObjects, now);
+    return isOk(ip, key, shard, now);
 }
 
 [[maybe_unused]] bool
@@ -118,19 +138,169 @@ DOSGuard::request(std::string const& ip) noexcept
     if (whitelistHandler_.get().isWhiteListed(ip))
         return true;
 
-    {
-        std::scoped_lock const lck(mtx_);
-        ipState_[ip].requestsCount++;
-    }
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    auto const now = TokenBucket::ClockType::now();
+    std::scoped_lock const lck(shard.mtx);
+    stateFor(key, shard, now).requests.consume(1, now);
+    return isOk(ip, key, shard, now);
+}
+
+[[maybe_unused]] bool
+DOSGuard::requestMethod(std::string const& ip, std::string_view method) noexcept
+{
+    if (maxMethodCost_ == 0 or whitelistHandler_.get().isWhiteListed(ip))
+        return true;
 
-    return isOk(ip);
+    auto const weight = methodWeight(method);
+    if (weight == 0)
+        return true;
+
+    auto const key = makeKey(ip);
+    auto& shard = shardFor(key);
+    auto const now = TokenBucket::ClockType::now();
+    std::scoped_lock const lck(shard.mtx);
+    stateFor(key, shard, now).methodCost.consume(weight, now);
+    return isOk(ip, key, shard, now);
+}
+
+[[nodiscard]] std::uint32_t
+DOSGuard::methodWeight(std::string_view method) const
+{
+    auto const it = methodWeights_.find(method);
+    return it == methodWeights_.end() ? 0 : it->second;
 }
 
 void
 DOSGuard::clear() noexcept
 {
-    std::scoped_lock const lck(mtx_);
-    ipState_.clear();
+    auto const now = TokenBucket::ClockType::now();
+    for (auto& shard : shards_) {
+        std::scoped_lock const lck(shard.mtx);
+        if (rateLimiter_ == RateLimiter::Interval) {
+            shard.ipState.clear();
+            continue;
+        }
+
+        // the buckets refill on their own; a client with full buckets is the same as a client never seen
+        std::erase_if(shard.ipState, [now](auto const& entry) {
+            auto const& state = entry.second;
+            return state.transferedBytes.isFull(now) and state.requests.isFull(now) and state.methodCost.isFull(now);
+        });
+    }
+}
+
+std::size_t
+DOSGuard::ClientKeyHash::operator()(ClientKey const& key) const noexcept
+{
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+    std::memcpy(&high, key.data(), sizeof(high));
+    std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+
+    // the low half holds a whole IPv4 address; mixing both halves spreads neighbouring addresses over the shards
+    auto hash = (high * 0x9E3779B97F4A7C15ull) ^ low;
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return static_cast<std::size_t>(hash);
+}
+
+std::size_t
+DOSGuard::MethodNameHash::operator()(std::string_view method) const noexcept
+{
+    return std::hash<std::string_view>{}(method);
+}
+
+[[nodiscard]] DOSGuard::ClientKey
+DOSGuard::makeKey(std::string const& ip) noexcept
+{
+    boost::system::error_code ec;
+    auto const address = boost::asio::ip::make_address(ip, ec);
+    if (not ec) {
+        return address.is_v4()
+            ? boost::asio::ip::make_address_v6(boost::asio::ip::v4_mapped, address.to_v4()).to_bytes()
+            : address.to_v6().to_bytes();
+    }
+
+    // connections always carry a valid address; anything else still gets a stable key
+    ClientKey key{};
+    auto const hash = std::hash<std::string>{}(ip);
+    std::memcpy(key.data(), &hash, sizeof(hash));
+    key.back() = 0xFF;
+    return key;
+}
+
+[[nodiscard]] DOSGuard::Shard&
+DOSGuard::shardFor(ClientKey const& key) const noexcept
+{
+    return shards_[ClientKeyHash{}(key) & (NUM_SHARDS - 1)];
+}
+
+[[nodiscard]] DOSGuard::ClientState&
+DOSGuard::stateFor(ClientKey const& key, Shard& shard, TokenBucket::ClockType::time_point now) const
+{
+    if (auto const it = shard.ipState.find(key); it != shard.ipState.end())
+        return it->second;
+
+    // with the interval rate limiter the budgets are only refilled by clear()
+    auto const makeBucket = [&](std::uint32_t capacity) {
+        auto const refillPerSecond = rateLimiter_ == RateLimiter::TokenBucket ? capacity / sweepIntervalSeconds_ : 0.0;
+        return TokenBucket{static_cast<double>(capacity), refillPerSecond, now};
+    };
+
+    return shard.ipState
+        .emplace(key, ClientState{makeBucket(maxFetches_), makeBucket(maxRequestCount_), makeBucket(maxMethodCost_)})
+        .first->second;
+}
+
+[[nodiscard]] bool
+DOSGuard::isOk(std::string const& ip, ClientKey const& key, Shard const& shard, TokenBucket::ClockType::time_point now)
+    const noexcept
+{
+    if (auto const it = shard.ipState.find(key); it != shard.ipState.end()) {
+        auto const& state = it->second;
+        auto const methodCostExhausted = maxMethodCost_ != 0 and state.methodCost.isExhausted(now);
+        if (state.transferedBytes.isExhausted(now) || state.requests.isExhausted(now) || methodCostExhausted) {
+            LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                             << " Transfered Byte: " << state.transferedBytes.used(now)
+                             << "; Requests: " << state.requests.used(now)
+                             << "; Method cost: " << state.methodCost.used(now);
+            return false;
+        }
+    }
+
+    if (auto const it = shard.ipConnCount.find(key); it != shard.ipConnCount.end()) {
+        if (it->second > maxConnCount_) {
+            LOG(log_.warn()) << "Dosguard: Client surpassed the rate limit. ip = " << ip
+                             << " Concurrent connection: " << it->second;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+[[nodiscard]] DOSGuard::RateLimiter
+DOSGuard::getRateLimiter(util::Config const& config)
+{
+    auto const rateLimiter = config.valueOr<std::string>("dos_guard.rate_limiter", "interval");
+    if (rateLimiter == "interval")
+        return RateLimiter::Interval;
+    if (rateLimiter == "token_bucket")
+        return RateLimiter::TokenBucket;
+
+    throw std::logic_error(fmt::format("Unknown DOS guard rate limiter: {}", rateLimiter));
+}
+
+[[nodiscard]] DOSGuard::MethodWeights
+DOSGuard::getMethodWeights(util::Config const& config)
+{
+    MethodWeights weights{DEFAULT_METHOD_WEIGHTS.begin(), DEFAULT_METHOD_WEIGHTS.end()};
+    for (auto const& entry : config.arrayOr("dos_guard.method_weights", {}))
+        weights[entry.value<std::string>("method")] = entry.value<std::uint32_t>("weight");
+
+    return weights;
 }
 
 [[nodiscard]] std::unordered_set<std::string>
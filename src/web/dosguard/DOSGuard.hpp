@@ -22,12 +22,16 @@
 #include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/dosguard/TokenBucket.hpp"
 #include "web/dosguard/WhitelistHandlerInterface.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <array>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <mutex>
@@ -41,37 +45,80 @@ namespace web::dosguard {
 /**
  * @brief A simple denial of service guard used for rate limiting.
  *
- * @tparam WhitelistHandlerType The type of the whitelist handler
+ * Clients are identified by their binary IPv6 address (IPv4 addresses are mapped into IPv6) and spread over
+ * NUM_SHARDS independently locked shards, so requests from different clients rarely wait for each other.
+ *
+ * Every client has a budget of requests, response bytes and cost of expensive methods per sweep interval. With the
+ * interval rate limiter the budgets are reset by each sweep. With the token bucket rate limiter they are refilled
+ * continuously at the same average rate and sweeps only forget clients whose budgets are full again.
  */
 class DOSGuard : public DOSGuardInterface {
+public:
+    static constexpr std::size_t NUM_SHARDS = 64; /**< Number of shards; must be a power of two */
+
+    /**
+     * @brief How the budgets of clients are refilled.
+     */
+    enum class RateLimiter { Interval, TokenBucket };
+
+private:
     /**
-     * @brief Accumulated state per IP, state will be reset accordingly
+     * @brief Remaining budgets per IP, state will be reset accordingly
      */
     struct ClientState {
-        std::uint32_t transferedByte = 0; /**< Accumulated transferred byte */
-        std::uint32_t requestsCount = 0;  /**< Accumulated served requests count */
+        TokenBucket transferedBytes; /**< Budget of transferred bytes */
+        TokenBucket requests;        /**< Budget of served requests */
+        TokenBucket methodCost;      /**< Budget of the cost of expensive methods */
+    };
+
+    using ClientKey = std::array<unsigned char, 16>;
+
+    struct ClientKeyHash {
+        std::size_t
+        operator()(ClientKey const& key) const noexcept;
     };
 
-    mutable std::mutex mtx_;
-    std::unordered_map<std::string, ClientState> ipState_;
-    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
+    // transparent, so that weights are looked up by the method name of a request without copying it
+    struct MethodNameHash {
+        using is_transparent = void;
+
+        std::size_t
+        operator()(std::string_view method) const noexcept;
+    };
+
+    using MethodWeights = std::unordered_map<std::string, std::uint32_t, MethodNameHash, std::equal_to<>>;
+
+    // each shard lives on its own cache line so that locking one does not slow down its neighbours
+    struct alignas(64) Shard {
+        std::mutex mtx;
+        std::unordered_map<ClientKey, ClientState, ClientKeyHash> ipState;
+        std::unordered_map<ClientKey, std::uint32_t, ClientKeyHash> ipConnCount;
+    };
+
+    mutable std::array<Shard, NUM_SHARDS> shards_;
     std::reference_wrapper<WhitelistHandlerInterface const> whitelistHandler_;
 
     std::uint32_t const maxFetches_;
     std::uint32_t const maxConnCount_;
     std::uint32_t const maxRequestCount_;
+    std::uint32_t const maxMethodCost_;
+    RateLimiter const rateLimiter_;
+    double const sweepIntervalSeconds_;
+    MethodWeights methodWeights_;
     util::Logger log_{"RPC"};
 
 public:
     static constexpr std::uint32_t DEFAULT_MAX_FETCHES = 1000'000u; /**< Default maximum fetches per sweep */
     static constexpr std::uint32_t DEFAULT_MAX_CONNECTIONS = 20u;   /**< Default maximum concurrent connections */
     static constexpr std::uint32_t DEFAULT_MAX_REQUESTS = 20u;      /**< Default maximum requests per sweep */
+    static constexpr std::uint32_t DEFAULT_MAX_METHOD_COST = 0u;    /**< Default maximum method cost; 0 is no limit */
 
     /**
      * @brief Constructs a new DOS guard.
      *
      * @param config Clio config
      * @param whitelistHandler Whitelist handler that checks whitelist for IP addresses
+     * @throws std::logic_error if the configured rate limiter is unknown
      */
     DOSGuard(util::Config const& config, WhitelistHandlerInterface const& whitelistHandler);
 
@@ -140,13 +187,57 @@ public:
     [[maybe_unused]] bool
     request(std::string const& ip) noexcept override;
 
+    /**
+     * @brief Charges the cost of an RPC method to the given ip address.
+     *
+     * Methods without a configured weight are free. If the total cost sums up to a value larger than maxMethodCost_
+     * the operation is no longer allowed and false is returned; true is returned otherwise.
+     *
+     * @param ip
+     * @param method The name of the method
+     * @return true
+     * @return false
+     */
+    [[maybe_unused]] bool
+    requestMethod(std::string const& ip, std::string_view method) noexcept override;
+
+    /**
+     * @brief The weight of a method in the budget of expensive methods.
+     *
+     * @param method The name of the method
+     * @return The weight; 0 if the method is not expensive
+     */
+    [[nodiscard]] std::uint32_t
+    methodWeight(std::string_view method) const override;
+
     /**
      * @brief Instantly clears all fetch counters added by @see add(std::string const&, uint32_t).
+     *
+     * Shards are swept one after another, so only the clients of the shard being swept wait for it.
      */
     void
     clear() noexcept override;
 
 private:
+    [[nodiscard]] static ClientKey
+    makeKey(std::string const& ip) noexcept;
+
+    [[nodiscard]] Shard&
+    shardFor(ClientKey const& key) const noexcept;
+
+    [[nodiscard]] ClientState&
+    stateFor(ClientKey const& key, Shard& shard, TokenBucket::ClockType::time_point now) const;
+
+    [[nodiscard]] bool
+    isOk(std::string const& ip, ClientKey const& key, Shard const& shard, TokenBucket::ClockType::time_point now)
+        const noexcept;
+
+    [[nodiscard]] static RateLimiter
+    getRateLimiter(util::Config const& config);
+
+    [[nodiscard]] static MethodWeights
+    getMethodWeights(util::Config const& config);
+
     [[nodiscard]] static std::unordered_set<std::string>
     getWhitelist(util::Config const& config);
 };
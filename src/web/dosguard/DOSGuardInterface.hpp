@@ -105,6 +105,26 @@ public:
      */
     [[maybe_unused]] virtual bool
     request(std::string const& ip) noexcept = 0;
+
+    /**
+     * @brief Charges the cost of an RPC method to the given ip address.
+     *
+     * @param ip
+     * @param method The name of the method
+     * @return If the total cost of expensive methods sums up to a value larger than maxMethodCost_
+     * the operation is no longer allowed and false is returned; true is returned otherwise.
+     */
+    [[maybe_unused]] virtual bool
+    requestMethod(std::string const& ip, std::string_view method) noexcept = 0;
+
+    /**
+     * @brief The weight of a method in the budget of expensive methods.
+     *
+     * @param method The name of the method
+     * @return The weight; 0 if the method is not expensive
+     */
+    [[nodiscard]] virtual std::uint32_t
+    methodWeight(std::string_view method) const = 0;
 };
 
 }  // namespace web::dosguard
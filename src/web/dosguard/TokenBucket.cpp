@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/dosguard/TokenBucket.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace web::dosguard {
+
+TokenBucket::TokenBucket(double capacity, double refillPerSecond, ClockType::time_point now)
+    : capacity_{capacity}, refillPerSecond_{refillPerSecond}, tokens_{capacity}, lastRefill_{now}
+{
+}
+
+void
+TokenBucket::consume(double amount, ClockType::time_point now)
+{
+    tokens_ = available(now) - amount;
+    lastRefill_ = std::max(lastRefill_, now);
+}
+
+double
+TokenBucket::available(ClockType::time_point now) const
+{
+    if (now <= lastRefill_)
+        return tokens_;
+
+    auto const elapsed = std::chrono::duration<double>(now - lastRefill_).count();
+    return std::min(capacity_, tokens_ + elapsed * refillPerSecond_);
+}
+
+bool
+TokenBucket::isExhausted(ClockType::time_point now) const
+{
+    return available(now) < 0;
+}
+
+bool
+TokenBucket::isFull(ClockType::time_point now) const
+{
+    return available(now) >= capacity_;
+}
+
+double
+TokenBucket::used(ClockType::time_point now) const
+{
+    return capacity_ - available(now);
+}
+
+}  // namespace web::dosguard
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <chrono>
+
+namespace web::dosguard {
+
+/**
+ * @brief A token bucket that refills continuously.
+ *
+ * The bucket starts full. Consuming may take the bucket below zero so that a client that went over its budget has
+ * to wait until the debt is paid off. A bucket with a refill rate of zero is only refilled by replacing it.
+ */
+class TokenBucket {
+public:
+    using ClockType = std::chrono::steady_clock;
+
+private:
+    double capacity_;
+    double refillPerSecond_;
+    double tokens_;
+    ClockType::time_point lastRefill_;
+
+public:
+    /**
+     * @brief Construct a full bucket.
+     *
+     * @param capacity The maximum number of tokens
+     * @param refillPerSecond The number of tokens added every second
+     * @param now The current time
+     */
+    TokenBucket(double capacity, double refillPerSecond, ClockType::time_point now);
+
+    /**
+     * @brief Take tokens from the bucket.
+     *
+     * @param amount The number of tokens to take
+     * @param now The current time
+     */
+    void
+    consume(double amount, ClockType::time_point now);
+
+    /**
+     * @brief The number of tokens in the bucket.
+     *
+     * @param now The current time
+     * @return The number of tokens; negative if more tokens were consumed than available
+     */
+    [[nodiscard]] double
+    available(ClockType::time_point now) const;
+
+    /**
+     * @brief Whether more tokens were consumed than the bucket could provide.
+     *
+     * @param now The current time
+     * @return true if the bucket is below zero; false otherwise
+     */
+    [[nodiscard]] bool
+    isExhausted(ClockType::time_point now) const;
+
+    /**
+     * @brief Whether the bucket is full again.
+     *
+     * @param now The current time
+     * @return true if no tokens are missing; false otherwise
+     */
+    [[nodiscard]] bool
+    isFull(ClockType::time_point now) const;
+
+    /**
+     * @brief The number of tokens missing from a full bucket.
+     *
+     * @param now The current time
+     * @return The number of tokens consumed and not refilled yet
+     */
+    [[nodiscard]] double
+    used(ClockType::time_point now) const;
+};
+
+}  // namespace web::dosguard
@@ -26,6 +26,8 @@
 #include "util/prometheus/Http.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
 #include "web/impl/AdminVerificationStrategy.hpp"
+#include "web/impl/JsonStreamer.hpp"
+#include "web/impl/LoadWarning.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
 
@@ -45,7 +47,7 @@
 #include <boost/beast/ssl.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/json.hpp>
-#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/ErrorCodes.h>
@@ -56,6 +58,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 namespace web::impl {
@@ -108,6 +111,8 @@ class HttpBase : public ConnectionBase {
     };
 
     std::shared_ptr<void> res_;
+    std::shared_ptr<JsonStreamer> stream_;
+    std::size_t streamAccounted_ = 0;
     SendLambda sender_;
     std::shared_ptr<AdminVerificationStrategy> adminVerification_;
 
@@ -262,12 +267,7 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size())) {
             auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+            addLoadWarning(jsonResponse);
 
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
@@ -275,11 +275,47 @@ public:
         sender_(httpResponse(status, "application/json", std::move(msg)));
     }
 
+    /**
+     * @brief Send a JSON response to the client
+     * Responses that fit into one JsonStreamer chunk are sent like a string. Larger responses are written with chunked
+     * transfer encoding while they are serialized. Only the first chunk is known when the DOSGuard decides whether to
+     * add a warning; the rest of the response is added to the DOSGuard once it is written.
+     */
+    void
+    send(boost::json::object&& msg, http::status status = http::status::ok) override
+    {
+        auto streamer = std::make_shared<JsonStreamer>(std::move(msg));
+        if (auto const chunk = streamer->read(); streamer->done())
+            return send(std::string{chunk}, status);
+
+        streamAccounted_ = streamer->size();
+        if (!dosGuard_.get().add(clientIp, streamAccounted_)) {
+            streamer->restart(&addLoadWarning);
+            streamer->read();
+        }
+
+        http::response<JsonStreamBody> res{status, req_.version()};
+        res.set(http::field::server, "clio-server-" + util::build::getClioVersionString());
+        res.set(http::field::content_type, "application/json");
+        res.keep_alive(req_.keep_alive());
+        res.body() = streamer;
+        res.prepare_payload();
+
+        stream_ = std::move(streamer);
+        sender_(std::move(res));
+    }
+
     void
     onWrite(bool close, boost::beast::error_code ec, std::size_t bytes_transferred)
     {
         boost::ignore_unused(bytes_transferred);
 
+        if (stream_ != nullptr) {
+            if (stream_->size() > streamAccounted_)
+                dosGuard_.get().add(clientIp, stream_->size() - streamAccounted_);
+            stream_ = nullptr;
+        }
+
         if (ec)
             return httpFail(ec, "write");
 
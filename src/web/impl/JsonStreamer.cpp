@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/JsonStreamer.hpp"
+
+#include <boost/json/object.hpp>
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+namespace web::impl {
+
+JsonStreamer::JsonStreamer(boost::json::object&& object) : value_(std::move(object))
+{
+    serializer_.reset(&value_);
+}
+
+std::string_view
+JsonStreamer::read()
+{
+    if (serializer_.done())
+        return chunk_ = {};
+
+    chunk_ = serializer_.read(buffer_.data(), buffer_.size());
+    size_ += chunk_.size();
+    return chunk_;
+}
+
+std::string_view
+JsonStreamer::current() const
+{
+    return chunk_;
+}
+
+bool
+JsonStreamer::done() const
+{
+    return serializer_.done();
+}
+
+std::size_t
+JsonStreamer::size() const
+{
+    return size_;
+}
+
+}  // namespace web::impl
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/value.hpp>
+#include <boost/optional/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace web::impl {
+
+/**
+ * @brief Serializes a JSON document piece by piece into a fixed size buffer.
+ *
+ * Used to send large responses without building the whole serialized string first: the memory used on top of the
+ * document itself is bounded by CHUNK_SIZE and the first part can be sent while the rest is not serialized yet.
+ * The streamer owns the document and must not be moved once reading started, so it is always kept in a smart pointer.
+ */
+class JsonStreamer {
+public:
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+
+private:
+    boost::json::value value_;
+    boost::json::serializer serializer_;
+    std::array<char, CHUNK_SIZE> buffer_{};
+    std::string_view chunk_;
+    std::size_t size_ = 0;
+
+public:
+    /**
+     * @brief Construct a streamer for the given document.
+     *
+     * @param object The document to serialize
+     */
+    explicit JsonStreamer(boost::json::object&& object);
+
+    JsonStreamer(JsonStreamer const&) = delete;
+    JsonStreamer&
+    operator=(JsonStreamer const&) = delete;
+
+    /**
+     * @brief Serialize the next part of the document.
+     *
+     * @return The next part; points into the internal buffer and is valid until the next call to read or restart
+     */
+    std::string_view
+    read();
+
+    /**
+     * @brief The part returned by the last call to read.
+     *
+     * @return The current part; empty if nothing was read yet
+     */
+    [[nodiscard]] std::string_view
+    current() const;
+
+    /**
+     * @brief Whether the whole document was serialized.
+     *
+     * @return true if the last call to read returned the final part; false otherwise
+     */
+    [[nodiscard]] bool
+    done() const;
+
+    /**
+     * @brief The number of bytes serialized so far.
+     *
+     * @return The total size of all parts read
+     */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /**
+     * @brief Modify the document and start serializing it from the beginning.
+     *
+     * @param fn Called with the document before serialization restarts
+     */
+    template <typename FnType>
+    void
+    restart(FnType&& fn)
+    {
+        std::forward<FnType>(fn)(value_.as_object());
+        serializer_.reset(&value_);
+        chunk_ = {};
+        size_ = 0;
+    }
+};
+
+/**
+ * @brief A Beast body that writes a JsonStreamer part by part.
+ *
+ * The body has no known size so prepare_payload uses chunked transfer encoding for HTTP/1.1 clients and closes the
+ * connection after the response for HTTP/1.0 clients. If the streamer already holds a part when the write starts, that
+ * part is sent first.
+ */
+struct JsonStreamBody {
+    using value_type = std::shared_ptr<JsonStreamer>;
+
+    class writer {
+        value_type const& streamer_;
+        bool pending_ = false;
+
+    public:
+        using const_buffers_type = boost::asio::const_buffer;
+
+        template <bool isRequest, typename Fields>
+        writer(boost::beast::http::header<isRequest, Fields> const&, value_type const& streamer) : streamer_(streamer)
+        {
+        }
+
+        void
+        init(boost::beast::error_code& ec)
+        {
+            ec = {};
+            pending_ = not streamer_->current().empty();
+        }
+
+        boost::optional<std::pair<const_buffers_type, bool>>
+        get(boost::beast::error_code& ec)
+        {
+            ec = {};
+            if (not pending_ and streamer_->done())
+                return boost::none;
+
+            auto const chunk = pending_ ? streamer_->current() : streamer_->read();
+            pending_ = false;
+            return std::make_pair(boost::asio::const_buffer{chunk.data(), chunk.size()}, not streamer_->done());
+        }
+    };
+};
+
+}  // namespace web::impl
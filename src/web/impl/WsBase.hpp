@@ -24,8 +24,14 @@
 #include "util/Taggable.hpp"
 #include "util/log/Logger.hpp"
 #include "web/dosguard/DOSGuardInterface.hpp"
+#include "web/impl/JsonStreamer.hpp"
+#include "web/impl/LoadWarning.hpp"
+#include "web/impl/WsFrame.hpp"
+#include "web/impl/WsSendQueue.hpp"
+#include "web/impl/WsSettings.hpp"
 #include "web/interface/Concepts.hpp"
 #include "web/interface/ConnectionBase.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/error.hpp>
@@ -38,10 +44,12 @@
 #include <boost/beast/http/status.hpp>
 #include <boost/beast/http/string_body.hpp>
 #include <boost/beast/version.hpp>
+#include <boost/beast/websocket/error.hpp>
+#include <boost/beast/websocket/option.hpp>
 #include <boost/beast/websocket/rfc6455.hpp>
 #include <boost/beast/websocket/stream_base.hpp>
 #include <boost/core/ignore_unused.hpp>
-#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <xrpl/protocol/ErrorCodes.h>
@@ -50,9 +58,12 @@
 #include <exception>
 #include <functional>
 #include <memory>
-#include <queue>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <utility>
+#include <variant>
+#include <vector>
 
 namespace web::impl {
 
@@ -63,6 +74,16 @@ namespace web::impl {
  * The write operation is via a queue, each write operation of this session will be sent in order.
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent.
  * It is useful when we have multiple sessions sending the same content.
+ * Large JSON responses are sent as a fragmented message while they are serialized; no other message is written until
+ * the last fragment is sent.
+ * The queue has a budget of messages and bytes; subscription messages to a client that falls behind are dropped,
+ * coalesced or the client is disconnected with a slowDown reason, see WsSendQueue.
+ * Subscription messages are published from other threads. They are collected under a mutex and handed over to the
+ * session's executor in batches, so a burst of messages costs one dispatch instead of one per message.
+ * Consecutive queued messages that beast doesn't need to compress are framed by the session and written with one
+ * gather write through WsFrameStream, so a burst of messages also costs one socket write instead of one per message.
+ * If the client negotiated permessage-deflate with the server's full window, large subscription messages are sent in
+ * the compressed form shared by all subscribers, so each message is compressed once instead of once per session.
  *
  * @tparam Derived The derived class
  * @tparam HandlerType The handler type, will be called when a request is received.
@@ -73,11 +94,23 @@ class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase
 
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard_;
-    bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+    std::vector<WsSendQueue::MessageType> sending_;
+    std::vector<WsFrameHeader> headers_;
+    WsSendQueue messages_;
+    WsCompressionSettings compression_;
+    bool deflateNegotiated_ = false;
+    bool sharedDeflate_ = false;
+    bool closing_ = false;
     std::shared_ptr<HandlerType> const handler_;
 
+    std::mutex incomingMutex_;
+    std::vector<std::shared_ptr<SubscriptionMessage const>> incoming_;
+    std::vector<std::shared_ptr<SubscriptionMessage const>> batch_;  // only used on the session's executor
+
 protected:
+    static constexpr std::size_t MAX_BATCH_MESSAGES = 256;
+    static constexpr std::size_t MAX_BATCH_BYTES = 1024 * 1024;
+
     util::Logger log_{"WebServer"};
     util::Logger perfLog_{"Performance"};
 
@@ -101,9 +134,15 @@ public:
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<dosguard::DOSGuardInterface> dosGuard,
         std::shared_ptr<HandlerType> const& handler,
-        boost::beast::flat_buffer&& buffer
+        boost::beast::flat_buffer&& buffer,
+        WsSettings const& settings
     )
-        : ConnectionBase(tagFactory, ip), buffer_(std::move(buffer)), dosGuard_(dosGuard), handler_(handler)
+        : ConnectionBase(tagFactory, ip)
+        , buffer_(std::move(buffer))
+        , dosGuard_(dosGuard)
+        , messages_(settings.queue)
+        , compression_(settings.compression)
+        , handler_(handler)
     {
         upgraded = true;  // NOLINT (cppcoreguidelines-pro-type-member-init)
         LOG(perfLog_.debug()) << tag() << "session created";
@@ -124,18 +163,76 @@ public:
     void
     doWrite()
     {
-        sending_ = true;
+        if (auto const* streamer = std::get_if<std::shared_ptr<JsonStreamer>>(&sending_.front())) {
+            auto const chunk = (*streamer)->current();
+            derived().ws().compress(true);  // streamed responses are large by definition
+            derived().ws().async_write_some(
+                (*streamer)->done(),
+                boost::asio::buffer(chunk.data(), chunk.size()),
+                boost::beast::bind_front_handler(&WsBase::onWriteFragment, derived().shared_from_this())
+            );
+            return;
+        }
+
+        auto const& msg = *payload(sending_.front());
+        derived().ws().compress(msg.size() >= compression_.threshold);
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(msg.data(), msg.size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
         );
     }
 
+    void
+    doWriteFrames()
+    {
+        std::vector<std::string const*> payloads;
+        payloads.reserve(sending_.size());
+        headers_.clear();
+        for (auto const& message : sending_) {
+            auto const* msg = payload(message);
+            auto const compressed = deflateNegotiated_ and msg->size() >= compression_.threshold;
+            if (compressed) {
+                msg = &std::get<std::shared_ptr<SubscriptionMessage const>>(message)->compressed(
+                    [level = compression_.level](std::string const& data) { return deflateMessage(data, level); }
+                );
+            }
+
+            payloads.push_back(msg);
+            headers_.emplace_back(msg->size(), compressed);
+        }
+
+        // the buffers point into headers_, which must not reallocate afterwards
+        std::vector<boost::asio::const_buffer> frames;
+        frames.reserve(sending_.size() * 2);
+        for (std::size_t i = 0; i < sending_.size(); ++i) {
+            frames.push_back(headers_[i].buffer());
+            frames.push_back(boost::asio::buffer(payloads[i]->data(), payloads[i]->size()));
+        }
+
+        // beast writes the frames in place of this empty message while it holds its write lock
+        derived().ws().next_layer().setFrames(std::move(frames));
+        derived().ws().compress(false);
+        derived().ws().async_write(
+            boost::asio::const_buffer{},
+            boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this())
+        );
+    }
+
+    void
+    onWriteFragment(boost::system::error_code ec, std::size_t bytesTransferred)
+    {
+        auto const& streamer = std::get<std::shared_ptr<JsonStreamer>>(sending_.front());
+        if (ec or streamer->done())
+            return onWrite(ec, bytesTransferred);
+
+        dosGuard_.get().add(clientIp, streamer->read().size());
+        doWrite();
+    }
+
     void
     onWrite(boost::system::error_code ec, std::size_t)
     {
-        messages_.pop();
-        sending_ = false;
+        sending_.clear();
         if (ec) {
             wsFail(ec, "Failed to write");
         } else {
@@ -146,10 +243,21 @@ public:
     void
     maybeSendNext()
     {
-        if (ec_ || sending_ || messages_.empty())
+        if (ec_ || closing_ || not sending_.empty() || messages_.empty())
             return;
 
-        doWrite();
+        sending_.push_back(messages_.pop());
+        if (not framedBySession(sending_.front()))
+            return doWrite();
+
+        auto bytes = payload(sending_.front())->size();
+        while (sending_.size() < MAX_BATCH_MESSAGES and not messages_.empty() and framedBySession(messages_.front()) and
+               bytes + payload(messages_.front())->size() <= MAX_BATCH_BYTES) {
+            bytes += payload(messages_.front())->size();
+            sending_.push_back(messages_.pop());
+        }
+
+        doWriteFrames();
     }
 
     /**
@@ -157,17 +265,22 @@ public:
      * @param msg The message to send, it will keep the string alive until it is sent. It is useful when we have
      * multiple session sending the same content.
      * Be aware that the message length will not be added to the DOSGuard from this function.
+     * Messages sent while a previous batch is waiting to be handed over to the session join that batch, and messages
+     * that are queued together are written to the socket together.
      */
     void
-    send(std::shared_ptr<std::string> msg) override
+    send(std::shared_ptr<SubscriptionMessage const> msg) override
     {
-        boost::asio::dispatch(
-            derived().ws().get_executor(),
-            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                messages_.push(msg);
-                maybeSendNext();
-            }
-        );
+        {
+            std::scoped_lock const lock{incomingMutex_};
+            incoming_.push_back(std::move(msg));
+            if (incoming_.size() > 1)
+                return;
+        }
+
+        boost::asio::dispatch(derived().ws().get_executor(), [this, self = derived().shared_from_this()]() {
+            enqueueIncoming();
+        });
     }
 
     /**
@@ -181,19 +294,39 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size())) {
             auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array()) {
-                jsonResponse["warnings"].as_array().push_back(rpc::makeWarning(rpc::warnRPC_RATE_LIMIT));
-            } else {
-                jsonResponse["warnings"] = boost::json::array{rpc::makeWarning(rpc::warnRPC_RATE_LIMIT)};
-            }
+            addLoadWarning(jsonResponse);
 
             // Reserialize when we need to include this warning
             msg = boost::json::serialize(jsonResponse);
         }
-        auto sharedMsg = std::make_shared<std::string>(std::move(msg));
-        send(std::move(sharedMsg));
+        sendResponse(std::make_shared<std::string>(std::move(msg)));
+    }
+
+    /**
+     * @brief Send a JSON response to the client
+     * @param msg The message to send
+     * Responses that fit into one JsonStreamer chunk are sent like a string. Larger responses are sent as fragments
+     * while they are serialized. Only the first fragment is known when the DOSGuard decides whether to add a warning;
+     * the following fragments are added to the DOSGuard as they are serialized.
+     */
+    void
+    send(boost::json::object&& msg, http::status status) override
+    {
+        auto streamer = std::make_shared<JsonStreamer>(std::move(msg));
+        if (auto const chunk = streamer->read(); streamer->done())
+            return send(std::string{chunk}, status);
+
+        if (!dosGuard_.get().add(clientIp, streamer->size())) {
+            streamer->restart(&addLoadWarning);
+            streamer->read();
+        }
+
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), streamer = std::move(streamer)]() {
+                enqueue(streamer);
+            }
+        );
     }
 
     /**
@@ -206,11 +339,25 @@ public:
 
         derived().ws().set_option(websocket::stream_base::timeout::suggested(role_type::server));
 
-        // Set a decorator to change the Server of the handshake
-        derived().ws().set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
+        // Set a decorator to change the Server of the handshake; it runs after the extensions are negotiated
+        derived().ws().set_option(websocket::stream_base::decorator([this](websocket::response_type& res) {
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
+
+            std::string_view const extensions = res[http::field::sec_websocket_extensions];
+            deflateNegotiated_ = extensions.starts_with("permessage-deflate");
+            sharedDeflate_ = acceptsSharedDeflate(extensions);
         }));
 
+        if (compression_.enabled) {
+            // no context takeover keeps the per session memory at one deflate stream that is reset after every message
+            websocket::permessage_deflate deflate;
+            deflate.server_enable = true;
+            deflate.server_no_context_takeover = true;
+            deflate.client_no_context_takeover = true;
+            deflate.compLevel = compression_.level;
+            derived().ws().set_option(deflate);
+        }
+
         derived().ws().async_accept(req, bind_front_handler(&WsBase::onAccept, this->shared_from_this()));
     }
 
@@ -259,7 +406,7 @@ public:
                 e["request"] = std::move(requestStr);
             }
 
-            this->send(std::make_shared<std::string>(boost::json::serialize(e)));
+            this->sendResponse(std::make_shared<std::string>(boost::json::serialize(e)));
         };
 
         std::string requestStr{static_cast<char const*>(buffer_.data().data()), buffer_.size()};
@@ -278,5 +425,94 @@ public:
 
         doRead();
     }
+
+private:
+    static std::string const*
+    payload(WsSendQueue::MessageType const& message)
+    {
+        if (auto const* response = std::get_if<std::shared_ptr<std::string>>(&message))
+            return response->get();
+
+        if (auto const* msg = std::get_if<std::shared_ptr<SubscriptionMessage const>>(&message))
+            return &(*msg)->data();
+
+        return nullptr;
+    }
+
+    bool
+    framedBySession(WsSendQueue::MessageType const& message) const
+    {
+        auto const* msg = payload(message);
+        if (msg == nullptr)
+            return false;
+
+        if (not deflateNegotiated_ or msg->size() < compression_.threshold)
+            return true;
+
+        return sharedDeflate_ and std::holds_alternative<std::shared_ptr<SubscriptionMessage const>>(message);
+    }
+
+    void
+    sendResponse(std::shared_ptr<std::string> msg)
+    {
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
+                enqueue(msg);
+            }
+        );
+    }
+
+    void
+    enqueue(WsSendQueue::MessageType message)
+    {
+        if (ec_ || closing_)
+            return;
+
+        if (not messages_.push(std::move(message)))
+            return disconnectSlowClient();
+
+        maybeSendNext();
+    }
+
+    void
+    enqueueIncoming()
+    {
+        {
+            std::scoped_lock const lock{incomingMutex_};
+            batch_.swap(incoming_);
+        }
+
+        for (auto& msg : batch_) {
+            if (ec_ || closing_)
+                break;
+
+            if (not messages_.push(std::move(msg))) {
+                disconnectSlowClient();
+                break;
+            }
+        }
+        batch_.clear();
+
+        maybeSendNext();
+    }
+
+    void
+    disconnectSlowClient()
+    {
+        LOG(perfLog_.warn()) << tag() << "disconnecting slow client; queued messages: " << messages_.size()
+                             << ", queued bytes: " << messages_.bytes();
+
+        closing_ = true;
+        messages_.clear();
+
+        derived().ws().async_close(
+            boost::beast::websocket::close_reason{boost::beast::websocket::close_code::policy_error, "slowDown"},
+            [this, self = derived().shared_from_this()](boost::beast::error_code ec) {
+                if (ec)
+                    wsFail(ec, "close");
+            }
+        );
+    }
 };
 }  // namespace web::impl
@@ -0,0 +1,160 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WsFrame.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/beast/zlib/error.hpp>
+#include <boost/beast/zlib/zlib.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace web::impl {
+
+namespace {
+
+constexpr std::uint8_t FIN_TEXT = 0x81;
+constexpr std::uint8_t RSV1 = 0x40;
+constexpr std::uint8_t LENGTH_16 = 126;
+constexpr std::uint8_t LENGTH_64 = 127;
+constexpr std::size_t MAX_LENGTH_7 = 125;
+constexpr std::size_t MAX_LENGTH_16 = 0xFFFF;
+
+constexpr int WINDOW_BITS = 15;
+constexpr int MEM_LEVEL = 8;
+constexpr std::string_view SYNC_FLUSH_TAIL{"\x00\x00\xff\xff", 4};
+
+std::string_view
+trim(std::string_view str)
+{
+    auto const begin = str.find_first_not_of(" \t");
+    if (begin == std::string_view::npos)
+        return {};
+
+    return str.substr(begin, str.find_last_not_of(" \t") - begin + 1);
+}
+
+}  // namespace
+
+WsFrameHeader::WsFrameHeader(std::size_t payloadSize, bool compressed)
+{
+    bytes_[size_++] = compressed ? (FIN_TEXT | RSV1) : FIN_TEXT;
+
+    auto writeLength = [this, payloadSize](std::size_t lengthBytes) {
+        for (auto i = lengthBytes; i > 0; --i)
+            bytes_[size_++] = static_cast<std::uint8_t>(payloadSize >> ((i - 1) * 8));
+    };
+
+    if (payloadSize <= MAX_LENGTH_7) {
+        bytes_[size_++] = static_cast<std::uint8_t>(payloadSize);
+    } else if (payloadSize <= MAX_LENGTH_16) {
+        bytes_[size_++] = LENGTH_16;
+        writeLength(2);
+    } else {
+        bytes_[size_++] = LENGTH_64;
+        writeLength(8);
+    }
+}
+
+boost::asio::const_buffer
+WsFrameHeader::buffer() const
+{
+    return boost::asio::buffer(bytes_.data(), size_);
+}
+
+
+std::string
+deflateMessage(std::string_view data, int level)
+{
+    boost::beast::zlib::deflate_stream stream;
+    stream.reset(level, WINDOW_BITS, MEM_LEVEL, boost::beast::zlib::Strategy::normal);
+
+    std::string result(stream.upper_bound(data.size()) + SYNC_FLUSH_TAIL.size(), '\0');
+    boost::beast::zlib::z_params params;
+    params.next_in = data.data();
+    params.avail_in = data.size();
+
+    // a sync flush ends the message on a byte boundary; it is repeated until the output has room left over
+    do {
+        if (params.total_out == result.size())
+            result.resize(result.size() * 2);
+
+        params.next_out = result.data() + params.total_out;
+        params.avail_out = result.size() - params.total_out;
+
+        boost::system::error_code ec;
+        stream.write(params, boost::beast::zlib::Flush::sync, ec);
+        if (ec and ec != boost::beast::zlib::error::need_buffers)
+            throw boost::system::system_error{ec, "deflateMessage"};
+    } while (params.avail_out == 0);
+
+    result.resize(params.total_out);
+
+    // the receiver appends the tail of the sync flush again before inflating (RFC 7692 7.2.1)
+    if (std::string_view{result}.ends_with(SYNC_FLUSH_TAIL))
+        result.resize(result.size() - SYNC_FLUSH_TAIL.size());
+
+    return result;
+}
+
+bool
+acceptsSharedDeflate(std::string_view extensions)
+{
+    // the response only contains the negotiated extension
+    extensions = extensions.substr(0, extensions.find(','));
+
+    auto next = [&extensions]() {
+        auto const end = extensions.find(';');
+        auto const token = trim(extensions.substr(0, end));
+        extensions = end == std::string_view::npos ? std::string_view{} : extensions.substr(end + 1);
+        return token;
+    };
+
+    if (next() != "permessage-deflate")
+        return false;
+
+    bool noContextTakeover = false;
+    while (not extensions.empty()) {
+        auto const parameter = next();
+        auto const separator = parameter.find('=');
+        auto const name = trim(parameter.substr(0, separator));
+
+        if (name == "server_no_context_takeover") {
+            noContextTakeover = true;
+        } else if (name == "server_max_window_bits") {
+            auto value =
+                separator == std::string_view::npos ? std::string_view{} : trim(parameter.substr(separator + 1));
+            if (value.size() > 1 and value.front() == '"' and value.back() == '"')
+                value = value.substr(1, value.size() - 2);
+
+            if (value != std::to_string(WINDOW_BITS))
+                return false;
+        }
+    }
+
+    return noContextTakeover;
+}
+
+}  // namespace web::impl
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/buffer.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace web::impl {
+
+/**
+ * @brief The header of a websocket frame that carries a whole text message from the server to the client.
+ *
+ * Server frames are not masked, so the header only depends on the size of the payload and whether it is compressed.
+ * Used to frame several messages up front and write them to the socket at once, see WsFrameStream.
+ */
+class WsFrameHeader {
+public:
+    static constexpr std::size_t MAX_SIZE = 10;
+
+private:
+    std::array<std::uint8_t, MAX_SIZE> bytes_{};
+    std::size_t size_ = 0;
+
+public:
+    /**
+     * @brief Construct the header of a frame
+     *
+     * @param payloadSize The size of the payload in bytes
+     * @param compressed Whether the payload is compressed with permessage-deflate
+     */
+    explicit WsFrameHeader(std::size_t payloadSize, bool compressed = false);
+
+    /** @return The header; points into this object */
+    [[nodiscard]] boost::asio::const_buffer
+    buffer() const;
+};
+
+/**
+ * @brief Compress a message for a permessage-deflate frame without context takeover.
+ *
+ * The result doesn't depend on the messages sent before, so the same compressed message can be sent to every client
+ * that accepts it, see acceptsSharedDeflate.
+ *
+ * @param data The message
+ * @param level The compression level
+ * @return The compressed payload
+ */
+std::string
+deflateMessage(std::string_view data, int level);
+
+/**
+ * @brief Whether a client accepts messages compressed with deflateMessage.
+ *
+ * @param extensions The Sec-WebSocket-Extensions field of the handshake response
+ * @return true if permessage-deflate was negotiated with no server context takeover and the full window; false
+ * otherwise
+ */
+bool
+acceptsSharedDeflate(std::string_view extensions);
+
+}  // namespace web::impl
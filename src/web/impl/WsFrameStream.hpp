@@ -0,0 +1,175 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/compose.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core/role.hpp>
+#include <boost/beast/websocket/teardown.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace web::impl {
+
+/**
+ * @brief The layer between a server websocket stream and its transport that writes frames built by the session.
+ *
+ * Beast writes one message per write and also writes control frames (pongs, pings and close) on its own, so the
+ * session can't write to the transport directly without risking two writes at the same time. Instead, the session
+ * passes the frames of several messages to this layer and asks beast to write an empty text message. Beast holds its
+ * write lock while it writes the empty frame; this layer writes the prepared frames in place of it with one gather
+ * write and reports the empty frame as written. Every other read and write is passed through.
+ *
+ * @tparam NextLayer The transport, e.g. a TCP or SSL stream
+ */
+template <typename NextLayer>
+class WsFrameStream {
+    static constexpr std::array<std::uint8_t, 2> EMPTY_TEXT_FRAME{0x81, 0x00};
+
+    NextLayer next_;
+    std::vector<boost::asio::const_buffer> frames_;
+    std::vector<boost::asio::const_buffer> writing_;
+
+public:
+    using executor_type = typename NextLayer::executor_type;
+    using next_layer_type = NextLayer;
+
+    /**
+     * @brief Construct the layer
+     *
+     * @param args The arguments to construct the transport with
+     */
+    template <typename... Args>
+    explicit WsFrameStream(Args&&... args) : next_(std::forward<Args>(args)...)
+    {
+    }
+
+    executor_type
+    get_executor() noexcept
+    {
+        return next_.get_executor();
+    }
+
+    NextLayer&
+    next_layer() noexcept
+    {
+        return next_;
+    }
+
+    NextLayer const&
+    next_layer() const noexcept
+    {
+        return next_;
+    }
+
+    /**
+     * @brief Set the frames to write in place of the next empty text message.
+     *
+     * @param frames The frames; the memory they point to must be valid until the write of the empty message completes
+     */
+    void
+    setFrames(std::vector<boost::asio::const_buffer> frames)
+    {
+        frames_ = std::move(frames);
+    }
+
+    template <typename MutableBufferSequence, typename ReadHandler>
+    auto
+    async_read_some(MutableBufferSequence const& buffers, ReadHandler&& handler)
+    {
+        return next_.async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+
+    template <typename ConstBufferSequence, typename WriteHandler>
+    auto
+    async_write_some(ConstBufferSequence const& buffers, WriteHandler&& handler)
+    {
+        return boost::asio::async_initiate<WriteHandler, void(boost::system::error_code, std::size_t)>(
+            [this](auto handler, ConstBufferSequence const& buffers) {
+                if (frames_.empty() or not isEmptyTextFrame(buffers)) {
+                    next_.async_write_some(buffers, std::move(handler));
+                    return;
+                }
+
+                writing_ = std::exchange(frames_, {});
+                boost::asio::async_compose<decltype(handler), void(boost::system::error_code, std::size_t)>(
+                    [this, started = false](
+                        auto& self, boost::system::error_code ec = {}, std::size_t = 0
+                    ) mutable {
+                        if (not std::exchange(started, true)) {
+                            boost::asio::async_write(next_, writing_, std::move(self));
+                            return;
+                        }
+
+                        writing_.clear();
+                        self.complete(ec, ec ? 0 : EMPTY_TEXT_FRAME.size());
+                    },
+                    handler,
+                    next_
+                );
+            },
+            handler,
+            buffers
+        );
+    }
+
+private:
+    template <typename ConstBufferSequence>
+    static bool
+    isEmptyTextFrame(ConstBufferSequence const& buffers)
+    {
+        if (boost::asio::buffer_size(buffers) != EMPTY_TEXT_FRAME.size())
+            return false;
+
+        std::array<std::uint8_t, 2> header{};
+        boost::asio::buffer_copy(boost::asio::buffer(header), buffers);
+        return header == EMPTY_TEXT_FRAME;
+    }
+};
+
+template <typename NextLayer>
+void
+teardown(boost::beast::role_type role, WsFrameStream<NextLayer>& stream, boost::system::error_code& ec)
+{
+    using boost::beast::websocket::teardown;
+    teardown(role, stream.next_layer(), ec);
+}
+
+template <typename NextLayer, typename TeardownHandler>
+void
+async_teardown(
+    boost::beast::role_type role,
+    WsFrameStream<NextLayer>& stream,
+    TeardownHandler&& handler
+)
+{
+    using boost::beast::websocket::async_teardown;
+    async_teardown(role, stream.next_layer(), std::forward<TeardownHandler>(handler));
+}
+
+}  // namespace web::impl
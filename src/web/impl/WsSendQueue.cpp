@@ -0,0 +1,239 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WsSendQueue.hpp"
+
+#include "util/OverloadSet.hpp"
+#include "util/config/Config.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+#include "web/impl/JsonStreamer.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+using util::prometheus::Label;
+using util::prometheus::Labels;
+
+namespace web::impl {
+
+namespace {
+
+std::vector<std::int64_t> const MESSAGES_BUCKETS{1, 10, 100, 1'000, 10'000, 100'000};
+std::vector<std::int64_t> const BYTES_BUCKETS{1'024, 16'384, 262'144, 4'194'304, 67'108'864, 1'073'741'824};
+
+}  // namespace
+
+WsSendQueueSettings
+WsSendQueueSettings::make(util::Config const& serverConfig)
+{
+    WsSendQueueSettings settings;
+    settings.maxMessages = serverConfig.valueOr<std::size_t>("ws_max_queue_messages", DEFAULT_MAX_MESSAGES);
+    settings.maxBytes = serverConfig.valueOr<std::size_t>("ws_max_queue_size_kb", DEFAULT_MAX_SIZE_KB) * 1024;
+
+    auto const policy = serverConfig.valueOr<std::string>("ws_slow_client_policy", "disconnect");
+    if (policy == "drop_oldest") {
+        settings.policy = SlowClientPolicy::DropOldest;
+    } else if (policy == "coalesce_ledgers") {
+        settings.policy = SlowClientPolicy::CoalesceLedgers;
+    } else if (policy == "disconnect") {
+        settings.policy = SlowClientPolicy::Disconnect;
+    } else {
+        throw std::logic_error(fmt::format("Unknown websocket slow client policy: {}", policy));
+    }
+
+    return settings;
+}
+
+WsSendQueue::WsSendQueue(WsSendQueueSettings settings)
+    : settings_(settings)
+    , messagesHistogram_(util::prometheus::PrometheusService::histogramInt(
+          "ws_send_queue_messages_histogram",
+          Labels(),
+          MESSAGES_BUCKETS,
+          "The number of messages waiting to be sent to a websocket client"
+      ))
+    , bytesHistogram_(util::prometheus::PrometheusService::histogramInt(
+          "ws_send_queue_bytes_histogram",
+          Labels(),
+          BYTES_BUCKETS,
+          "The number of bytes waiting to be sent to a websocket client"
+      ))
+    , droppedCounter_(util::prometheus::PrometheusService::counterInt(
+          "ws_slow_client_messages_total_number",
+          Labels({Label{"action", "dropped"}}),
+          "Total number of subscription messages dropped because the client was too slow"
+      ))
+    , coalescedCounter_(util::prometheus::PrometheusService::counterInt(
+          "ws_slow_client_messages_total_number",
+          Labels({Label{"action", "coalesced"}}),
+          "Total number of ledger stream messages replaced by a newer one because the client was too slow"
+      ))
+    , disconnectedCounter_(util::prometheus::PrometheusService::counterInt(
+          "ws_slow_client_disconnects_total_number",
+          Labels(),
+          "Total number of websocket clients disconnected because they were too slow"
+      ))
+{
+}
+
+bool
+WsSendQueue::push(MessageType message)
+{
+    auto const size = std::visit(
+        util::OverloadSet{
+            [](std::shared_ptr<std::string> const& msg) { return msg->size(); },
+            [](std::shared_ptr<SubscriptionMessage const> const& msg) { return msg->data().size(); },
+            [](std::shared_ptr<JsonStreamer> const& streamer) { return streamer->current().size(); },
+        },
+        message
+    );
+
+    auto const* msg = std::get_if<std::shared_ptr<SubscriptionMessage const>>(&message);
+    auto const subscription = msg != nullptr;
+    auto const ledger = subscription and (*msg)->kind() == SubscriptionMessage::Kind::Ledger;
+
+    entries_.push_back(
+        Entry{.message = std::move(message), .size = size, .subscription = subscription, .ledger = ledger}
+    );
+    bytes_ += size;
+
+    if (overBudget()) {
+        // the client asked for responses, so they never count against it; they make room by evicting subscriptions
+        auto const policy = not subscription and settings_.policy == SlowClientPolicy::Disconnect
+            ? SlowClientPolicy::DropOldest
+            : settings_.policy;
+
+        switch (policy) {
+            case SlowClientPolicy::Disconnect:
+                ++disconnectedCounter_.get();
+                return false;
+            case SlowClientPolicy::CoalesceLedgers:
+                coalesceLedgers();
+                [[fallthrough]];
+            case SlowClientPolicy::DropOldest:
+                dropOldest();
+                break;
+        }
+    }
+
+    messagesHistogram_.get().observe(static_cast<std::int64_t>(entries_.size()));
+    bytesHistogram_.get().observe(static_cast<std::int64_t>(bytes_));
+    return true;
+}
+
+WsSendQueue::MessageType
+WsSendQueue::pop()
+{
+    auto message = std::move(entries_.front().message);
+    bytes_ -= entries_.front().size;
+    entries_.pop_front();
+    return message;
+}
+
+WsSendQueue::MessageType const&
+WsSendQueue::front() const
+{
+    return entries_.front().message;
+}
+
+bool
+WsSendQueue::empty() const
+{
+    return entries_.empty();
+}
+
+std::size_t
+WsSendQueue::size() const
+{
+    return entries_.size();
+}
+
+std::size_t
+WsSendQueue::bytes() const
+{
+    return bytes_;
+}
+
+void
+WsSendQueue::clear()
+{
+    entries_.clear();
+    bytes_ = 0;
+}
+
+bool
+WsSendQueue::overBudget() const
+{
+    return entries_.size() > settings_.maxMessages or bytes_ > settings_.maxBytes;
+}
+
+void
+WsSendQueue::erase(std::deque<Entry>::iterator it)
+{
+    bytes_ -= it->size;
+    entries_.erase(it);
+}
+
+void
+WsSendQueue::coalesceLedgers()
+{
+    auto const latest = std::ranges::find_if(entries_.rbegin(), entries_.rend(), &Entry::ledger);
+    if (latest == entries_.rend())
+        return;
+
+    // entries are moved while erasing so the latest is told apart by its message
+    using LedgerMessage = std::shared_ptr<SubscriptionMessage const>;
+    auto const* latestMessage = std::get<LedgerMessage>(latest->message).get();
+    auto const coalesced = std::erase_if(entries_, [this, latestMessage](Entry const& entry) {
+        if (not entry.ledger or std::get<LedgerMessage>(entry.message).get() == latestMessage)
+            return false;
+
+        bytes_ -= entry.size;
+        return true;
+    });
+
+    coalescedCounter_.get() += coalesced;
+}
+
+void
+WsSendQueue::dropOldest()
+{
+    while (overBudget()) {
+        auto const it = std::ranges::find_if(entries_, &Entry::subscription);
+        if (it == entries_.end())
+            return;
+
+        erase(it);
+        ++droppedCounter_.get();
+    }
+}
+
+}  // namespace web::impl
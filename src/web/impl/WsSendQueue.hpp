@@ -0,0 +1,163 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/config/Config.hpp"
+#include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
+#include "web/impl/JsonStreamer.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <variant>
+
+namespace web::impl {
+
+/**
+ * @brief What a websocket session does when its clients can't keep up with the messages sent to it.
+ */
+enum class SlowClientPolicy {
+    DropOldest,      /**< Drop the oldest subscription messages */
+    CoalesceLedgers, /**< Keep only the latest ledger stream message, then drop the oldest subscription messages */
+    Disconnect       /**< Close the connection with a slowDown reason */
+};
+
+/**
+ * @brief The budget of a websocket session's outbound queue.
+ */
+struct WsSendQueueSettings {
+    static constexpr std::size_t DEFAULT_MAX_MESSAGES = 10000;
+    static constexpr std::size_t DEFAULT_MAX_SIZE_KB = 64 * 1024;
+
+    std::size_t maxMessages = DEFAULT_MAX_MESSAGES;
+    std::size_t maxBytes = DEFAULT_MAX_SIZE_KB * 1024;
+    SlowClientPolicy policy = SlowClientPolicy::Disconnect;
+
+    /**
+     * @brief Read the settings from the server section of the config.
+     *
+     * @param serverConfig The server section of the config
+     * @return The settings
+     * @throws std::logic_error if the slow client policy is not known
+     */
+    static WsSendQueueSettings
+    make(util::Config const& serverConfig);
+};
+
+/**
+ * @brief The bounded queue of messages waiting to be written to a websocket client.
+ *
+ * Responses to the client's own requests (strings and streamed JSON) are never dropped; subscription messages are
+ * dropped or coalesced according to the policy once the queue exceeds its budget. The message being written is not part
+ * of the queue.
+ */
+class WsSendQueue {
+public:
+    using MessageType = std::variant<
+        std::shared_ptr<std::string>,
+        std::shared_ptr<SubscriptionMessage const>,
+        std::shared_ptr<JsonStreamer>>;
+
+private:
+    struct Entry {
+        MessageType message;
+        std::size_t size;
+        bool subscription;
+        bool ledger;
+    };
+
+    WsSendQueueSettings settings_;
+    std::deque<Entry> entries_;
+    std::size_t bytes_ = 0;
+
+    std::reference_wrapper<util::prometheus::HistogramInt> messagesHistogram_;
+    std::reference_wrapper<util::prometheus::HistogramInt> bytesHistogram_;
+    std::reference_wrapper<util::prometheus::CounterInt> droppedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> coalescedCounter_;
+    std::reference_wrapper<util::prometheus::CounterInt> disconnectedCounter_;
+
+public:
+    /**
+     * @brief Construct a new queue
+     *
+     * @param settings The budget and slow client policy
+     */
+    explicit WsSendQueue(WsSendQueueSettings settings);
+
+    /**
+     * @brief Add a message to the end of the queue and enforce the budget
+     *
+     * @param message The message to add
+     * @return false if the queue is over budget and the client should be disconnected; true otherwise
+     */
+    [[nodiscard]] bool
+    push(MessageType message);
+
+    /**
+     * @brief Remove the first message from the queue
+     *
+     * @return The first message
+     */
+    MessageType
+    pop();
+
+    /**
+     * @brief The first message of the queue; the queue must not be empty
+     *
+     * @return The first message
+     */
+    [[nodiscard]] MessageType const&
+    front() const;
+
+    /** @return true if there are no messages in the queue; false otherwise */
+    [[nodiscard]] bool
+    empty() const;
+
+    /** @return The number of messages in the queue */
+    [[nodiscard]] std::size_t
+    size() const;
+
+    /** @return The number of bytes in the queue */
+    [[nodiscard]] std::size_t
+    bytes() const;
+
+    /** @brief Remove all messages from the queue. */
+    void
+    clear();
+
+private:
+    [[nodiscard]] bool
+    overBudget() const;
+
+    void
+    erase(std::deque<Entry>::iterator it);
+
+    void
+    coalesceLedgers();
+
+    void
+    dropOldest();
+};
+
+}  // namespace web::impl
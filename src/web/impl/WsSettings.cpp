@@ -0,0 +1,50 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WsSettings.hpp"
+
+#include "util/config/Config.hpp"
+#include "web/impl/WsSendQueue.hpp"
+
+#include <fmt/core.h>
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace web::impl {
+
+WsSettings
+WsSettings::make(util::Config const& serverConfig)
+{
+    WsSettings settings;
+    settings.queue = WsSendQueueSettings::make(serverConfig);
+
+    settings.compression.enabled = serverConfig.valueOr("ws_permessage_deflate", false);
+    settings.compression.level = serverConfig.valueOr("ws_compression_level", WsCompressionSettings::DEFAULT_LEVEL);
+    settings.compression.threshold =
+        serverConfig.valueOr<std::size_t>("ws_compression_threshold", WsCompressionSettings::DEFAULT_THRESHOLD);
+
+    auto const level = settings.compression.level;
+    if (level < 0 or level > 9)
+        throw std::logic_error(fmt::format("Websocket compression level must be between 0 and 9, got {}", level));
+
+    return settings;
+}
+
+}  // namespace web::impl
@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "util/config/Config.hpp"
+#include "web/impl/WsSendQueue.hpp"
+
+#include <cstddef>
+
+namespace web::impl {
+
+/**
+ * @brief The permessage-deflate settings of websocket sessions.
+ *
+ * A subscription message is compressed once and the result is sent to every subscriber that negotiated the server's
+ * full window; responses and the messages of other subscribers are compressed by their session.
+ */
+struct WsCompressionSettings {
+    static constexpr int DEFAULT_LEVEL = 1;
+    static constexpr std::size_t DEFAULT_THRESHOLD = 1024;
+
+    bool enabled = false;
+    int level = DEFAULT_LEVEL;
+    std::size_t threshold = DEFAULT_THRESHOLD; /**< Messages smaller than this are sent uncompressed */
+};
+
+/**
+ * @brief The settings of websocket sessions.
+ */
+struct WsSettings {
+    WsSendQueueSettings queue;
+    WsCompressionSettings compression;
+
+    /**
+     * @brief Read the settings from the server section of the config.
+     *
+     * @param serverConfig The server section of the config
+     * @return The settings
+     * @throws std::logic_error if a setting is not valid
+     */
+    static WsSettings
+    make(util::Config const& serverConfig);
+};
+
+}  // namespace web::impl
@@ -20,9 +20,12 @@
 #pragma once
 
 #include "util/Taggable.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/status.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
 #include <boost/signals2.hpp>
 #include <boost/signals2/variadic_signal.hpp>
 
@@ -83,13 +86,29 @@ public:
     send(std::string&& msg, http::status status = http::status::ok) = 0;
 
     /**
-     * @brief Send via shared_ptr of string, that enables SubscriptionManager to publish to clients.
+     * @brief Send a JSON response to the client.
+     *
+     * Connections that can write a response while it is being serialized override this to avoid building the whole
+     * serialized string; by default the response is serialized and sent as a string.
+     *
+     * @param msg The message to send
+     * @param status The HTTP status code; defaults to OK
+     */
+    virtual void
+    send(boost::json::object&& msg, http::status status = http::status::ok)
+    {
+        send(boost::json::serialize(msg), status);
+    }
+
+    /**
+     * @brief Send a subscription message shared with other subscribers, that enables SubscriptionManager to publish to
+     * clients.
      *
      * @param msg Unused
      * @throws std::logic_error unless the function is overridden by a child class.
      */
     virtual void
-    send([[maybe_unused]] std::shared_ptr<std::string> msg)
+    send([[maybe_unused]] std::shared_ptr<SubscriptionMessage const> msg)
     {
         throw std::logic_error("web server can not send the shared payload");
     }
@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace web {
+
+/**
+ * @brief A message of a subscription stream.
+ *
+ * One instance is published to every subscriber of a stream, so the message is only serialized once. The compressed
+ * message is computed by the first subscriber that needs it and shared by the others, so it is compressed at most once.
+ */
+class SubscriptionMessage {
+public:
+    /**
+     * @brief The kind of a subscription message.
+     */
+    enum class Kind {
+        Ledger, /**< A message of the ledger stream; a newer one supersedes it */
+        Other   /**< Any other subscription message */
+    };
+
+private:
+    std::string data_;
+    Kind kind_;
+
+    mutable std::once_flag compressedFlag_;
+    mutable std::string compressed_;
+
+public:
+    /**
+     * @brief Construct a new message
+     *
+     * @param data The serialized message
+     * @param kind The kind of the message
+     */
+    explicit SubscriptionMessage(std::string data, Kind kind = Kind::Other) : data_(std::move(data)), kind_(kind)
+    {
+    }
+
+    /** @return The serialized message */
+    [[nodiscard]] std::string const&
+    data() const
+    {
+        return data_;
+    }
+
+    /**
+     * @brief The compressed message, compressed on the first call
+     *
+     * @param compress The function to compress the message with; only called once, so every caller must pass an
+     * equivalent function
+     * @return The compressed message
+     */
+    template <typename CompressFunction>
+    [[nodiscard]] std::string const&
+    compressed(CompressFunction&& compress) const
+    {
+        std::call_once(compressedFlag_, [&]() { compressed_ = std::forward<CompressFunction>(compress)(data_); });
+        return compressed_;
+    }
+
+    /** @return The kind of the message */
+    [[nodiscard]] Kind
+    kind() const
+    {
+        return kind_;
+    }
+};
+
+}  // namespace web
@@ -59,7 +59,14 @@ struct FakeMaybeError {};
 
 struct FakeStatement {};
 
-struct FakePreparedStatement {};
+struct FakePreparedStatement {
+    template <typename... Args>
+    FakeStatement
+    bind(Args&&...) const
+    {
+        return {};
+    }
+};
 
 struct FakeFuture {
     FakeResultOrError data;
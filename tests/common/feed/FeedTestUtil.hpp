@@ -24,6 +24,7 @@
 #include "util/MockWsBase.hpp"
 #include "util/SyncExecutionCtxFixture.hpp"
 #include "web/interface/ConnectionBase.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/json/parse.hpp>
 #include <gtest/gtest.h>
@@ -70,9 +71,9 @@ public:
     }
 
     bool
-    MatchAndExplain(std::shared_ptr<std::string> const& arg, std::ostream* /* listener */) const
+    MatchAndExplain(std::shared_ptr<web::SubscriptionMessage const> const& arg, std::ostream* /* listener */) const
     {
-        return boost::json::parse(*arg) == boost::json::parse(expected_);
+        return boost::json::parse(arg->data()) == boost::json::parse(expected_);
     }
 
     void
@@ -89,7 +90,7 @@ public:
 };
 }  // namespace impl
 
-inline ::testing::Matcher<std::shared_ptr<std::string>>
+inline ::testing::Matcher<std::shared_ptr<web::SubscriptionMessage const>>
 SharedStringJsonEq(std::string const& expected)
 {
     return impl::SharedStringJsonEqMatcher(expected);
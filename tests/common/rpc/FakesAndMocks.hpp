@@ -104,6 +104,37 @@ public:
     }
 };
 
+// output of a handler reporting the ledger it read
+struct LedgerIndexOutput {
+    uint32_t ledgerIndex;
+};
+
+// must be implemented as per rpc/common/Concepts.h
+inline void
+tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerIndexOutput const& output)
+{
+    jv = {{"ledger_index", output.ledgerIndex}};
+}
+
+// example handler that reads the given ledger, like handlers asked for the latest ledger read the newest one they see
+class LedgerIndexHandlerFake {
+    uint32_t ledgerIndex_;
+
+public:
+    using Output = LedgerIndexOutput;
+    using Result = rpc::HandlerReturnType<Output>;
+
+    explicit LedgerIndexHandlerFake(uint32_t ledgerIndex) : ledgerIndex_{ledgerIndex}
+    {
+    }
+
+    Result
+    process([[maybe_unused]] rpc::Context const& ctx) const
+    {
+        return Output{ledgerIndex_};
+    }
+};
+
 // example handler that returns custom error
 class FailingHandlerFake {
 public:
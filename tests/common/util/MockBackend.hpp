@@ -50,6 +50,13 @@ struct MockBackend : public BackendInterface {
         (const, override)
     );
 
+    MOCK_METHOD(
+        std::optional<ripple::LedgerHeader>,
+        hardFetchLedgerBySequence,
+        (std::uint32_t const, boost::asio::yield_context),
+        (const, override)
+    );
+
     MOCK_METHOD(
         std::optional<ripple::LedgerHeader>,
         fetchLedgerByHash,
@@ -204,5 +211,5 @@ struct MockBackend : public BackendInterface {
 
     MOCK_METHOD(void, doWriteLedgerObject, (std::string&&, std::uint32_t const, std::string&&), (override));
 
-    MOCK_METHOD(bool, doFinishWrites, (), (override));
+    MOCK_METHOD(bool, doFinishWrites, (std::uint32_t), (override));
 };
@@ -26,7 +26,10 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <expected>
+#include <filesystem>
 #include <optional>
+#include <string>
 #include <vector>
 
 struct MockCache {
@@ -42,10 +45,27 @@ struct MockCache {
 
     MOCK_METHOD(std::optional<data::Blob>, get, (ripple::uint256 const& a, uint32_t b), (const));
 
+    MOCK_METHOD(std::optional<data::BlobView>, getView, (ripple::uint256 const& a, uint32_t b), (const));
+
     MOCK_METHOD(std::optional<data::LedgerObject>, getSuccessor, (ripple::uint256 const& a, uint32_t b), (const));
 
     MOCK_METHOD(std::optional<data::LedgerObject>, getPredecessor, (ripple::uint256 const& a, uint32_t b), (const));
 
+    MOCK_METHOD((std::expected<uint32_t, std::string>), writeSnapshot, (std::filesystem::path const& a), (const));
+
+    MOCK_METHOD(
+        (std::expected<uint32_t, std::string>),
+        loadSnapshot,
+        (std::filesystem::path const& a, uint32_t b, uint32_t c),
+        ()
+    );
+
+    MOCK_METHOD(void, setHistoryWindow, (uint32_t a), ());
+
+    MOCK_METHOD(uint32_t, historyWindow, (), (const));
+
+    MOCK_METHOD(void, clear, (), ());
+
     MOCK_METHOD(void, setDisabled, (), ());
 
     MOCK_METHOD(bool, isDisabled, (), (const));
@@ -61,4 +81,6 @@ struct MockCache {
     MOCK_METHOD(float, getObjectHitRate, (), (const));
 
     MOCK_METHOD(float, getSuccessorHitRate, (), (const));
+
+    MOCK_METHOD(void, waitUntilCacheContainsSeq, (uint32_t a), ());
 };
@@ -37,6 +37,11 @@ struct MockCounters {
     MOCK_METHOD(void, onBadSyntax, (), ());
     MOCK_METHOD(void, onUnknownCommand, (), ());
     MOCK_METHOD(void, onInternalError, (), ());
+    MOCK_METHOD(void, onSingleFlightHit, (), ());
+    MOCK_METHOD(void, onSingleFlightMiss, (), ());
+    MOCK_METHOD(void, onSingleFlightCoalesced, (), ());
+    MOCK_METHOD(void, onResponseCacheHit, (), ());
+    MOCK_METHOD(void, onResponseCacheMiss, (), ());
     MOCK_METHOD(boost::json::object, report, (), (const));
     MOCK_METHOD(std::chrono::seconds, uptime, (), (const));
 };
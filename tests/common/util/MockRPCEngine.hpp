@@ -33,7 +33,12 @@
 struct MockAsyncRPCEngine {
     template <typename Fn>
     bool
-    post(Fn&& func, [[maybe_unused]] std::string const& ip = "")
+    post(
+        Fn&& func,
+        [[maybe_unused]] std::string const& ip = "",
+        [[maybe_unused]] std::string const& method = "",
+        [[maybe_unused]] bool isAdmin = false
+    )
     {
         using namespace boost::asio;
         io_context ioc;
@@ -48,6 +53,7 @@ struct MockAsyncRPCEngine {
     }
 
     MOCK_METHOD(void, notifyComplete, (std::string const&, std::chrono::microseconds const&), ());
+    MOCK_METHOD(void, notifySerialized, (std::string const&, std::chrono::microseconds const&), ());
     MOCK_METHOD(void, notifyFailed, (std::string const&), ());
     MOCK_METHOD(void, notifyErrored, (std::string const&), ());
     MOCK_METHOD(void, notifyForwarded, (std::string const&), ());
@@ -61,8 +67,14 @@ struct MockAsyncRPCEngine {
 };
 
 struct MockRPCEngine {
-    MOCK_METHOD(bool, post, (std::function<void(boost::asio::yield_context)>&&, std::string const&), ());
+    MOCK_METHOD(
+        bool,
+        post,
+        (std::function<void(boost::asio::yield_context)>&&, std::string const&, std::string const&, bool),
+        ()
+    );
     MOCK_METHOD(void, notifyComplete, (std::string const&, std::chrono::microseconds const&), ());
+    MOCK_METHOD(void, notifySerialized, (std::string const&, std::chrono::microseconds const&), ());
     MOCK_METHOD(void, notifyErrored, (std::string const&), ());
     MOCK_METHOD(void, notifyForwarded, (std::string const&), ());
     MOCK_METHOD(void, notifyFailedToForward, (std::string const&), ());
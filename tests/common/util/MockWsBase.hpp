@@ -22,6 +22,7 @@
 #include "util/Taggable.hpp"
 #include "util/config/Config.hpp"
 #include "web/interface/ConnectionBase.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/beast/http/status.hpp>
 #include <gmock/gmock.h>
@@ -30,7 +31,7 @@
 #include <string>
 
 struct MockSession : public web::ConnectionBase {
-    MOCK_METHOD(void, send, (std::shared_ptr<std::string>), (override));
+    MOCK_METHOD(void, send, (std::shared_ptr<web::SubscriptionMessage const>), (override));
     MOCK_METHOD(void, send, (std::string&&, boost::beast::http::status), (override));
     util::TagDecoratorFactory tagDecoratorFactory{util::Config{}};
 
@@ -41,7 +42,7 @@ struct MockSession : public web::ConnectionBase {
 
 struct MockDeadSession : public web::ConnectionBase {
     void
-    send(std::shared_ptr<std::string>) override
+    send(std::shared_ptr<web::SubscriptionMessage const>) override
     {
         // err happen, the session should remove from subscribers
         ec_.assign(2, boost::system::system_category());
@@ -169,6 +169,14 @@ TEST_F(BackendCassandraTest, Basic)
             auto seq = backend->fetchLatestLedgerSequence(yield);
             EXPECT_EQ(seq, lgrInfoNext.seq);
         }
+        {
+            // bulk readers bypass the ledger header cache
+            auto const cachedHeaders = backend->ledgerHeaderCache().size();
+            auto retLgr = backend->hardFetchLedgerBySequence(lgrInfoNext.seq, yield);
+            ASSERT_TRUE(retLgr.has_value());
+            EXPECT_EQ(ledgerHeaderToBlob(*retLgr), ledgerHeaderToBlob(lgrInfoNext));
+            EXPECT_EQ(backend->ledgerHeaderCache().size(), cachedHeaders);
+        }
         {
             auto retLgr = backend->fetchLedgerBySequence(lgrInfoNext.seq, yield);
             EXPECT_TRUE(retLgr.has_value());
@@ -1263,3 +1271,92 @@ TEST_F(BackendCassandraTest, CacheIntegration)
     ctx.run();
     ASSERT_EQ(done, true);
 }
+
+TEST_F(BackendCassandraTest, BatchedReads)
+{
+    static constexpr auto NUM_KEYS = 25u;
+    static constexpr auto READ_BATCH_SIZE = 10u;
+
+    backend.reset();
+    Config const batchedCfg{json::parse(fmt::format(
+        R"JSON({{
+            "contact_points": "{}",
+            "keyspace": "{}",
+            "replication_factor": 1,
+            "read_batch_size": {}
+        }})JSON",
+        TestGlobals::instance().backendHost,
+        TestGlobals::instance().backendKeyspace,
+        READ_BATCH_SIZE
+    ))};
+    backend = std::make_unique<CassandraBackend>(SettingsProvider{batchedCfg}, false);
+
+    std::atomic_bool done = false;
+    std::optional<boost::asio::io_context::work> work;
+    work.emplace(ctx);
+
+    boost::asio::spawn(ctx, [this, &done, &work](boost::asio::yield_context yield) {
+        ripple::LedgerHeader first;
+        first.seq = 1000;
+        auto second = first;
+        second.seq = first.seq + 1;
+
+        std::vector<ripple::uint256> keys;
+        for (auto i = 0u; i < NUM_KEYS; ++i)
+            keys.emplace_back(i + 1);
+
+        backend->startWrites();
+        backend->writeLedger(first, ledgerHeaderToBinaryString(first));
+        for (auto const& key : keys) {
+            backend->writeLedgerObject(uint256ToString(key), first.seq, "first" + ripple::to_string(key));
+            backend->writeTransaction(uint256ToString(key), first.seq, 1, "txn" + ripple::to_string(key), "meta");
+        }
+        ASSERT_TRUE(backend->finishWrites(first.seq));
+
+        // replace even keys and delete the last one in the next ledger
+        backend->startWrites();
+        backend->writeLedger(second, ledgerHeaderToBinaryString(second));
+        for (auto i = 0u; i < NUM_KEYS; i += 2)
+            backend->writeLedgerObject(uint256ToString(keys[i]), second.seq, "second" + ripple::to_string(keys[i]));
+        backend->writeLedgerObject(uint256ToString(keys.back()), second.seq, "");
+        ASSERT_TRUE(backend->finishWrites(second.seq));
+
+        auto requested = keys;
+        requested.emplace_back(NUM_KEYS + 100);  // never written
+        requested.push_back(keys.front());       // requested twice
+
+        auto const toBlob = [](std::string const& str) { return data::Blob{str.begin(), str.end()}; };
+
+        auto const firstObjects = backend->fetchLedgerObjects(requested, first.seq, yield);
+        ASSERT_EQ(firstObjects.size(), requested.size());
+        for (auto i = 0u; i < NUM_KEYS; ++i)
+            EXPECT_EQ(firstObjects[i], toBlob("first" + ripple::to_string(keys[i])));
+        EXPECT_TRUE(firstObjects[NUM_KEYS].empty());
+        EXPECT_EQ(firstObjects[NUM_KEYS + 1], firstObjects[0]);
+
+        auto const secondObjects = backend->fetchLedgerObjects(requested, second.seq, yield);
+        ASSERT_EQ(secondObjects.size(), requested.size());
+        for (auto i = 0u; i + 1 < NUM_KEYS; ++i) {
+            auto const expected = (i % 2 == 0 ? "second" : "first") + ripple::to_string(keys[i]);
+            EXPECT_EQ(secondObjects[i], toBlob(expected));
+        }
+        EXPECT_TRUE(secondObjects[NUM_KEYS - 1].empty());
+        EXPECT_TRUE(secondObjects[NUM_KEYS].empty());
+
+        auto const transactions = backend->fetchTransactions(requested, yield);
+        ASSERT_EQ(transactions.size(), requested.size());
+        for (auto i = 0u; i < NUM_KEYS; ++i) {
+            EXPECT_EQ(transactions[i].transaction, toBlob("txn" + ripple::to_string(keys[i])));
+            EXPECT_EQ(transactions[i].metadata, toBlob("meta"));
+            EXPECT_EQ(transactions[i].ledgerSequence, first.seq);
+        }
+        EXPECT_TRUE(transactions[NUM_KEYS].transaction.empty());
+        EXPECT_EQ(transactions[NUM_KEYS + 1], transactions[0]);
+
+        done = true;
+        work.reset();
+    });
+
+    ctx.run();
+    ASSERT_EQ(done, true);
+}
@@ -18,8 +18,10 @@
 //==============================================================================
 
 #include "util/LoggerFixtures.hpp"
+#include "util/config/Config.hpp"
 #include "util/log/Logger.hpp"
 
+#include <boost/json/parse.hpp>
 #include <gtest/gtest.h>
 using namespace util;
 
@@ -73,6 +75,31 @@ TEST_F(LoggerTest, LOGMacro)
     log.trace() << compute();
     EXPECT_TRUE(computeCalled);
 }
+
+TEST_F(LoggerTest, LOGMacroChecksChannelSeverity)
+{
+    LogService::init(Config{boost::json::parse(R"JSON({
+        "log_level": "trace",
+        "log_channels": [{"channel": "RPC", "log_level": "error"}]
+    })JSON")});
+    getLoggerString();
+
+    auto computeCalled = false;
+    auto compute = [&computeCalled]() {
+        computeCalled = true;
+        return "computed";
+    };
+
+    Logger const log{"RPC"};
+    LOG(log.warn()) << compute();
+    EXPECT_FALSE(computeCalled);
+
+    LOG(Logger{"WebServer"}.trace()) << compute();
+    EXPECT_TRUE(computeCalled);
+
+    // restores the channel severities for other tests
+    LogService::init(Config{boost::json::parse(R"JSON({"log_level": "trace"})JSON")});
+}
 #endif
 
 TEST_F(NoLoggerTest, Basic)
@@ -41,6 +41,8 @@ struct BackendCountersTest : WithPrometheus {
             "too_busy": 0,
             "write_sync": 0,
             "write_sync_retry": 0,
+            "read_batched": 0,
+            "read_batched_keys": 0,
             "write_async_pending": 0,
             "write_async_completed": 0,
             "write_async_retry": 0,
@@ -194,6 +196,17 @@ TEST_F(BackendCountersTest, RegisterReadError)
     EXPECT_EQ(counters->report(), expectedReport);
 }
 
+TEST_F(BackendCountersTest, RegisterReadBatched)
+{
+    counters->registerReadBatched(10);
+    counters->registerReadBatched(5);
+
+    auto expectedReport = emptyReport();
+    expectedReport["read_batched"] = 2;
+    expectedReport["read_batched_keys"] = 15;
+    EXPECT_EQ(counters->report(), expectedReport);
+}
+
 struct BackendCountersMockPrometheusTest : WithMockPrometheus {
     BackendCounters::PtrType const counters = BackendCounters::make();
 };
@@ -295,3 +308,12 @@ TEST_F(BackendCountersMockPrometheusTest, registerReadError)
     EXPECT_CALL(errorCounter, add(1));
     counters->registerReadError();
 }
+
+TEST_F(BackendCountersMockPrometheusTest, registerReadBatched)
+{
+    auto& counter = makeMock<CounterInt>("backend_operations_total_number", "{operation=\"read_batched\"}");
+    auto& keysCounter = makeMock<CounterInt>("backend_batched_read_keys_total_number", "");
+    EXPECT_CALL(counter, add(1));
+    EXPECT_CALL(keysCounter, add(42));
+    counters->registerReadBatched(42);
+}
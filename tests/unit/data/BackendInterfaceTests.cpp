@@ -137,3 +137,57 @@ TEST_F(BackendInterfaceTest, FetchLedgerPageWithoutCorruptionDetectorDoesNotDisa
     runSpawn([this](auto yield) { backend->fetchLedgerPage(std::nullopt, MAXSEQ, 10, false, yield); });
     EXPECT_FALSE(backend->cache().isDisabled());
 }
+
+TEST_F(BackendInterfaceTest, FetchLedgerObjectViewFromCache)
+{
+    using namespace ripple;
+    auto const key = uint256{"1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"};
+    auto const blob = Blob{'s', 'l', 'e'};
+    backend->cache().update({{key, blob}}, MAXSEQ);
+
+    EXPECT_CALL(*backend, doFetchLedgerObject).Times(0);
+
+    runSpawn([&](auto yield) {
+        auto const view = backend->fetchLedgerObjectView(key, MAXSEQ, yield);
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->toBlob(), blob);
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchLedgerObjectViewFromDB)
+{
+    using namespace ripple;
+    auto const key = uint256{"1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"};
+    auto const blob = Blob{'s', 'l', 'e'};
+
+    EXPECT_CALL(*backend, doFetchLedgerObject(key, MAXSEQ, _)).WillOnce(Return(blob));
+    EXPECT_CALL(*backend, doFetchLedgerObject(key, MINSEQ, _)).WillOnce(Return(std::nullopt));
+
+    runSpawn([&](auto yield) {
+        auto const view = backend->fetchLedgerObjectView(key, MAXSEQ, yield);
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->toBlob(), blob);
+
+        EXPECT_FALSE(backend->fetchLedgerObjectView(key, MINSEQ, yield).has_value());
+    });
+}
+
+TEST_F(BackendInterfaceTest, FetchLedgerObjectViewsMixesCacheAndDB)
+{
+    using namespace ripple;
+    auto const cachedKey = uint256{"1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"};
+    auto const missedKey = uint256{"2FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF2FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"};
+    auto const cachedBlob = Blob{'c'};
+    auto const missedBlob = Blob{'d', 'b'};
+    backend->cache().update({{cachedKey, cachedBlob}}, MAXSEQ);
+
+    EXPECT_CALL(*backend, doFetchLedgerObjects(std::vector<uint256>{missedKey}, MAXSEQ, _))
+        .WillOnce(Return(std::vector<Blob>{missedBlob}));
+
+    runSpawn([&](auto yield) {
+        auto const views = backend->fetchLedgerObjectViews({missedKey, cachedKey}, MAXSEQ, yield);
+        ASSERT_EQ(views.size(), 2u);
+        EXPECT_EQ(views[0].toBlob(), missedBlob);
+        EXPECT_EQ(views[1].toBlob(), cachedBlob);
+    });
+}
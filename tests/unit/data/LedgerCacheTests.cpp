@@ -0,0 +1,377 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCache.hpp"
+#include "data/Types.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr ripple::uint256 KEY1{"00000000000000000000000000000000000000000000000000000000000000A1"};
+constexpr ripple::uint256 KEY2{"00000000000000000000000000000000000000000000000000000000000000A2"};
+constexpr ripple::uint256 KEY3{"7F000000000000000000000000000000000000000000000000000000000000A3"};
+constexpr ripple::uint256 KEY4{"FF000000000000000000000000000000000000000000000000000000000000A4"};
+
+Blob const BLOB1{1, 2, 3};
+Blob const BLOB2{4, 5, 6};
+
+}  // namespace
+
+struct LedgerCacheTest : WithPrometheus {
+    LedgerCache cache;
+};
+
+TEST_F(LedgerCacheTest, EmptyCache)
+{
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.latestLedgerSequence(), 0u);
+    EXPECT_FALSE(cache.get(KEY1, 0).has_value());
+}
+
+TEST_F(LedgerCacheTest, UpdateAndGet)
+{
+    cache.update({{KEY1, BLOB1}, {KEY3, BLOB2}}, 10);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.latestLedgerSequence(), 10u);
+    EXPECT_EQ(cache.get(KEY1, 10), BLOB1);
+    EXPECT_EQ(cache.get(KEY3, 10), BLOB2);
+    EXPECT_FALSE(cache.get(KEY2, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, GetRespectsSequence)
+{
+    cache.update({{KEY1, BLOB1}}, 10);
+    cache.update({{KEY1, BLOB2}}, 11);
+
+    EXPECT_FALSE(cache.get(KEY1, 10).has_value());
+    EXPECT_EQ(cache.get(KEY1, 11), BLOB2);
+    EXPECT_FALSE(cache.get(KEY1, 12).has_value());
+}
+
+TEST_F(LedgerCacheTest, DeleteRemovesObject)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, 10);
+    cache.update({{KEY1, {}}}, 11);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_FALSE(cache.get(KEY1, 11).has_value());
+    EXPECT_EQ(cache.get(KEY2, 11), BLOB2);
+}
+
+TEST_F(LedgerCacheTest, BackgroundUpdateDoesNotOverwriteNewerData)
+{
+    cache.update({{KEY1, BLOB2}, {KEY2, {}}}, 11);
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB1}, {KEY3, BLOB1}}, 10, true);
+
+    EXPECT_EQ(cache.get(KEY1, 11), BLOB2);
+    EXPECT_FALSE(cache.get(KEY2, 11).has_value());
+    EXPECT_EQ(cache.get(KEY3, 11), BLOB1);
+}
+
+TEST_F(LedgerCacheTest, SuccessorAndPredecessorRequireFullCache)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, 10);
+
+    EXPECT_FALSE(cache.getSuccessor(KEY1, 10).has_value());
+    EXPECT_FALSE(cache.getPredecessor(KEY2, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, SuccessorAndPredecessorWithinAndAcrossShards)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}, {KEY3, BLOB1}, {KEY4, BLOB2}}, 10);
+    cache.setFull();
+
+    auto succ = cache.getSuccessor(firstKey, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY1);
+    EXPECT_EQ(succ->blob, BLOB1);
+
+    succ = cache.getSuccessor(KEY1, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY2);
+
+    succ = cache.getSuccessor(KEY2, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY3);
+
+    succ = cache.getSuccessor(KEY3, 10);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY4);
+
+    EXPECT_FALSE(cache.getSuccessor(KEY4, 10).has_value());
+
+    auto pred = cache.getPredecessor(lastKey, 10);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, KEY4);
+
+    pred = cache.getPredecessor(KEY4, 10);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, KEY3);
+
+    pred = cache.getPredecessor(KEY3, 10);
+    ASSERT_TRUE(pred.has_value());
+    EXPECT_EQ(pred->key, KEY2);
+
+    EXPECT_FALSE(cache.getPredecessor(KEY1, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, SuccessorOnlyForLatestSequence)
+{
+    cache.update({{KEY1, BLOB1}, {KEY3, BLOB1}}, 10);
+    cache.setFull();
+    cache.update({{KEY2, BLOB2}}, 11);
+
+    EXPECT_FALSE(cache.getSuccessor(KEY1, 10).has_value());
+
+    auto const succ = cache.getSuccessor(KEY1, 11);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY2);
+}
+
+TEST_F(LedgerCacheTest, DisabledCache)
+{
+    cache.setDisabled();
+    cache.update({{KEY1, BLOB1}}, 10);
+
+    EXPECT_TRUE(cache.isDisabled());
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(KEY1, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, ReadersSeeConsistentDataWhileLedgersAreApplied)
+{
+    static constexpr uint32_t START_SEQ = 10;
+    static constexpr uint32_t NUM_LEDGERS = 200;
+
+    cache.update({{KEY1, BLOB1}, {KEY3, BLOB2}, {KEY4, BLOB1}}, START_SEQ);
+    cache.setFull();
+
+    std::atomic_bool done = false;
+    std::vector<std::thread> readers;
+    for (auto i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (not done) {
+                auto const seq = cache.latestLedgerSequence();
+
+                // KEY3 only exists in even ledgers; a successor answer must match the ledger it was asked for
+                if (auto const succ = cache.getSuccessor(KEY1, seq); succ.has_value())
+                    EXPECT_EQ(succ->key, seq % 2 == 0 ? KEY3 : KEY4);
+
+                if (auto const blob = cache.get(KEY1, seq); blob.has_value())
+                    EXPECT_EQ(blob->size(), 3u);
+            }
+        });
+    }
+
+    for (auto seq = START_SEQ + 1; seq <= START_SEQ + NUM_LEDGERS; ++seq)
+        cache.update({{KEY3, seq % 2 == 0 ? BLOB2 : Blob{}}}, seq);
+
+    done = true;
+    for (auto& reader : readers)
+        reader.join();
+}
+
+TEST_F(LedgerCacheTest, GetView)
+{
+    cache.update({{KEY1, BLOB1}}, 10);
+
+    auto const view = cache.getView(KEY1, 10);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->toBlob(), BLOB1);
+
+    EXPECT_FALSE(cache.getView(KEY2, 10).has_value());
+    EXPECT_FALSE(cache.getView(KEY1, 11).has_value());
+}
+
+TEST_F(LedgerCacheTest, ViewStaysValidAfterObjectIsReplacedAndStorageCompacted)
+{
+    cache.update({{KEY1, BLOB1}}, 10);
+    auto const view = cache.getView(KEY1, 10);
+    ASSERT_TRUE(view.has_value());
+
+    // rewriting the same object over and over leaves most of the shard storage unused which triggers compaction
+    Blob const big(1024, 7);
+    for (uint32_t seq = 11; seq < 20; ++seq)
+        cache.update({{KEY1, big}}, seq);
+    cache.update({{KEY1, {}}}, 20);
+
+    EXPECT_EQ(view->toBlob(), BLOB1);
+    EXPECT_FALSE(cache.get(KEY1, 20).has_value());
+}
+
+TEST_F(LedgerCacheTest, ObjectsSurviveCompaction)
+{
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, 10);
+
+    Blob const big(1024, 7);
+    for (uint32_t seq = 11; seq < 20; ++seq)
+        cache.update({{KEY1, big}}, seq);
+
+    EXPECT_EQ(cache.get(KEY1, 19), big);
+    EXPECT_EQ(cache.get(KEY2, 19), BLOB2);
+}
+
+TEST_F(LedgerCacheTest, HistoryIsDisabledByDefault)
+{
+    cache.update({{KEY1, BLOB1}}, 10);
+    cache.update({{KEY1, BLOB2}}, 11);
+
+    EXPECT_EQ(cache.historyWindow(), 0u);
+    EXPECT_FALSE(cache.get(KEY1, 10).has_value());
+}
+
+TEST_F(LedgerCacheTest, HistoryServesReplacedAndDeletedObjects)
+{
+    cache.setHistoryWindow(4);
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB1}}, 10);
+    cache.update({{KEY1, BLOB2}}, 11);
+    cache.update({{KEY2, {}}}, 12);
+
+    EXPECT_EQ(cache.get(KEY1, 10), BLOB1);
+    EXPECT_EQ(cache.get(KEY1, 11), BLOB2);
+    EXPECT_EQ(cache.get(KEY1, 12), BLOB2);
+
+    EXPECT_EQ(cache.get(KEY2, 10), BLOB1);
+    EXPECT_EQ(cache.get(KEY2, 11), BLOB1);
+    EXPECT_FALSE(cache.get(KEY2, 12).has_value());
+
+    // ledgers before the object was cached are still unknown
+    EXPECT_FALSE(cache.get(KEY1, 9).has_value());
+}
+
+TEST_F(LedgerCacheTest, HistoryOnlyCoversWindow)
+{
+    static constexpr uint32_t WINDOW = 2;
+
+    cache.setHistoryWindow(WINDOW);
+    cache.update({{KEY1, BLOB1}, {KEY4, BLOB1}}, 10);
+    cache.update({{KEY1, BLOB2}, {KEY4, BLOB2}}, 11);
+    for (uint32_t seq = 12; seq <= 11 + WINDOW; ++seq)
+        cache.update({{KEY1, Blob{static_cast<unsigned char>(seq)}}}, seq);
+
+    EXPECT_FALSE(cache.get(KEY1, 10).has_value());
+    EXPECT_EQ(cache.get(KEY1, 11), BLOB2);
+
+    // shards not touched by the later ledgers drop their expired versions as well
+    for (uint32_t seq = 12 + WINDOW; seq < 12 + WINDOW + 64; ++seq)
+        cache.update({{KEY1, Blob{static_cast<unsigned char>(seq)}}}, seq);
+    EXPECT_FALSE(cache.get(KEY4, 10).has_value());
+    EXPECT_EQ(cache.get(KEY4, 11), BLOB2);
+}
+
+TEST_F(LedgerCacheTest, HistorySurvivesCompaction)
+{
+    cache.setHistoryWindow(32);
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, 10);
+
+    Blob const big(1024, 7);
+    for (uint32_t seq = 11; seq < 20; ++seq)
+        cache.update({{KEY2, big}, {KEY2, {}}}, seq);
+
+    EXPECT_EQ(cache.get(KEY1, 19), BLOB1);
+    EXPECT_EQ(cache.get(KEY2, 10), BLOB2);
+    EXPECT_FALSE(cache.get(KEY2, 15).has_value());
+}
+
+TEST_F(LedgerCacheTest, SnapshotRequiresFullCache)
+{
+    TmpFile const file{""};
+    cache.update({{KEY1, BLOB1}}, 10);
+
+    EXPECT_FALSE(cache.writeSnapshot(file.path).has_value());
+}
+
+TEST_F(LedgerCacheTest, SnapshotRoundTrip)
+{
+    TmpFile const file{""};
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB1}, {KEY3, BLOB2}, {KEY4, BLOB1}}, 10);
+    cache.setFull();
+    cache.update({{KEY2, BLOB2}}, 11);
+
+    auto const written = cache.writeSnapshot(file.path);
+    ASSERT_TRUE(written.has_value()) << written.error();
+    EXPECT_EQ(*written, 11u);
+
+    LedgerCache restored;
+    auto const loaded = restored.loadSnapshot(file.path, 0, 11);
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(*loaded, 11u);
+
+    EXPECT_EQ(restored.size(), 4u);
+    EXPECT_EQ(restored.latestLedgerSequence(), 11u);
+    EXPECT_FALSE(restored.isFull());
+    EXPECT_EQ(restored.get(KEY1, 10), BLOB1);
+    EXPECT_FALSE(restored.get(KEY2, 10).has_value());
+    EXPECT_EQ(restored.get(KEY2, 11), BLOB2);
+
+    // catching up with newer ledgers works like with a regular cache
+    restored.update({{KEY3, {}}}, 12);
+    restored.setFull();
+
+    auto const succ = restored.getSuccessor(KEY2, 12);
+    ASSERT_TRUE(succ.has_value());
+    EXPECT_EQ(succ->key, KEY4);
+}
+
+TEST_F(LedgerCacheTest, SnapshotOutsideOfRangeIsNotLoaded)
+{
+    TmpFile const file{""};
+    cache.update({{KEY1, BLOB1}}, 10);
+    cache.setFull();
+    ASSERT_TRUE(cache.writeSnapshot(file.path).has_value());
+
+    LedgerCache restored;
+    EXPECT_FALSE(restored.loadSnapshot(file.path, 11, 20).has_value());
+    EXPECT_EQ(restored.size(), 0u);
+    EXPECT_EQ(restored.latestLedgerSequence(), 0u);
+}
+
+TEST_F(LedgerCacheTest, PartiallyRestoredSnapshotIsCleared)
+{
+    TmpFile const file{""};
+    cache.update({{KEY1, BLOB1}, {KEY2, BLOB2}}, 10);
+    cache.setFull();
+    ASSERT_TRUE(cache.writeSnapshot(file.path).has_value());
+
+    LedgerCache restored;
+    ASSERT_TRUE(restored.loadSnapshot(file.path, 0, 20).has_value());
+    restored.update({{KEY3, BLOB1}}, 11);
+
+    restored.clear();
+    EXPECT_EQ(restored.size(), 0u);
+    EXPECT_EQ(restored.latestLedgerSequence(), 0u);
+    EXPECT_FALSE(restored.get(KEY1, 10).has_value());
+
+    // the cleared cache is loaded like a new one
+    restored.update({{KEY2, BLOB1}}, 20, true);
+    EXPECT_EQ(restored.latestLedgerSequence(), 20u);
+    EXPECT_EQ(restored.get(KEY2, 20), BLOB1);
+}
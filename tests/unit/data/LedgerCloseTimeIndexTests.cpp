@@ -0,0 +1,190 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerCloseTimeIndex.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/chrono.h>
+
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <optional>
+#include <vector>
+
+using namespace data;
+
+namespace {
+
+constexpr std::uint32_t FIRST_SEQ = 100;
+
+ripple::NetClock::time_point
+netTime(std::uint32_t seconds)
+{
+    return ripple::NetClock::time_point{ripple::NetClock::duration{seconds}};
+}
+
+}  // namespace
+
+struct LedgerCloseTimeIndexTest : ::testing::Test {
+    // ledgers 100-104 closing at 1000, 1004, 1004, 1010 and 1013
+    LedgerCloseTimeIndex index{FIRST_SEQ, {1000, 1004, 1004, 1010, 1013}};
+};
+
+TEST_F(LedgerCloseTimeIndexTest, EmptyIndexHasNoLedgers)
+{
+    LedgerCloseTimeIndex const empty;
+
+    EXPECT_FALSE(empty.range().has_value());
+    EXPECT_FALSE(empty.lastLedgerClosedBy(netTime(1000)).has_value());
+    EXPECT_FALSE(empty.closeTime(FIRST_SEQ).has_value());
+}
+
+TEST_F(LedgerCloseTimeIndexTest, LastLedgerClosedBy)
+{
+    EXPECT_FALSE(index.lastLedgerClosedBy(netTime(999)).has_value());
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1000)), 100u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1003)), 100u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1004)), 102u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1012)), 103u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(5000)), 104u);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, CloseTime)
+{
+    EXPECT_FALSE(index.closeTime(FIRST_SEQ - 1).has_value());
+    EXPECT_EQ(index.closeTime(FIRST_SEQ), netTime(1000));
+    EXPECT_EQ(index.closeTime(104), netTime(1013));
+    EXPECT_FALSE(index.closeTime(105).has_value());
+}
+
+TEST_F(LedgerCloseTimeIndexTest, AddAppendsNextLedger)
+{
+    EXPECT_TRUE(index.add(105, netTime(1016)));
+    EXPECT_TRUE(index.add(103, netTime(2000)));  // already known
+
+    ASSERT_TRUE(index.range().has_value());
+    EXPECT_EQ(index.range()->minSequence, FIRST_SEQ);
+    EXPECT_EQ(index.range()->maxSequence, 105u);
+    EXPECT_EQ(index.closeTime(103), netTime(1010));
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1020)), 105u);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, AddRejectsLedgerAfterGap)
+{
+    EXPECT_FALSE(index.add(110, netTime(1040)));
+
+    ASSERT_TRUE(index.range().has_value());
+    EXPECT_EQ(index.range()->minSequence, 100u);
+    EXPECT_EQ(index.range()->maxSequence, 104u);
+    EXPECT_FALSE(index.closeTime(110).has_value());
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1013)), 104u);
+
+    // the index continues from where it was
+    EXPECT_TRUE(index.add(105, netTime(1020)));
+    EXPECT_EQ(index.range()->maxSequence, 105u);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, PrependOverlappingIndex)
+{
+    LedgerCloseTimeIndex const older{97, {990, 994, 997, 1000, 1004}};
+
+    EXPECT_TRUE(index.prepend(older));
+    ASSERT_TRUE(index.range().has_value());
+    EXPECT_EQ(index.range()->minSequence, 97u);
+    EXPECT_EQ(index.range()->maxSequence, 104u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(995)), 98u);
+    EXPECT_EQ(index.lastLedgerClosedBy(netTime(1004)), 102u);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, PrependIntoEmptyIndex)
+{
+    LedgerCloseTimeIndex empty;
+
+    EXPECT_TRUE(empty.prepend(index));
+    ASSERT_TRUE(empty.range().has_value());
+    EXPECT_EQ(empty.range()->minSequence, FIRST_SEQ);
+    EXPECT_EQ(empty.range()->maxSequence, 104u);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, PrependWithGapFails)
+{
+    LedgerCloseTimeIndex const older{90, {900, 910}};
+
+    EXPECT_FALSE(index.prepend(older));
+    EXPECT_EQ(index.range()->minSequence, FIRST_SEQ);
+}
+
+TEST_F(LedgerCloseTimeIndexTest, SaveAndLoad)
+{
+    TmpFile const file{""};
+
+    auto const saved = index.save(file.path);
+    ASSERT_TRUE(saved.has_value()) << saved.error();
+    EXPECT_EQ(saved->minSequence, FIRST_SEQ);
+    EXPECT_EQ(saved->maxSequence, 104u);
+
+    LedgerCloseTimeIndex restored;
+    auto const loaded = restored.load(file.path);
+    ASSERT_TRUE(loaded.has_value()) << loaded.error();
+    EXPECT_EQ(loaded->minSequence, FIRST_SEQ);
+    EXPECT_EQ(loaded->maxSequence, 104u);
+
+    for (auto seq = FIRST_SEQ; seq <= 104u; ++seq)
+        EXPECT_EQ(restored.closeTime(seq), index.closeTime(seq));
+}
+
+TEST_F(LedgerCloseTimeIndexTest, SaveEmptyIndexFails)
+{
+    TmpFile const file{""};
+
+    EXPECT_FALSE(LedgerCloseTimeIndex{}.save(file.path).has_value());
+}
+
+TEST_F(LedgerCloseTimeIndexTest, LoadRejectsCorruptedFile)
+{
+    TmpFile const file{""};
+    ASSERT_TRUE(index.save(file.path).has_value());
+
+    {
+        std::fstream stream{file.path, std::ios::in | std::ios::out | std::ios::binary};
+        stream.seekp(24);
+        stream.put('\x7f');
+    }
+
+    LedgerCloseTimeIndex restored;
+    EXPECT_FALSE(restored.load(file.path).has_value());
+    EXPECT_FALSE(restored.range().has_value());
+}
+
+TEST_F(LedgerCloseTimeIndexTest, LoadRejectsMissingFile)
+{
+    LedgerCloseTimeIndex restored;
+
+    EXPECT_FALSE(restored.load("/nonexistent/close_times").has_value());
+}
+
+TEST_F(LedgerCloseTimeIndexTest, LoadIntoNonEmptyIndexFails)
+{
+    TmpFile const file{""};
+    ASSERT_TRUE(index.save(file.path).has_value());
+
+    EXPECT_FALSE(index.load(file.path).has_value());
+}
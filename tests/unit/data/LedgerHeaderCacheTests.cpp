@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/LedgerHeaderCache.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/TestObject.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstdint>
+
+using namespace data;
+
+namespace {
+
+constexpr auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto LEDGERHASH2 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr std::uint32_t SEQ = 30;
+
+}  // namespace
+
+struct LedgerHeaderCacheTest : WithPrometheus {
+    LedgerHeaderCache cache;
+};
+
+TEST_F(LedgerHeaderCacheTest, EmptyCache)
+{
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_FALSE(cache.get(SEQ).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{LEDGERHASH}).has_value());
+}
+
+TEST_F(LedgerHeaderCacheTest, GetBySequenceAndHash)
+{
+    cache.put(CreateLedgerHeader(LEDGERHASH, SEQ));
+
+    auto const bySequence = cache.get(SEQ);
+    ASSERT_TRUE(bySequence.has_value());
+    EXPECT_EQ(bySequence->hash, ripple::uint256{LEDGERHASH});
+
+    auto const byHash = cache.get(ripple::uint256{LEDGERHASH});
+    ASSERT_TRUE(byHash.has_value());
+    EXPECT_EQ(byHash->seq, SEQ);
+
+    EXPECT_FALSE(cache.get(SEQ + 1).has_value());
+    EXPECT_FALSE(cache.get(ripple::uint256{LEDGERHASH2}).has_value());
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(LedgerHeaderCacheTest, HashOfReplacedHeaderIsNotFound)
+{
+    cache.put(CreateLedgerHeader(LEDGERHASH, SEQ));
+    cache.put(CreateLedgerHeader(LEDGERHASH2, SEQ));
+
+    EXPECT_FALSE(cache.get(ripple::uint256{LEDGERHASH}).has_value());
+    ASSERT_TRUE(cache.get(ripple::uint256{LEDGERHASH2}).has_value());
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST_F(LedgerHeaderCacheTest, LeastRecentlyUsedHeaderIsEvicted)
+{
+    // capacity is split between 16 shards keyed by sequence, so every 16th sequence lands in the same shard
+    LedgerHeaderCache small{32};
+    small.put(CreateLedgerHeader(LEDGERHASH, SEQ));
+    small.put(CreateLedgerHeader(LEDGERHASH, SEQ + 16));
+    EXPECT_TRUE(small.get(SEQ).has_value());
+
+    small.put(CreateLedgerHeader(LEDGERHASH, SEQ + 32));
+    EXPECT_TRUE(small.get(SEQ).has_value());
+    EXPECT_FALSE(small.get(SEQ + 16).has_value());
+    EXPECT_TRUE(small.get(SEQ + 32).has_value());
+    EXPECT_EQ(small.size(), 2u);
+}
+
+TEST_F(LedgerHeaderCacheTest, ZeroCapacityDisablesCache)
+{
+    LedgerHeaderCache disabled{0};
+    disabled.put(CreateLedgerHeader(LEDGERHASH, SEQ));
+
+    EXPECT_FALSE(disabled.get(SEQ).has_value());
+    EXPECT_EQ(disabled.size(), 0u);
+}
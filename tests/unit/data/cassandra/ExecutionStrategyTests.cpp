@@ -89,6 +89,7 @@ protected:
             registerReadErrorImpl(count);
         }
         MOCK_METHOD(void, registerReadErrorImpl, (std::uint64_t), ());
+        MOCK_METHOD(void, registerReadBatched, (std::uint64_t), ());
         MOCK_METHOD(boost::json::object, report, (), ());
     };
 
@@ -335,6 +336,37 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInCoroutineThrowsOnFailure
     });
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadBatchedSplitsKeysIntoBatches)
+{
+    static constexpr auto NUM_KEYS = 7u;
+    static constexpr auto BATCH_SIZE = 3u;
+    auto strat = makeStrategy();
+
+    ON_CALL(handle, asyncExecute(A<FakeStatement const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const&, auto&& cb) {
+            cb({});  // pretend we got data
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<FakeStatement const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(NUM_STATEMENTS);  // once per batch
+    EXPECT_CALL(*counters, registerReadBatched(BATCH_SIZE)).Times(2);
+    EXPECT_CALL(*counters, registerReadBatched(1));
+    EXPECT_CALL(*counters, registerReadStartedImpl(NUM_STATEMENTS));
+    EXPECT_CALL(*counters, registerReadFinishedImpl(testing::_, NUM_STATEMENTS));
+
+    runSpawn([&strat](boost::asio::yield_context yield) {
+        auto const keys = std::vector<int64_t>(NUM_KEYS);
+        auto res = strat.readBatched(yield, FakePreparedStatement{}, keys, BATCH_SIZE);
+        EXPECT_EQ(res.size(), NUM_STATEMENTS);
+    });
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, WriteSyncFirstTrySuccessful)
 {
     auto strat = makeStrategy();
@@ -405,6 +437,42 @@ TEST_F(BackendCassandraExecutionStrategyTest, WriteMultipleAndCallSyncSucceeds)
     thread.join();
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, SyncOfWriteGroupDoesNotWaitForLaterGroups)
+{
+    auto strat = makeStrategy();
+    std::vector<std::function<void(FakeResultOrError)>> callbacks;
+
+    ON_CALL(handle, asyncExecute(A<std::vector<FakeStatement> const&>(), A<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callbacks](auto const&, auto&& cb) {
+            callbacks.push_back(std::forward<decltype(cb)>(cb));
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle,
+        asyncExecute(
+            A<std::vector<FakeStatement> const&>(),
+            A<std::function<void(FakeResultOrError)>&&>()
+        )
+    )
+        .Times(2);
+    EXPECT_CALL(*counters, registerWriteStarted()).Times(2);
+    EXPECT_CALL(*counters, registerWriteFinished(testing::_)).Times(2);
+
+    auto const first = strat.startWriteGroup();
+    strat.write(std::vector<FakeStatement>(1));
+    auto const second = strat.startWriteGroup();
+    strat.write(std::vector<FakeStatement>(1));
+    ASSERT_EQ(callbacks.size(), 2u);
+    EXPECT_LT(first, second);
+
+    callbacks[0]({});
+    strat.sync(first);  // the write of the second group is still in flight
+
+    callbacks[1]({});
+    strat.sync(second);
+    strat.sync();
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, StatsCallsCountersReport)
 {
     auto strat = makeStrategy();
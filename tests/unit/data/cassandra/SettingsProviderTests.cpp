@@ -58,6 +58,7 @@ TEST_F(SettingsProviderTest, Defaults)
     EXPECT_EQ(settings.username, std::nullopt);
     EXPECT_EQ(settings.password, std::nullopt);
     EXPECT_EQ(settings.queueSizeIO, std::nullopt);
+    EXPECT_EQ(settings.readBatchSize, 0);
 
     auto const* cp = std::get_if<Settings::ContactPoints>(&settings.connectionInfo);
     ASSERT_TRUE(cp != nullptr);
@@ -106,6 +107,17 @@ TEST_F(SettingsProviderTest, DriverOptionalOptionsSpecified)
     EXPECT_EQ(settings.queueSizeIO, 2);
 }
 
+TEST_F(SettingsProviderTest, ReadBatchSize)
+{
+    Config const cfg{json::parse(R"({
+        "contact_points": "123.123.123.123",
+        "read_batch_size": 100
+    })")};
+    SettingsProvider const provider{cfg};
+
+    EXPECT_EQ(provider.getSettings().readBatchSize, 100);
+}
+
 TEST_F(SettingsProviderTest, SecureBundleConfig)
 {
     Config const cfg{json::parse(R"({"secure_connect_bundle": "bundleData"})")};
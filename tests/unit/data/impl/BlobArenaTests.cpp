@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/BlobArena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <utility>
+
+using namespace data;
+using namespace data::impl;
+
+TEST(BlobArenaTests, Empty)
+{
+    BlobArena const arena;
+
+    EXPECT_EQ(arena.allocatedBytes(), 0u);
+    EXPECT_EQ(arena.liveBytes(), 0u);
+    EXPECT_FALSE(arena.shouldCompact());
+}
+
+TEST(BlobArenaTests, AppendAndRead)
+{
+    BlobArena arena;
+    Blob const first{1, 2, 3};
+    Blob const second{4, 5};
+
+    auto const firstRef = arena.append(first);
+    auto const secondRef = arena.append(second);
+
+    EXPECT_EQ(arena.liveBytes(), 5u);
+    EXPECT_EQ(arena.allocatedBytes(), BlobArena::MIN_SLAB_SIZE);
+    EXPECT_EQ(firstRef.slab, secondRef.slab);
+
+    auto const firstBytes = arena.bytes(firstRef);
+    EXPECT_EQ(Blob(firstBytes.begin(), firstBytes.end()), first);
+    EXPECT_EQ(arena.view(secondRef).toBlob(), second);
+}
+
+TEST(BlobArenaTests, AppendEmpty)
+{
+    BlobArena arena;
+    auto const ref = arena.append(Blob{});
+
+    EXPECT_EQ(ref.size, 0u);
+    EXPECT_EQ(arena.allocatedBytes(), 0u);
+    EXPECT_TRUE(arena.bytes(ref).empty());
+    EXPECT_TRUE(arena.view(ref).empty());
+}
+
+TEST(BlobArenaTests, BigBlobGetsItsOwnSlab)
+{
+    BlobArena arena;
+    Blob const big(BlobArena::MAX_SLAB_SIZE + 1, 42);
+
+    auto const ref = arena.append(big);
+
+    EXPECT_EQ(arena.allocatedBytes(), big.size());
+    EXPECT_EQ(arena.view(ref).toBlob(), big);
+}
+
+TEST(BlobArenaTests, ReserveMakesAppendsShareOneSlab)
+{
+    BlobArena arena;
+    arena.reserve(10 * BlobArena::MIN_SLAB_SIZE);
+
+    Blob const blob(BlobArena::MIN_SLAB_SIZE, 1);
+    for (std::size_t i = 0; i < 10; ++i)
+        EXPECT_EQ(arena.append(blob).slab, 0u);
+
+    EXPECT_EQ(arena.allocatedBytes(), 10 * BlobArena::MIN_SLAB_SIZE);
+}
+
+TEST(BlobArenaTests, ReleaseMakesCompactionWorthIt)
+{
+    BlobArena arena;
+    Blob const blob(BlobArena::MIN_SLAB_SIZE, 1);
+
+    auto const keep = arena.append(blob);
+    for (std::size_t i = 0; i < 4; ++i)
+        arena.release(arena.append(blob));
+
+    EXPECT_EQ(arena.liveBytes(), blob.size());
+    EXPECT_TRUE(arena.shouldCompact());
+
+    BlobArena fresh;
+    fresh.reserve(arena.liveBytes());
+    auto const moved = fresh.append(arena.bytes(keep));
+
+    EXPECT_EQ(fresh.allocatedBytes(), blob.size());
+    EXPECT_FALSE(fresh.shouldCompact());
+    EXPECT_EQ(fresh.view(moved).toBlob(), blob);
+}
+
+TEST(BlobArenaTests, ViewOutlivesArena)
+{
+    Blob const blob{1, 2, 3};
+    BlobView view;
+    {
+        BlobArena arena;
+        view = arena.view(arena.append(blob));
+    }
+
+    EXPECT_EQ(view.toBlob(), blob);
+}
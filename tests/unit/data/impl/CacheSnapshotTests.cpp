@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/Types.hpp"
+#include "data/impl/CacheSnapshot.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+
+using namespace data;
+using namespace data::impl;
+
+namespace {
+
+constexpr ripple::uint256 KEY1{"00000000000000000000000000000000000000000000000000000000000000A1"};
+constexpr ripple::uint256 KEY2{"7F000000000000000000000000000000000000000000000000000000000000A2"};
+constexpr uint32_t SEQ = 30;
+
+Blob const BLOB1{1, 2, 3};
+Blob const BLOB2{4, 5};
+
+}  // namespace
+
+struct CacheSnapshotTests : ::testing::Test {
+    TmpFile const file{""};
+
+    void
+    writeSnapshot()
+    {
+        auto writer = CacheSnapshotWriter::open(file.path, SEQ);
+        ASSERT_TRUE(writer.has_value()) << writer.error();
+
+        writer->add({.key = KEY1, .seq = SEQ - 1, .data = BLOB1});
+        writer->add({.key = KEY2, .seq = SEQ, .data = BLOB2});
+
+        auto const written = writer->commit();
+        ASSERT_TRUE(written.has_value()) << written.error();
+        EXPECT_EQ(*written, 2u);
+    }
+};
+
+TEST_F(CacheSnapshotTests, WriteAndRead)
+{
+    writeSnapshot();
+
+    auto reader = CacheSnapshotReader::open(file.path);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+    EXPECT_EQ(reader->seq(), SEQ);
+    EXPECT_EQ(reader->size(), 2u);
+
+    auto object = reader->next();
+    ASSERT_TRUE(object.has_value());
+    EXPECT_EQ(object->key, KEY1);
+    EXPECT_EQ(object->seq, SEQ - 1);
+    EXPECT_EQ(Blob(object->data.begin(), object->data.end()), BLOB1);
+
+    object = reader->next();
+    ASSERT_TRUE(object.has_value());
+    EXPECT_EQ(object->key, KEY2);
+    EXPECT_EQ(object->seq, SEQ);
+    EXPECT_EQ(Blob(object->data.begin(), object->data.end()), BLOB2);
+
+    EXPECT_FALSE(reader->next().has_value());
+}
+
+TEST_F(CacheSnapshotTests, CorruptedSnapshotIsRejected)
+{
+    writeSnapshot();
+
+    {
+        std::fstream stream{file.path, std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekp(20);
+        stream.put('X');
+    }
+
+    auto const reader = CacheSnapshotReader::open(file.path);
+    ASSERT_FALSE(reader.has_value());
+    EXPECT_NE(reader.error().find("checksum"), std::string::npos);
+}
+
+TEST_F(CacheSnapshotTests, MissingFile)
+{
+    EXPECT_FALSE(CacheSnapshotReader::open(file.path + ".missing").has_value());
+}
+
+TEST_F(CacheSnapshotTests, UnfinishedSnapshotDoesNotReplaceExistingOne)
+{
+    writeSnapshot();
+
+    {
+        auto writer = CacheSnapshotWriter::open(file.path, SEQ + 1);
+        ASSERT_TRUE(writer.has_value());
+        writer->add({.key = KEY1, .seq = SEQ + 1, .data = BLOB2});
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+
+    auto const reader = CacheSnapshotReader::open(file.path);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(reader->seq(), SEQ);
+}
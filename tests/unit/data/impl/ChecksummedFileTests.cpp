@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/impl/ChecksummedFile.hpp"
+#include "util/TmpFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <string>
+#include <string_view>
+
+using namespace data::impl;
+
+namespace {
+
+constexpr std::string_view CONTENT = "some content";
+
+}  // namespace
+
+struct ChecksummedFileTests : ::testing::Test {
+    TmpFile const file{""};
+
+    void
+    writeFile()
+    {
+        auto writer = ChecksummedFileWriter::open(file.path);
+        ASSERT_TRUE(writer.has_value()) << writer.error();
+
+        writer->write(CONTENT.data(), 4);
+        writer->write(CONTENT.data() + 4, CONTENT.size() - 4);
+
+        auto const committed = writer->commit();
+        ASSERT_TRUE(committed.has_value()) << committed.error();
+    }
+};
+
+TEST_F(ChecksummedFileTests, WriteAndRead)
+{
+    writeFile();
+    EXPECT_EQ(std::filesystem::file_size(file.path), CONTENT.size() + sizeof(uint32_t));
+    EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+
+    auto const reader = ChecksummedFileReader::open(file.path);
+    ASSERT_TRUE(reader.has_value()) << reader.error();
+
+    auto const content = reader->content();
+    EXPECT_EQ(std::string(content.begin(), content.end()), CONTENT);
+}
+
+TEST_F(ChecksummedFileTests, CorruptedFileIsRejected)
+{
+    writeFile();
+
+    {
+        std::fstream stream{file.path, std::ios::binary | std::ios::in | std::ios::out};
+        stream.seekp(2);
+        stream.put('X');
+    }
+
+    auto const reader = ChecksummedFileReader::open(file.path);
+    ASSERT_FALSE(reader.has_value());
+    EXPECT_NE(reader.error().find("checksum"), std::string::npos);
+}
+
+TEST_F(ChecksummedFileTests, FileTooSmallForChecksumIsRejected)
+{
+    {
+        std::ofstream stream{file.path, std::ios::binary | std::ios::trunc};
+        stream << "ab";
+    }
+
+    EXPECT_FALSE(ChecksummedFileReader::open(file.path).has_value());
+}
+
+TEST_F(ChecksummedFileTests, MissingFile)
+{
+    EXPECT_FALSE(ChecksummedFileReader::open(file.path + ".missing").has_value());
+}
+
+TEST_F(ChecksummedFileTests, UncommittedFileDoesNotReplaceExistingOne)
+{
+    writeFile();
+
+    {
+        auto writer = ChecksummedFileWriter::open(file.path);
+        ASSERT_TRUE(writer.has_value());
+        writer->write("other", 5);
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+
+    auto const reader = ChecksummedFileReader::open(file.path);
+    ASSERT_TRUE(reader.has_value());
+    EXPECT_EQ(reader->content().size(), CONTENT.size());
+}
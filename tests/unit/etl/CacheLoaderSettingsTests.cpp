@@ -70,6 +70,24 @@ TEST_F(CacheLoaderSettingsTest, PageFetchSizeCorrectlyPropagatedThroughConfig)
     EXPECT_EQ(settings.cachePageFetchSize, 42);
 }
 
+TEST_F(CacheLoaderSettingsTest, HistoryWindowCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg = util::Config{json::parse(R"({"cache": {"history_window": 16}})")};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.historyWindow, 16);
+}
+
+TEST_F(CacheLoaderSettingsTest, SnapshotSettingsCorrectlyPropagatedThroughConfig)
+{
+    auto const cfg =
+        util::Config{json::parse(R"({"cache": {"snapshot_path": "/var/lib/clio/cache", "snapshot_interval": 42}})")};
+    auto const settings = make_CacheLoaderSettings(cfg);
+
+    EXPECT_EQ(settings.snapshotPath, "/var/lib/clio/cache");
+    EXPECT_EQ(settings.snapshotInterval, 42);
+}
+
 TEST_F(CacheLoaderSettingsTest, SyncLoadStyleCorrectlyPropagatedThroughConfig)
 {
     auto const cfg = util::Config{json::parse(R"({"cache": {"load": "sYNC"}})")};
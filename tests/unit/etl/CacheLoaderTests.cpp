@@ -32,6 +32,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <expected>
+#include <string>
 #include <vector>
 
 namespace json = boost::json;
@@ -230,6 +232,14 @@ TEST_F(CacheLoaderTest, AsyncCacheLoaderCanBeStopped)
     loader.wait();
 }
 
+TEST_F(CacheLoaderTest, HistoryWindowIsPassedToCache)
+{
+    auto const cfg = util::Config(json::parse(R"({"cache": {"load": "none", "history_window": 16}})"));
+
+    EXPECT_CALL(cache, setHistoryWindow(16));
+    CacheLoader const loader{cfg, backend, cache};
+}
+
 TEST_F(CacheLoaderTest, DisabledCacheLoaderDoesNotLoadCache)
 {
     auto cfg = util::Config(json::parse(R"({"cache": {"load": "none"}})"));
@@ -241,3 +251,103 @@ TEST_F(CacheLoaderTest, DisabledCacheLoaderDoesNotLoadCache)
 
     loader.load(SEQ);
 }
+
+TEST_F(CacheLoaderTest, CacheIsRestoredFromSnapshotAndCaughtUp)
+{
+    auto const cfg =
+        util::Config(json::parse(R"({"cache": {"load": "async", "snapshot_path": "/tmp/cache.snapshot"}})"));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+
+    EXPECT_CALL(cache, loadSnapshot(std::filesystem::path{"/tmp/cache.snapshot"}, 0, SEQ)).WillOnce(Return(SEQ - 2));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ - 1, _)).WillOnce(Return(diffs));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillOnce(Return(diffs));
+    EXPECT_CALL(cache, updateImp(diffs, SEQ - 1, false));
+    EXPECT_CALL(cache, updateImp(diffs, SEQ, false));
+    EXPECT_CALL(cache, setFull);
+    EXPECT_CALL(cache, clear).Times(0);
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(0);
+    EXPECT_CALL(cache, isFull).WillRepeatedly(Return(false));
+
+    loader.load(SEQ);
+    loader.wait();
+}
+
+TEST_F(CacheLoaderTest, SnapshotIsCaughtUpBeforeSyncLoadReturns)
+{
+    auto const cfg =
+        util::Config(json::parse(R"({"cache": {"load": "sync", "snapshot_path": "/tmp/cache.snapshot"}})"));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+
+    EXPECT_CALL(cache, loadSnapshot).WillOnce(Return(SEQ - 1));
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).WillOnce(Return(diffs));
+    EXPECT_CALL(cache, updateImp(diffs, SEQ, false));
+    EXPECT_CALL(cache, setFull);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, CacheIsLoadedFromDatabaseIfSnapshotCanNotBeCaughtUp)
+{
+    auto const cfg =
+        util::Config(json::parse(R"({"cache": {"load": "sync", "snapshot_path": "/tmp/cache.snapshot"}})"));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    auto const loops = diffs.size() + 1;
+    auto const keysSize = 14;
+
+    EXPECT_CALL(cache, loadSnapshot).WillOnce(Return(SEQ - 1));
+    EXPECT_CALL(cache, clear);
+    EXPECT_CALL(cache, setDisabled).Times(0);
+
+    // the first read of the diff fails, then cursors are made from the diffs of the last 32 ledgers
+    EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _))
+        .WillOnce(Return(std::vector<LedgerObject>{}))
+        .WillOnce(Return(diffs));
+    EXPECT_CALL(*backend, fetchLedgerDiff(Lt(SEQ), _)).Times(31).WillRepeatedly(Return(diffs));
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(keysSize * loops).WillRepeatedly([this]() {
+        return diffProvider.nextKey(keysSize);
+    });
+    EXPECT_CALL(*backend, doFetchLedgerObjects(_, SEQ, _))
+        .Times(loops)
+        .WillRepeatedly(Return(std::vector<Blob>{keysSize - 1, Blob{'s'}}));
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, updateImp).Times(loops);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(SEQ);
+}
+
+TEST_F(CacheLoaderTest, CacheIsLoadedFromDatabaseIfSnapshotIsUnusable)
+{
+    auto const cfg =
+        util::Config(json::parse(R"({"cache": {"load": "sync", "snapshot_path": "/tmp/cache.snapshot"}})"));
+    CacheLoader loader{cfg, backend, cache};
+
+    auto const diffs = diffProvider.getLatestDiff();
+    auto const loops = diffs.size() + 1;
+    auto const keysSize = 14;
+
+    EXPECT_CALL(cache, loadSnapshot).WillOnce(Return(std::unexpected<std::string>{"no snapshot"}));
+    EXPECT_CALL(*backend, fetchLedgerDiff(_, _)).Times(32).WillRepeatedly(Return(diffs));
+    EXPECT_CALL(*backend, doFetchSuccessorKey).Times(keysSize * loops).WillRepeatedly([this]() {
+        return diffProvider.nextKey(keysSize);
+    });
+    EXPECT_CALL(*backend, doFetchLedgerObjects(_, SEQ, _))
+        .Times(loops)
+        .WillRepeatedly(Return(std::vector<Blob>{keysSize - 1, Blob{'s'}}));
+
+    EXPECT_CALL(cache, isDisabled).WillRepeatedly(Return(false));
+    EXPECT_CALL(cache, updateImp).Times(loops);
+    EXPECT_CALL(cache, isFull).WillOnce(Return(false)).WillRepeatedly(Return(true));
+    EXPECT_CALL(cache, setFull).Times(1);
+
+    loader.load(SEQ);
+}
@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/BackendInterface.hpp"
+#include "data/Types.hpp"
+#include "etl/impl/CloseTimeIndexLoader.hpp"
+#include "util/MockBackendTestFixture.hpp"
+#include "util/TestObject.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/protocol/LedgerHeader.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <thread>
+
+using namespace testing;
+
+namespace {
+
+constexpr auto LEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto MIN_SEQ = 1u;
+constexpr auto MAX_SEQ = 10u;
+
+}  // namespace
+
+struct CloseTimeIndexLoaderTests : MockBackendTest {
+    std::optional<data::LedgerRange>
+    waitForIndex()
+    {
+        for (auto i = 0; i < 100 and not backend->closeTimeIndex().range().has_value(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+        return backend->closeTimeIndex().range();
+    }
+};
+
+TEST_F(CloseTimeIndexLoaderTests, BackfillsCloseTimesFromDatabase)
+{
+    EXPECT_CALL(*backend, hardFetchLedgerBySequence).Times(MAX_SEQ).WillRepeatedly([](std::uint32_t seq, auto) {
+        return CreateLedgerHeaderWithUnixTime(LEDGER_HASH, seq, 1'700'000'000 + seq);
+    });
+
+    etl::impl::CloseTimeIndexLoader loader{backend, std::nullopt, MAX_SEQ};
+    loader.load(data::LedgerRange{.minSequence = MIN_SEQ, .maxSequence = MAX_SEQ});
+
+    auto const range = waitForIndex();
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->minSequence, MIN_SEQ);
+    EXPECT_EQ(range->maxSequence, MAX_SEQ);
+    EXPECT_EQ(
+        backend->closeTimeIndex().closeTime(5),
+        CreateLedgerHeaderWithUnixTime(LEDGER_HASH, 5, 1'700'000'005).closeTime
+    );
+}
+
+TEST_F(CloseTimeIndexLoaderTests, TimeoutsStopBackfillAfterLimitedAttempts)
+{
+    // every attempt of the only chunk times out on its first ledger
+    std::atomic_int calls = 0;
+    std::promise<void> lastAttempt;
+    EXPECT_CALL(*backend, hardFetchLedgerBySequence)
+        .Times(3)
+        .WillRepeatedly([&](std::uint32_t, auto) -> std::optional<ripple::LedgerHeader> {
+            if (++calls == 3)
+                lastAttempt.set_value();
+            throw data::DatabaseTimeout{};
+        });
+
+    {
+        etl::impl::CloseTimeIndexLoader loader{backend, std::nullopt, MAX_SEQ};
+        loader.load(data::LedgerRange{.minSequence = MIN_SEQ, .maxSequence = MAX_SEQ});
+
+        lastAttempt.get_future().wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    }
+
+    EXPECT_FALSE(backend->closeTimeIndex().range().has_value());
+}
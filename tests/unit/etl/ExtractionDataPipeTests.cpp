@@ -67,7 +67,7 @@ TEST_F(ETLExtractionDataPipeTest, CallingCleanupUnblocksOtherThread)
 {
     std::atomic_bool unblocked = false;
     auto bgThread = std::thread([this, &unblocked] {
-        for (std::size_t i = 0; i < 252; ++i)
+        for (std::size_t i = 0; i < 251; ++i)
             pipe_.push(START_SEQ, 1234);  // 251st element will block this thread here
         unblocked = true;
     });
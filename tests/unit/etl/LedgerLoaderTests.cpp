@@ -0,0 +1,174 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "data/DBHelpers.hpp"
+#include "etl/SystemState.hpp"
+#include "etl/impl/LedgerLoader.hpp"
+#include "util/MockBackendTestFixture.hpp"
+#include "util/MockLedgerFetcher.hpp"
+#include "util/TestObject.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <xrpl/basics/base_uint.h>
+#include <xrpl/proto/org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h>
+#include <xrpl/protocol/LedgerHeader.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/Serializer.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+namespace {
+
+constexpr auto ACCOUNT = "rM2AGCCCRb373FRuD8wHyUwUsh2dV4BW5Q";
+constexpr auto OFFER = "0008013AE1CD8B79A8BCB52335CD40DE97401B2D60A828720000099B00000000";
+constexpr auto LEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr auto SEQ = 30;
+constexpr auto NUM_THREADS = 4u;
+
+struct FakeLoadBalancer {
+    using GetLedgerResponseType = org::xrpl::rpc::v1::GetLedgerResponse;
+    using OptionalGetLedgerResponseType = std::optional<GetLedgerResponseType>;
+    using RawLedgerObjectType = org::xrpl::rpc::v1::RawLedgerObject;
+};
+
+using LedgerLoaderType = etl::impl::LedgerLoader<FakeLoadBalancer, MockLedgerFetcher>;
+
+// enough transactions for every thread to parse a range of its own
+constexpr auto NUM_TXNS = LedgerLoaderType::MIN_TRANSACTIONS_PER_TASK * NUM_THREADS;
+
+}  // namespace
+
+struct LedgerLoaderTests : MockBackendTest {
+    MockLedgerFetcher fetcher_;
+    etl::SystemState state_;
+    ripple::LedgerHeader const ledger_ = CreateLedgerHeader(LEDGER_HASH, SEQ);
+
+    static FakeLoadBalancer::GetLedgerResponseType
+    makeLedgerData(std::optional<std::size_t> brokenTxn = std::nullopt)
+    {
+        FakeLoadBalancer::GetLedgerResponseType data;
+        for (std::size_t i = 0; i < NUM_TXNS; ++i) {
+            auto const tx = CreateCancelNFTOffersTxWithMetadata(ACCOUNT, static_cast<std::uint32_t>(i + 1), 2, {OFFER});
+            auto* txn = data.mutable_transactions_list()->add_transactions();
+            txn->set_transaction_blob(
+                i == brokenTxn ? std::string{"garbage"} : std::string{tx.transaction.begin(), tx.transaction.end()}
+            );
+            txn->set_metadata_blob(std::string{tx.metadata.begin(), tx.metadata.end()});
+        }
+        return data;
+    }
+
+    static std::vector<ripple::uint256>
+    txHashes(FakeLoadBalancer::GetLedgerResponseType const& data)
+    {
+        std::vector<ripple::uint256> hashes;
+        for (auto const& txn : data.transactions_list().transactions()) {
+            ripple::SerialIter it{txn.transaction_blob().data(), txn.transaction_blob().size()};
+            hashes.push_back(ripple::STTx{it}.getTransactionID());
+        }
+        return hashes;
+    }
+
+    LedgerLoaderType
+    makeLoader(std::uint32_t numThreads)
+    {
+        return LedgerLoaderType{backend, std::make_shared<FakeLoadBalancer>(), fetcher_, state_, numThreads};
+    }
+};
+
+TEST_F(LedgerLoaderTests, InsertTransactionsKeepsLedgerOrder)
+{
+    auto data = makeLedgerData();
+    auto const expectedHashes = txHashes(data);
+
+    std::vector<ripple::uint256> writtenHashes;
+    EXPECT_CALL(*backend, writeTransaction(_, SEQ, _, _, _))
+        .Times(NUM_TXNS)
+        .WillRepeatedly([&writtenHashes](auto&& key, auto, auto, auto&&, auto&&) {
+            writtenHashes.push_back(ripple::uint256::fromVoid(key.data()));
+        });
+
+    auto loader = makeLoader(NUM_THREADS);
+    auto const result = loader.insertTransactions(ledger_, data);
+
+    EXPECT_EQ(writtenHashes, expectedHashes);
+
+    ASSERT_EQ(result.accountTxData.size(), NUM_TXNS);
+    ASSERT_EQ(result.nfTokenTxData.size(), NUM_TXNS);
+    for (std::size_t i = 0; i < NUM_TXNS; ++i) {
+        EXPECT_EQ(result.accountTxData[i].txHash, expectedHashes[i]);
+        EXPECT_EQ(result.nfTokenTxData[i].txHash, expectedHashes[i]);
+    }
+}
+
+TEST_F(LedgerLoaderTests, InsertTransactionsOnSingleThreadMatchesParallelResult)
+{
+    auto parallelData = makeLedgerData();
+    auto sequentialData = makeLedgerData();
+
+    auto parallelLoader = makeLoader(NUM_THREADS);
+    auto sequentialLoader = makeLoader(1);
+    auto const parallel = parallelLoader.insertTransactions(ledger_, parallelData);
+    auto const sequential = sequentialLoader.insertTransactions(ledger_, sequentialData);
+
+    ASSERT_EQ(parallel.accountTxData.size(), sequential.accountTxData.size());
+    for (std::size_t i = 0; i < parallel.accountTxData.size(); ++i)
+        EXPECT_EQ(parallel.accountTxData[i].txHash, sequential.accountTxData[i].txHash);
+
+    ASSERT_EQ(parallel.nfTokenTxData.size(), sequential.nfTokenTxData.size());
+    for (std::size_t i = 0; i < parallel.nfTokenTxData.size(); ++i)
+        EXPECT_EQ(parallel.nfTokenTxData[i].txHash, sequential.nfTokenTxData[i].txHash);
+
+    EXPECT_EQ(parallel.nfTokensData.size(), sequential.nfTokensData.size());
+}
+
+TEST_F(LedgerLoaderTests, InsertTransactionsRethrowsErrorOfFailingRange)
+{
+    // the broken transaction is in the middle of the third range
+    auto const brokenTxn = LedgerLoaderType::MIN_TRANSACTIONS_PER_TASK * 2 + 5;
+
+    auto const errorOf = [](LedgerLoaderType& loader, ripple::LedgerHeader const& ledger, auto& data) {
+        try {
+            loader.insertTransactions(ledger, data);
+        } catch (std::exception const& e) {
+            return std::optional<std::string>{e.what()};
+        }
+        return std::optional<std::string>{};
+    };
+
+    EXPECT_CALL(*backend, writeTransaction).Times(0);
+
+    auto sequentialData = makeLedgerData(brokenTxn);
+    auto sequentialLoader = makeLoader(1);
+    auto const expectedError = errorOf(sequentialLoader, ledger_, sequentialData);
+    ASSERT_TRUE(expectedError.has_value());
+
+    auto parallelData = makeLedgerData(brokenTxn);
+    auto parallelLoader = makeLoader(NUM_THREADS);
+    EXPECT_EQ(errorOf(parallelLoader, ledger_, parallelData), expectedError);
+}
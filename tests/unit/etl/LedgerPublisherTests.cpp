@@ -97,6 +97,7 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderIsWritingFalseAndCacheEnabled)
     impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
     publisher.publish(dummyLedgerHeader);
     EXPECT_CALL(mockCache, isDisabled).WillOnce(Return(false));
+    EXPECT_CALL(mockCache, waitUntilCacheContainsSeq(SEQ - 1));
     EXPECT_CALL(*backend, fetchLedgerDiff(SEQ, _)).Times(1);
 
     // setLastPublishedSequence not in strand, should verify before run
@@ -127,6 +128,33 @@ TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderIsWritingTrue)
     EXPECT_FALSE(backend->fetchLedgerRange());
 }
 
+TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderAddsCloseTimeToIndex)
+{
+    SystemState dummyState;
+    dummyState.isWriting = true;
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, AGE);
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
+    publisher.publish(dummyLedgerHeader);
+
+    ctx.run();
+    EXPECT_EQ(backend->closeTimeIndex().closeTime(SEQ), dummyLedgerHeader.closeTime);
+    EXPECT_EQ(backend->closeTimeIndex().lastLedgerClosedBy(dummyLedgerHeader.closeTime), SEQ);
+}
+
+TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderCachesHeader)
+{
+    SystemState dummyState;
+    dummyState.isWriting = true;
+    auto const dummyLedgerHeader = CreateLedgerHeader(LEDGERHASH, SEQ, AGE);
+    impl::LedgerPublisher publisher(ctx, backend, mockCache, mockSubscriptionManagerPtr, dummyState);
+    publisher.publish(dummyLedgerHeader);
+
+    ctx.run();
+    auto const cached = backend->ledgerHeaderCache().get(SEQ);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->hash, dummyLedgerHeader.hash);
+}
+
 TEST_F(ETLLedgerPublisherTest, PublishLedgerHeaderInRange)
 {
     SystemState dummyState;
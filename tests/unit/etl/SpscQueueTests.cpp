@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "etl/impl/SpscQueue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+
+using namespace etl::impl;
+
+TEST(SpscQueueTest, PopsInPushOrder)
+{
+    SpscQueue<int> queue{4};
+    for (auto i = 0; i < 4; ++i)
+        queue.push(int{i});
+
+    EXPECT_EQ(queue.size(), 4u);
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_EQ(queue.pop(), i);
+
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(SpscQueueTest, MovesOnlyTypesThrough)
+{
+    SpscQueue<std::unique_ptr<int>> queue{1};
+    queue.push(std::make_unique<int>(42));
+
+    auto const value = queue.tryPop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(**value, 42);
+}
+
+TEST(SpscQueueTest, PushToFullQueueBlocksUntilPop)
+{
+    SpscQueue<int> queue{2};
+    queue.push(1);
+    queue.push(2);
+
+    std::atomic_bool pushed = false;
+    auto producer = std::thread([&queue, &pushed] {
+        queue.push(3);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+    EXPECT_FALSE(pushed);
+
+    EXPECT_EQ(queue.pop(), 1);
+    producer.join();
+    EXPECT_TRUE(pushed);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+}
+
+TEST(SpscQueueTest, ElementsCrossThreadsInOrder)
+{
+    static constexpr std::size_t TOTAL = 100'000;
+    SpscQueue<std::size_t> queue{16};
+
+    auto producer = std::thread([&queue] {
+        for (std::size_t i = 0; i < TOTAL; ++i)
+            queue.push(std::size_t{i});
+    });
+
+    for (std::size_t i = 0; i < TOTAL; ++i)
+        ASSERT_EQ(queue.pop(), i);
+
+    producer.join();
+}
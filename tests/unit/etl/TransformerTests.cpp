@@ -19,6 +19,7 @@
 
 #include "etl/SystemState.hpp"
 #include "etl/impl/Transformer.hpp"
+#include "rpc/RPCHelpers.hpp"
 #include "util/FakeFetchResponse.hpp"
 #include "util/MockAmendmentBlockHandler.hpp"
 #include "util/MockBackendTestFixture.hpp"
@@ -27,14 +28,19 @@
 #include "util/MockLedgerPublisher.hpp"
 #include "util/MockPrometheus.hpp"
 #include "util/StringUtils.hpp"
+#include "util/TestObject.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <xrpl/protocol/LedgerHeader.h>
 
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <thread>
+#include <vector>
 
 using namespace testing;
 using namespace etl;
@@ -47,6 +53,10 @@ constexpr static auto RAW_HEADER =
     "3E2232B33EF57CECAC2816E3122816E31A0A00F8377CD95DFA484CFAE282656A58"
     "CE5AA29652EFFD80AC59CD91416E4E13DBBE";
 
+constexpr static auto LEDGER_HASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr static auto START_SEQ = 1u;
+constexpr static auto NUM_LEDGERS = 5u;
+
 struct ETLTransformerTest : util::prometheus::WithPrometheus, MockBackendTest {
     using DataType = FakeFetchResponse;
     using ExtractionDataPipeType = MockExtractionDataPipe;
@@ -78,6 +88,27 @@ struct ETLTransformerTest : util::prometheus::WithPrometheus, MockBackendTest {
     {
         transformer_.reset();
     }
+
+    // ledgers [START_SEQ, lastSeq] with distinct headers, then the end of the pipe
+    void
+    feedLedgers(std::uint32_t lastSeq)
+    {
+        ON_CALL(dataPipe_, popNext).WillByDefault([lastSeq](std::uint32_t seq) -> std::optional<FakeFetchResponse> {
+            if (seq > lastSeq)
+                return std::nullopt;
+
+            auto const blob = rpc::ledgerHeaderToBlob(CreateLedgerHeader(LEDGER_HASH, seq), true);
+            return FakeFetchResponse{std::string{blob.begin(), blob.end()}, seq, true};
+        });
+    }
+
+    void
+    startTransformer()
+    {
+        transformer_ = std::make_unique<TransformerType>(
+            dataPipe_, backend, ledgerLoader_, ledgerPublisher_, amendmentBlockHandler_, START_SEQ, state_
+        );
+    }
 };
 
 TEST_F(ETLTransformerTest, StopsOnWriteConflict)
@@ -158,3 +189,70 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
 }
 
 // TODO: implement tests for amendment block. requires more refactoring
+
+TEST_F(ETLTransformerTest, CommitsAndPublishesLedgersInOrder)
+{
+    feedLedgers(START_SEQ + NUM_LEDGERS - 1);
+
+    // both are only called by the commit thread
+    std::vector<std::string> events;
+    ON_CALL(*backend, doFinishWrites).WillByDefault([&events](std::uint32_t seq) {
+        events.push_back("finish " + std::to_string(seq));
+        return true;
+    });
+    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(NUM_LEDGERS).WillRepeatedly([&events](auto const& lgrInfo) {
+        events.push_back("publish " + std::to_string(lgrInfo.seq));
+    });
+
+    startTransformer();
+    transformer_->waitTillFinished();
+
+    std::vector<std::string> expected;
+    for (auto seq = START_SEQ; seq < START_SEQ + NUM_LEDGERS; ++seq) {
+        expected.push_back("finish " + std::to_string(seq));
+        expected.push_back("publish " + std::to_string(seq));
+    }
+    EXPECT_EQ(events, expected);
+    EXPECT_FALSE(state_.writeConflict);
+}
+
+TEST_F(ETLTransformerTest, FailedCommitStopsLaterLedgers)
+{
+    static constexpr auto FAILING_SEQ = START_SEQ + 2;
+    feedLedgers(START_SEQ + NUM_LEDGERS - 1);
+
+    std::vector<std::uint32_t> published;
+    ON_CALL(*backend, doFinishWrites).WillByDefault([](std::uint32_t seq) { return seq != FAILING_SEQ; });
+    EXPECT_CALL(*backend, doFinishWrites(Le(FAILING_SEQ))).Times(FAILING_SEQ - START_SEQ + 1);
+    EXPECT_CALL(*backend, doFinishWrites(Gt(FAILING_SEQ))).Times(0);
+    EXPECT_CALL(ledgerPublisher_, publish(_)).WillRepeatedly([&published](auto const& lgrInfo) {
+        published.push_back(lgrInfo.seq);
+    });
+
+    startTransformer();
+    transformer_->waitTillFinished();
+
+    EXPECT_EQ(published, (std::vector<std::uint32_t>{START_SEQ, START_SEQ + 1}));
+    EXPECT_TRUE(state_.writeConflict);
+}
+
+TEST_F(ETLTransformerTest, WaitTillFinishedJoinsBuildAndCommitThreads)
+{
+    feedLedgers(START_SEQ + NUM_LEDGERS - 1);
+
+    // commits are slower than builds, so the build thread finishes first
+    std::uint32_t committed = 0;
+    ON_CALL(*backend, doFinishWrites).WillByDefault([&committed](std::uint32_t seq) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{5});
+        committed = seq;
+        return true;
+    });
+    EXPECT_CALL(dataPipe_, popNext).Times(NUM_LEDGERS + 1);
+    EXPECT_CALL(ledgerPublisher_, publish(_)).Times(NUM_LEDGERS);
+
+    startTransformer();
+    transformer_->waitTillFinished();
+
+    EXPECT_EQ(committed, START_SEQ + NUM_LEDGERS - 1);
+    EXPECT_EQ(backend->fetchLedgerRange()->maxSequence, START_SEQ + NUM_LEDGERS - 1);
+}
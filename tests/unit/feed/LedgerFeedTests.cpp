@@ -20,6 +20,7 @@
 #include "feed/FeedTestUtil.hpp"
 #include "feed/impl/LedgerFeed.hpp"
 #include "util/TestObject.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/spawn.hpp>
@@ -81,7 +82,14 @@ TEST_F(FeedLedgerTest, SubPub)
         })";
 
     // test publish
-    EXPECT_CALL(*mockSessionPtr, send(SharedStringJsonEq(ledgerPub))).Times(1);
+    EXPECT_CALL(
+        *mockSessionPtr,
+        send(AllOf(
+            SharedStringJsonEq(ledgerPub),
+            Pointee(Property(&web::SubscriptionMessage::kind, web::SubscriptionMessage::Kind::Ledger))
+        ))
+    )
+        .Times(1);
     auto const ledgerHeader2 = CreateLedgerHeader(LEDGERHASH, 31);
     auto fee2 = ripple::Fees();
     fee2.reserve = 10;
@@ -23,6 +23,7 @@
 #include "util/LoggerFixtures.hpp"
 #include "util/MockPrometheus.hpp"
 #include "util/prometheus/Counter.hpp"
+#include "util/prometheus/Histogram.hpp"
 
 #include <boost/json/value_to.hpp>
 #include <gmock/gmock.h>
@@ -35,6 +36,7 @@
 using namespace rpc;
 
 using util::prometheus::CounterInt;
+using util::prometheus::HistogramInt;
 using util::prometheus::WithMockPrometheus;
 using util::prometheus::WithPrometheus;
 
@@ -56,6 +58,11 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
         counters.onBadSyntax();
         counters.onUnknownCommand();
         counters.onInternalError();
+        counters.onSingleFlightHit();
+        counters.onSingleFlightMiss();
+        counters.onSingleFlightCoalesced();
+        counters.onResponseCacheHit();
+        counters.onResponseCacheMiss();
     }
 
     auto const report = counters.report();
@@ -104,6 +111,11 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
     EXPECT_EQ(boost::json::value_to<std::string>(report.at("bad_syntax_errors")), "512");
     EXPECT_EQ(boost::json::value_to<std::string>(report.at("unknown_command_errors")), "512");
     EXPECT_EQ(boost::json::value_to<std::string>(report.at("internal_errors")), "512");
+    EXPECT_EQ(boost::json::value_to<std::string>(report.at("single_flight_hits")), "512");
+    EXPECT_EQ(boost::json::value_to<std::string>(report.at("single_flight_misses")), "512");
+    EXPECT_EQ(boost::json::value_to<std::string>(report.at("single_flight_coalesced")), "512");
+    EXPECT_EQ(boost::json::value_to<std::string>(report.at("response_cache_hits")), "512");
+    EXPECT_EQ(boost::json::value_to<std::string>(report.at("response_cache_misses")), "512");
 
     EXPECT_EQ(report.at("work_queue"), queue.report());  // Counters report includes queue report
 }
@@ -136,12 +148,33 @@ TEST_F(RPCCountersMockPrometheusTests, rpcComplete)
     auto& startedMock = makeMock<CounterInt>("rpc_method_total_number", "{method=\"test\",status=\"started\"}");
     auto& finishedMock = makeMock<CounterInt>("rpc_method_total_number", "{method=\"test\",status=\"finished\"}");
     auto& durationMock = makeMock<CounterInt>("rpc_method_duration_us", "{method=\"test\"}");
+    auto& executionMock = makeMock<HistogramInt>(
+        "rpc_method_duration_microseconds_histogram", "{method=\"test\",stage=\"execution\"}"
+    );
     EXPECT_CALL(startedMock, add(1));
     EXPECT_CALL(finishedMock, add(1));
     EXPECT_CALL(durationMock, add(123));
+    EXPECT_CALL(executionMock, observe(123));
     counters.rpcComplete("test", std::chrono::microseconds(123));
 }
 
+TEST_F(RPCCountersMockPrometheusTests, rpcQueued)
+{
+    auto& queueMock =
+        makeMock<HistogramInt>("rpc_method_duration_microseconds_histogram", "{method=\"test\",stage=\"queue\"}");
+    EXPECT_CALL(queueMock, observe(42));
+    counters.rpcQueued("test", std::chrono::microseconds(42));
+}
+
+TEST_F(RPCCountersMockPrometheusTests, rpcSerialized)
+{
+    auto& serializationMock = makeMock<HistogramInt>(
+        "rpc_method_duration_microseconds_histogram", "{method=\"test\",stage=\"serialization\"}"
+    );
+    EXPECT_CALL(serializationMock, observe(7));
+    counters.rpcSerialized("test", std::chrono::microseconds(7));
+}
+
 TEST_F(RPCCountersMockPrometheusTests, rpcForwarded)
 {
     auto& forwardedMock = makeMock<CounterInt>("rpc_method_total_number", "{method=\"test\",status=\"forwarded\"}");
@@ -191,3 +224,38 @@ TEST_F(RPCCountersMockPrometheusTests, onInternalError)
     EXPECT_CALL(internalErrorMock, add(1));
     counters.onInternalError();
 }
+
+TEST_F(RPCCountersMockPrometheusTests, onSingleFlightHit)
+{
+    auto& hitMock = makeMock<CounterInt>("rpc_single_flight_total_number", "{result=\"hit\"}");
+    EXPECT_CALL(hitMock, add(1));
+    counters.onSingleFlightHit();
+}
+
+TEST_F(RPCCountersMockPrometheusTests, onSingleFlightMiss)
+{
+    auto& missMock = makeMock<CounterInt>("rpc_single_flight_total_number", "{result=\"miss\"}");
+    EXPECT_CALL(missMock, add(1));
+    counters.onSingleFlightMiss();
+}
+
+TEST_F(RPCCountersMockPrometheusTests, onSingleFlightCoalesced)
+{
+    auto& coalescedMock = makeMock<CounterInt>("rpc_single_flight_total_number", "{result=\"coalesced\"}");
+    EXPECT_CALL(coalescedMock, add(1));
+    counters.onSingleFlightCoalesced();
+}
+
+TEST_F(RPCCountersMockPrometheusTests, onResponseCacheHit)
+{
+    auto& hitMock = makeMock<CounterInt>("rpc_response_cache_total_number", "{result=\"hit\"}");
+    EXPECT_CALL(hitMock, add(1));
+    counters.onResponseCacheHit();
+}
+
+TEST_F(RPCCountersMockPrometheusTests, onResponseCacheMiss)
+{
+    auto& missMock = makeMock<CounterInt>("rpc_response_cache_total_number", "{result=\"miss\"}");
+    EXPECT_CALL(missMock, add(1));
+    counters.onResponseCacheMiss();
+}
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "rpc/Errors.hpp"
+#include "rpc/LedgerResponseCache.hpp"
+#include "rpc/common/Types.hpp"
+
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <string>
+
+using namespace rpc;
+
+namespace {
+
+std::shared_ptr<ReturnType const>
+makeResponse(std::string const& value)
+{
+    return std::make_shared<ReturnType const>(ReturnType{boost::json::object{{"value", value}}});
+}
+
+std::size_t
+sizeOf(std::string const& key, std::string const& value)
+{
+    return key.size() + LedgerResponseCache::estimateSize(*makeResponse(value), 1024 * 1024);
+}
+
+}  // namespace
+
+struct LedgerResponseCacheTests : public ::testing::Test {
+protected:
+    LedgerResponseCache cache_{1024, 1};
+};
+
+TEST_F(LedgerResponseCacheTests, PutAndGet)
+{
+    EXPECT_EQ(cache_.get("key", 10), nullptr);
+
+    auto const response = makeResponse("value");
+    cache_.put("key", response, false, 10);
+    auto const result = cache_.get("key", 10);
+    ASSERT_NE(result, nullptr);
+    EXPECT_EQ(result, response);
+    EXPECT_EQ(*result->result, boost::json::object{{"value", "value"}});
+    EXPECT_EQ(cache_.size(), sizeOf("key", "value"));
+}
+
+TEST_F(LedgerResponseCacheTests, ErrorsAreNotCached)
+{
+    cache_.put(
+        "key",
+        std::make_shared<ReturnType const>(ReturnType{std::unexpected{Status{RippledError::rpcINTERNAL}}}),
+        false,
+        10
+    );
+    EXPECT_EQ(cache_.get("key", 10), nullptr);
+    EXPECT_EQ(cache_.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTests, LatestEntriesAreDroppedOnNewLedger)
+{
+    cache_.put("fixed", makeResponse("value"), false, 10);
+    cache_.put("latest", makeResponse("value"), true, 10);
+    EXPECT_NE(cache_.get("latest", 10), nullptr);
+
+    EXPECT_EQ(cache_.get("latest", 11), nullptr);
+    EXPECT_NE(cache_.get("fixed", 11), nullptr);
+    EXPECT_EQ(cache_.size(), sizeOf("fixed", "value"));
+}
+
+TEST_F(LedgerResponseCacheTests, OutdatedLatestEntriesAreNotCached)
+{
+    EXPECT_EQ(cache_.get("other", 11), nullptr);
+
+    cache_.put("latest", makeResponse("value"), true, 10);
+    EXPECT_EQ(cache_.get("latest", 11), nullptr);
+}
+
+TEST_F(LedgerResponseCacheTests, NewLedgerSeenByOneShardDropsLatestEntriesOfAllShards)
+{
+    LedgerResponseCache cache{1024 * 1024, 4};
+    for (auto const& key : {"a", "b", "c", "d", "e", "f", "g", "h"})
+        cache.put(key, makeResponse("value"), true, 10);
+
+    EXPECT_EQ(cache.get("a", 11), nullptr);
+    for (auto const& key : {"b", "c", "d", "e", "f", "g", "h"})
+        EXPECT_EQ(cache.get(key, 10), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTests, LeastRecentlyUsedEntryIsEvicted)
+{
+    auto const value = std::string(300, 'v');
+    LedgerResponseCache cache{2 * sizeOf("key1", value) + 1, 1};
+
+    cache.put("key1", makeResponse(value), false, 10);
+    cache.put("key2", makeResponse(value), false, 10);
+    EXPECT_NE(cache.get("key1", 10), nullptr);
+
+    cache.put("key3", makeResponse(value), false, 10);
+    EXPECT_NE(cache.get("key1", 10), nullptr);
+    EXPECT_EQ(cache.get("key2", 10), nullptr);
+    EXPECT_NE(cache.get("key3", 10), nullptr);
+    EXPECT_EQ(cache.size(), 2 * sizeOf("key1", value));
+}
+
+TEST_F(LedgerResponseCacheTests, EntryLargerThanCacheIsNotCached)
+{
+    cache_.put("key", makeResponse(std::string(2048, 'v')), false, 10);
+    EXPECT_EQ(cache_.get("key", 10), nullptr);
+    EXPECT_EQ(cache_.size(), 0u);
+}
+
+TEST_F(LedgerResponseCacheTests, EstimatedSizeIsCloseToSerializedSize)
+{
+    auto const response = ReturnType{boost::json::object{
+        {"ledger_index", 12345678},
+        {"validated", true},
+        {"transactions", boost::json::array{"A1B2C3D4", "E5F6A7B8", boost::json::object{{"hash", "C9D0E1F2"}}}}
+    }};
+    auto const serialized = boost::json::serialize(*response.result).size();
+    auto const estimated = LedgerResponseCache::estimateSize(response, 1024);
+
+    EXPECT_GE(estimated, serialized / 2);
+    EXPECT_LE(estimated, serialized * 2);
+}
+
+TEST_F(LedgerResponseCacheTests, SizeEstimationStopsAboveLimit)
+{
+    boost::json::array large;
+    for (auto i = 0; i < 10000; ++i)
+        large.emplace_back(std::string(100, 'v'));
+
+    auto const estimated = LedgerResponseCache::estimateSize(ReturnType{boost::json::object{{"large", large}}}, 1024);
+    EXPECT_GT(estimated, 1024u);
+    EXPECT_LT(estimated, 2048u);
+}
@@ -39,8 +39,14 @@
 #include "web/dosguard/DOSGuard.hpp"
 #include "web/dosguard/WhitelistHandler.hpp"
 
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/spawn.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/system/system_error.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -306,6 +312,51 @@ TEST_F(RPCEngineTest, ThrowException)
     });
 }
 
+TEST_F(RPCEngineTest, ThrowAfterDeadlineIsTooBusy)
+{
+    auto const method = "subscribe";
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfg, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+    EXPECT_CALL(*backend, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler(method)).WillOnce(Return(AnyHandler{tests::common::FailingHandlerFake{}}));
+    EXPECT_CALL(*mockCountersPtr, rpcErrored(method))
+        .WillOnce(Throw(boost::system::system_error{boost::asio::error::operation_aborted}));
+    EXPECT_CALL(*handlerProvider, contains(method)).WillOnce(Return(true));
+    EXPECT_CALL(*mockCountersPtr, onTooBusy());
+
+    boost::asio::cancellation_signal deadline;
+    auto done = false;
+    boost::asio::spawn(
+        ctx,
+        [&](boost::asio::yield_context yield) {
+            deadline.emit(boost::asio::cancellation_type::terminal);
+            auto const ctx = web::Context(
+                yield,
+                method,
+                1,
+                boost::json::parse("{}").as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{0, 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const status = std::get_if<rpc::Status>(&res.response);
+            ASSERT_TRUE(status != nullptr);
+            EXPECT_TRUE(*status == Status{RippledError::rpcTOO_BUSY});
+            done = true;
+        },
+        boost::asio::bind_cancellation_slot(deadline.slot(), [](std::exception_ptr) {})
+    );
+    runContext();
+
+    EXPECT_TRUE(done);
+}
+
 struct RPCEngineCacheTestCaseBundle {
     std::string testName;
     std::string config;
@@ -474,3 +525,177 @@ TEST_F(RPCEngineTest, NotCacheIfErrorHappen)
         });
     }
 }
+
+TEST_F(RPCEngineTest, SingleFlightOnlyCoversEligibleMethods)
+{
+    auto const cfgSingleFlight = Config{json::parse(R"JSON({
+                                                      "server": {"max_queue_size": 2},
+                                                      "workers": 4,
+                                                      "rpc": {"single_flight": true}
+                                                })JSON")};
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgSingleFlight, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    EXPECT_CALL(*backend, isTooBusy).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler).Times(2).WillRepeatedly(Return(AnyHandler{tests::common::HandlerFake{}}));
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockCountersPtr, onSingleFlightMiss);
+    EXPECT_CALL(*mockCountersPtr, onSingleFlightHit).Times(0);
+    EXPECT_CALL(*mockCountersPtr, onSingleFlightCoalesced).Times(0);
+
+    for (auto const* method : {"ledger", "server_info"}) {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                method,
+                1,
+                boost::json::parse(R"JSON({"hello": "world", "limit": 50})JSON").as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{0, 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<boost::json::object>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*response, boost::json::parse(R"JSON({"computed": "world_50"})JSON").as_object());
+        });
+    }
+}
+
+TEST_F(RPCEngineTest, LedgerResponseCacheServesRepeatedRequests)
+{
+    auto const cfgCache = Config{json::parse(R"JSON({
+                                                      "server": {"max_queue_size": 2},
+                                                      "workers": 4,
+                                                      "rpc": {"ledger_response_cache_size_mb": 1}
+                                                })JSON")};
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgCache, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    EXPECT_CALL(*backend, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler).WillOnce(Return(AnyHandler{tests::common::HandlerFake{}}));
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(3).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheMiss);
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheHit).Times(2);
+
+    // the order of the params and the request id do not matter
+    for (auto const* params : {
+             R"JSON({"hello": "world", "limit": 50, "ledger_index": 30})JSON",
+             R"JSON({"limit": 50, "ledger_index": 30, "hello": "world"})JSON",
+             R"JSON({"id": 1, "hello": "world", "limit": 50, "ledger_index": 30})JSON"
+         }) {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                "ledger",
+                1,
+                boost::json::parse(params).as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{0, 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<std::shared_ptr<ReturnType const>>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*(*response)->result, boost::json::parse(R"JSON({"computed": "world_50"})JSON"));
+        });
+    }
+}
+
+TEST_F(RPCEngineTest, LedgerResponseCacheStoresLatestResponseOfKeyLedger)
+{
+    auto const cfgCache = Config{json::parse(R"JSON({
+                                                      "server": {"max_queue_size": 2},
+                                                      "workers": 4,
+                                                      "rpc": {"ledger_response_cache_size_mb": 1}
+                                                })JSON")};
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgCache, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    EXPECT_CALL(*backend, isTooBusy).WillOnce(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler)
+        .WillOnce(Return(AnyHandler{tests::common::LedgerIndexHandlerFake{30}}));
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheMiss);
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheHit);
+
+    for (auto i = 0; i < 2; ++i) {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                "ledger",
+                1,
+                boost::json::parse(R"JSON({"ledger_index": "validated"})JSON").as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{0, 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<std::shared_ptr<ReturnType const>>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*(*response)->result, boost::json::parse(R"JSON({"ledger_index": 30})JSON"));
+        });
+    }
+}
+
+TEST_F(RPCEngineTest, LedgerResponseCacheSkipsLatestResponseOfNewerLedger)
+{
+    auto const cfgCache = Config{json::parse(R"JSON({
+                                                      "server": {"max_queue_size": 2},
+                                                      "workers": 4,
+                                                      "rpc": {"ledger_response_cache_size_mb": 1}
+                                                })JSON")};
+
+    std::shared_ptr<RPCEngine<MockLoadBalancer, MockCounters>> engine =
+        RPCEngine<MockLoadBalancer, MockCounters>::make_RPCEngine(
+            cfgCache, backend, mockLoadBalancerPtr, dosGuard, queue, *mockCountersPtr, handlerProvider
+        );
+
+    // the handler reads ledger 31 that was published after the requests were keyed by ledger 30
+    EXPECT_CALL(*backend, isTooBusy).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*handlerProvider, getHandler)
+        .Times(2)
+        .WillRepeatedly(Return(AnyHandler{tests::common::LedgerIndexHandlerFake{31}}));
+    EXPECT_CALL(*handlerProvider, isClioOnly).Times(2).WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheMiss).Times(2);
+    EXPECT_CALL(*mockCountersPtr, onResponseCacheHit).Times(0);
+
+    for (auto i = 0; i < 2; ++i) {
+        runSpawn([&](auto yield) {
+            auto const ctx = web::Context(
+                yield,
+                "ledger",
+                1,
+                boost::json::parse(R"JSON({"ledger_index": "validated"})JSON").as_object(),
+                nullptr,
+                tagFactory,
+                LedgerRange{0, 30},
+                "127.0.0.2",
+                false
+            );
+
+            auto const res = engine->buildResponse(ctx);
+            auto const response = std::get_if<boost::json::object>(&res.response);
+            ASSERT_NE(response, nullptr);
+            EXPECT_EQ(*response, boost::json::parse(R"JSON({"ledger_index": 31})JSON").as_object());
+        });
+    }
+}
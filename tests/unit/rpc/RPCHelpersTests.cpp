@@ -31,20 +31,26 @@
 #include <boost/asio/impl/spawn.hpp>
 #include <boost/asio/spawn.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
 #include <fmt/core.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <xrpl/basics/base_uint.h>
+#include <xrpl/json/json_value.h>
 #include <xrpl/protocol/ErrorCodes.h>
 #include <xrpl/protocol/Indexes.h>
 #include <xrpl/protocol/SField.h>
+#include <xrpl/protocol/STLedgerEntry.h>
 #include <xrpl/protocol/STObject.h>
+#include <xrpl/protocol/STTx.h>
+#include <xrpl/protocol/TxMeta.h>
 #include <xrpl/protocol/UintTypes.h>
 #include <xrpl/protocol/jss.h>
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <tuple>
@@ -506,6 +512,46 @@ TEST_F(RPCHelpersTest, TransactionAndMetadataBinaryJsonV2)
     EXPECT_TRUE(json.contains(JS(meta_blob)));
 }
 
+TEST_F(RPCHelpersTest, ToBoostJsonMatchesParsingStyledString)
+{
+    Json::Value value{Json::objectValue};
+    value["null"] = Json::Value{};
+    value["int"] = -42;
+    value["uint"] = std::numeric_limits<Json::UInt>::max();
+    value["real"] = 1.5;
+    value["integral_real"] = 2.0;
+    value["string"] = "quote \" backslash \\ newline \n";
+    value["bool"] = true;
+    value["array"].append(1);
+    value["array"].append("two");
+    value["array"].append(Json::Value{Json::objectValue});
+    value["object"]["nested"]["deeper"] = Json::Value{Json::arrayValue};
+
+    auto const expected = boost::json::parse(value.toStyledString());
+    auto const converted = toBoostJson(value);
+
+    EXPECT_EQ(converted, expected);
+    EXPECT_EQ(boost::json::serialize(converted), boost::json::serialize(expected));
+}
+
+TEST_F(RPCHelpersTest, STObjectJsonMatchesParsingStyledString)
+{
+    auto const tx = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 10, 32);
+    auto const meta = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30);
+    auto const account = CreateAccountRootObject(ACCOUNT, 0, 1, 200, 2, INDEX1, 3);
+
+    auto const expectSame = [](auto const& json, auto const& object) {
+        auto const expected = boost::json::parse(object.getJson(ripple::JsonOptions::none).toStyledString());
+        EXPECT_EQ(boost::json::serialize(json), boost::json::serialize(expected));
+    };
+
+    expectSame(toJson(tx), tx);
+    expectSame(toJson(ripple::SLE{account, ripple::uint256{INDEX2}}), ripple::SLE{account, ripple::uint256{INDEX2}});
+
+    auto const txMeta = ripple::TxMeta{ripple::uint256{TXNID}, 30, meta};
+    expectSame(toJson(txMeta), txMeta);
+}
+
 TEST_F(RPCHelpersTest, ParseIssue)
 {
     auto issue = parseIssue(boost::json::parse(
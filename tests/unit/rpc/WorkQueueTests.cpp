@@ -24,14 +24,23 @@
 #include "util/prometheus/Counter.hpp"
 #include "util/prometheus/Gauge.hpp"
 
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/json/parse.hpp>
+#include <boost/system/detail/error_code.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <mutex>
 #include <semaphore>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace util;
 using namespace rpc;
@@ -113,6 +122,138 @@ TEST_F(WorkQueueTest, NonWhitelistedPreventSchedulingAtQueueLimitExceeded)
     EXPECT_TRUE(unblocked);
 }
 
+struct WorkQueuePriorityTest : WithPrometheus, NoLoggerFixture {
+    std::binary_semaphore started{0};
+    std::binary_semaphore unblock{0};
+
+    // occupies the only worker so that the jobs posted afterwards are queued
+    void
+    blockWorker(WorkQueue& queue)
+    {
+        EXPECT_TRUE(queue.postCoro(
+            [this](auto /* yield */) {
+                started.release();
+                unblock.acquire();
+            },
+            WorkQueue::Priority::Cheap
+        ));
+        started.acquire();
+    }
+};
+
+TEST_F(WorkQueuePriorityTest, LanesShareWorkersByWeight)
+{
+    WorkQueue queue{1};
+    blockWorker(queue);
+
+    std::vector<WorkQueue::Priority> executed;
+    for (auto const priority : {WorkQueue::Priority::Expensive, WorkQueue::Priority::Cheap}) {
+        auto const job = [&executed, priority](auto /* yield */) { executed.push_back(priority); };
+        for (auto i = 0; i < 5; ++i)
+            EXPECT_TRUE(queue.postCoro(job, priority));
+    }
+
+    unblock.release();
+    queue.join();
+
+    ASSERT_EQ(executed.size(), 10u);
+    // default weights are 4 for cheap and 1 for expensive jobs
+    EXPECT_EQ(std::count(executed.begin(), executed.begin() + 5, WorkQueue::Priority::Cheap), 4);
+    EXPECT_EQ(queue.report().at("lanes").at("cheap"), 0);
+}
+
+TEST_F(WorkQueuePriorityTest, MethodConcurrencyIsCapped)
+{
+    WorkQueue::SchedulingSettings settings;
+    settings.methodConcurrency["ledger_data"] = 1;
+    WorkQueue queue{4, 0, settings};
+
+    std::mutex mtx;
+    auto running = 0;
+    auto maxRunning = 0;
+    auto executed = 0;
+
+    for (auto i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.postCoro(
+            [&](auto /* yield */) {
+                {
+                    std::scoped_lock const lock{mtx};
+                    maxRunning = std::max(maxRunning, ++running);
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds{5});
+                std::scoped_lock const lock{mtx};
+                --running;
+                ++executed;
+            },
+            WorkQueue::Priority::Expensive,
+            "ledger_data"
+        ));
+    }
+
+    queue.join();
+
+    EXPECT_EQ(executed, 4);
+    EXPECT_EQ(maxRunning, 1);
+}
+
+TEST_F(WorkQueuePriorityTest, JobsAreShedWhenLaneWaitsTooLong)
+{
+    WorkQueue::SchedulingSettings settings;
+    settings.maxQueueWait[static_cast<std::size_t>(WorkQueue::Priority::Cheap)] = std::chrono::milliseconds{1};
+    WorkQueue queue{1, 0, settings};
+    blockWorker(queue);
+
+    EXPECT_TRUE(queue.postCoro([](auto /* yield */) {}, WorkQueue::Priority::Cheap));
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+    EXPECT_FALSE(queue.postCoro([](auto /* yield */) {}, WorkQueue::Priority::Cheap));
+    EXPECT_TRUE(queue.postCoro([](auto /* yield */) {}, WorkQueue::Priority::Expensive));
+    EXPECT_TRUE(queue.postCoro([](auto /* yield */) {}, WorkQueue::Priority::WhiteListed));
+
+    unblock.release();
+    queue.join();
+}
+
+TEST_F(WorkQueuePriorityTest, JobsPastDeadlineStartCancelled)
+{
+    WorkQueue::SchedulingSettings settings;
+    settings.requestDeadline = std::chrono::milliseconds{1};
+    WorkQueue queue{1, 0, settings};
+    blockWorker(queue);
+
+    auto cancelled = false;
+    EXPECT_TRUE(queue.postCoro(
+        [&cancelled](auto yield) {
+            cancelled = yield.get_cancellation_state().cancelled() != boost::asio::cancellation_type::none;
+        },
+        WorkQueue::Priority::Cheap
+    ));
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+
+    unblock.release();
+    queue.join();
+    EXPECT_TRUE(cancelled);
+}
+
+TEST_F(WorkQueuePriorityTest, RunningJobIsCancelledAtDeadline)
+{
+    WorkQueue::SchedulingSettings settings;
+    settings.requestDeadline = std::chrono::milliseconds{10};
+    WorkQueue queue{1, 0, settings};
+
+    boost::system::error_code error;
+    EXPECT_TRUE(queue.postCoro(
+        [&error](auto yield) {
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::seconds{10}};
+            timer.async_wait(yield[error]);
+        },
+        WorkQueue::Priority::Cheap
+    ));
+
+    queue.join();
+    EXPECT_EQ(error, boost::asio::error::operation_aborted);
+}
+
 struct WorkQueueStopTest : WorkQueueTest {
     testing::StrictMock<testing::MockFunction<void()>> onTasksComplete;
     testing::StrictMock<testing::MockFunction<void()>> taskMock;
@@ -24,14 +24,17 @@
 #include "util/HandlerBaseTestFixture.hpp"
 #include "util/NameGenerator.hpp"
 #include "util/TestObject.hpp"
+#include "util/TimeUtils.hpp"
 
 #include <boost/json/parse.hpp>
 #include <boost/json/value.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -43,7 +46,20 @@ using namespace rpc;
 namespace json = boost::json;
 using namespace testing;
 
-class RPCLedgerIndexTest : public HandlerBaseTestStrict {};
+class RPCLedgerIndexTest : public HandlerBaseTestStrict {
+protected:
+    // ledgers of the range close every 2 seconds starting from 2024-06-25T12:23:10Z
+    void
+    fillCloseTimeIndex(std::uint32_t minSeq, std::uint32_t maxSeq)
+    {
+        for (auto seq = minSeq; seq <= maxSeq; ++seq) {
+            auto const unixTime = static_cast<std::time_t>(1719318190 + (2 * (seq - RANGEMIN)));
+            backend->closeTimeIndex().add(
+                seq, *util::LedgerCloseTimeFromSystemTp(std::chrono::system_clock::from_time_t(unixTime))
+            );
+        }
+    }
+};
 
 TEST_F(RPCLedgerIndexTest, DateStrNotValid)
 {
@@ -91,6 +107,41 @@ TEST_F(RPCLedgerIndexTest, EarlierThanMinLedger)
     });
 }
 
+TEST_F(RPCLedgerIndexTest, EarlierThanMinLedgerFromCloseTimeIndex)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+    fillCloseTimeIndex(RANGEMIN, RANGEMAX);
+    auto const handler = AnyHandler{LedgerIndexHandler{backend}};
+    auto const req = json::parse(R"({"date": "2024-06-25T12:23:05Z"})");
+    runSpawn([&](auto yield) {
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_FALSE(output);
+        auto const err = rpc::makeError(output.result.error());
+        EXPECT_EQ(err.at("error").as_string(), "lgrNotFound");
+    });
+}
+
+TEST_F(RPCLedgerIndexTest, LaterThanCloseTimeIndexSearchesNewerLedgers)
+{
+    backend->setRange(RANGEMIN, RANGEMAX);
+    fillCloseTimeIndex(RANGEMIN, 20);
+    auto const handler = AnyHandler{LedgerIndexHandler{backend}};
+    auto const req = json::parse(R"({"date": "2024-06-25T12:23:35Z"})");
+
+    // only ledgers newer than the last indexed one are read
+    for (uint32_t i = 20; i <= RANGEMAX; i++) {
+        auto const ledgerHeader = CreateLedgerHeaderWithUnixTime(LEDGERHASH, i, 1719318190 + 2 * (i - RANGEMIN));
+        EXPECT_CALL(*backend, fetchLedgerBySequence(i, _)).Times(AtMost(3)).WillRepeatedly(Return(ledgerHeader));
+    }
+
+    runSpawn([&](auto yield) {
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output.result->at("ledger_index").as_uint64(), 22);
+        EXPECT_EQ(output.result->at("closed").as_string(), "2024-06-25T12:23:34Z");
+    });
+}
+
 TEST_F(RPCLedgerIndexTest, ChangeTimeZone)
 {
     setenv("TZ", "EST+5", 1);
@@ -166,3 +217,26 @@ TEST_P(LedgerIndexTests, SearchFromLedgerRange)
         EXPECT_EQ(output.result->at("closed").as_string(), testBundle.closeTimeIso);
     });
 }
+
+TEST_P(LedgerIndexTests, SearchFromCloseTimeIndex)
+{
+    auto const testBundle = GetParam();
+    backend->setRange(RANGEMIN, RANGEMAX);
+    fillCloseTimeIndex(RANGEMIN, RANGEMAX);
+
+    // the index answers the query, so only the header of the result is read
+    auto const ledgerHeader = CreateLedgerHeaderWithUnixTime(
+        LEDGERHASH, testBundle.expectedLedgerIndex, 1719318190 + 2 * (testBundle.expectedLedgerIndex - RANGEMIN)
+    );
+    EXPECT_CALL(*backend, fetchLedgerBySequence(testBundle.expectedLedgerIndex, _)).WillOnce(Return(ledgerHeader));
+
+    auto const handler = AnyHandler{LedgerIndexHandler{backend}};
+    auto const req = json::parse(testBundle.json);
+    runSpawn([&](auto yield) {
+        auto const output = handler.process(req, Context{yield});
+        ASSERT_TRUE(output);
+        EXPECT_EQ(output.result->at("ledger_index").as_uint64(), testBundle.expectedLedgerIndex);
+        EXPECT_EQ(output.result->at("ledger_hash").as_string(), LEDGERHASH);
+        EXPECT_EQ(output.result->at("closed").as_string(), testBundle.closeTimeIso);
+    });
+}
@@ -0,0 +1,173 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/AsioContextTestFixture.hpp"
+#include "util/SingleFlight.hpp"
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/cancellation_type.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/system_error.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace util;
+
+struct SingleFlightTest : SyncAsioContextTest {
+    SingleFlight<std::string> singleFlight;
+    std::size_t executions = 0;
+
+    // executes the work on a timer so that coroutines spawned after this one find it in flight
+    std::string
+    slowWork(boost::asio::yield_context yield, std::string const& value)
+    {
+        ++executions;
+        boost::asio::steady_timer timer{ctx, std::chrono::milliseconds{10}};
+        timer.async_wait(yield);
+        return value;
+    }
+};
+
+TEST_F(SingleFlightTest, SequentialCallsExecuteEachTime)
+{
+    runSpawn([&](auto yield) {
+        for (auto i = 0; i < 3; ++i) {
+            auto const work = [&]() { return slowWork(yield, "value"); };
+            auto const [value, outcome] = singleFlight.execute(yield, "key", work);
+            EXPECT_EQ(value, "value");
+            EXPECT_EQ(outcome, SingleFlightOutcome::Executed);
+        }
+    });
+
+    EXPECT_EQ(executions, 3u);
+}
+
+TEST_F(SingleFlightTest, ConcurrentCallsWithSameKeyShareValue)
+{
+    std::vector<SingleFlightOutcome> outcomes;
+    for (auto i = 0; i < 5; ++i) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            auto const work = [&]() { return slowWork(yield, "value"); };
+            auto const [value, outcome] = singleFlight.execute(yield, "key", work);
+            EXPECT_EQ(value, "value");
+            outcomes.push_back(outcome);
+        });
+    }
+    runContext();
+
+    EXPECT_EQ(executions, 1u);
+    ASSERT_EQ(outcomes.size(), 5u);
+    EXPECT_EQ(std::ranges::count(outcomes, SingleFlightOutcome::Shared), 4);
+    EXPECT_EQ(outcomes.back(), SingleFlightOutcome::ExecutedAndShared);
+}
+
+TEST_F(SingleFlightTest, ConcurrentCallsWithDifferentKeysExecuteEach)
+{
+    std::vector<std::string> values;
+    for (auto i = 0; i < 3; ++i) {
+        boost::asio::spawn(ctx, [&, i](boost::asio::yield_context yield) {
+            auto const key = std::to_string(i);
+            auto const [value, outcome] = singleFlight.execute(yield, key, [&]() { return slowWork(yield, key); });
+            EXPECT_EQ(value, key);
+            EXPECT_EQ(outcome, SingleFlightOutcome::Executed);
+        });
+    }
+    runContext();
+
+    EXPECT_EQ(executions, 3u);
+}
+
+TEST_F(SingleFlightTest, WaitersExecuteThemselvesIfLeaderThrows)
+{
+    std::size_t failures = 0;
+    std::vector<SingleFlightOutcome> outcomes;
+
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        EXPECT_THROW(
+            singleFlight.execute(
+                yield,
+                "key",
+                [&]() -> std::string {
+                    slowWork(yield, "value");
+                    throw std::runtime_error{"failed"};
+                }
+            ),
+            std::runtime_error
+        );
+        ++failures;
+    });
+
+    for (auto i = 0; i < 2; ++i) {
+        boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+            auto const work = [&]() { return slowWork(yield, "value"); };
+            auto const [value, outcome] = singleFlight.execute(yield, "key", work);
+            EXPECT_EQ(value, "value");
+            outcomes.push_back(outcome);
+        });
+    }
+    runContext();
+
+    EXPECT_EQ(failures, 1u);
+    EXPECT_EQ(executions, 3u);
+    EXPECT_EQ(outcomes, std::vector<SingleFlightOutcome>(2, SingleFlightOutcome::Executed));
+}
+
+TEST_F(SingleFlightTest, CancelledWaiterStopsWaiting)
+{
+    boost::asio::cancellation_signal cancellation;
+    std::optional<SingleFlightOutcome> leaderOutcome;
+    bool aborted = false;
+
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        auto const work = [&]() { return slowWork(yield, "value"); };
+        leaderOutcome = singleFlight.execute(yield, "key", work).second;
+    });
+
+    boost::asio::spawn(
+        ctx,
+        [&](boost::asio::yield_context yield) {
+            try {
+                singleFlight.execute(yield, "key", [&]() { return slowWork(yield, "value"); });
+            } catch (boost::system::system_error const& e) {
+                aborted = e.code() == boost::asio::error::operation_aborted;
+                EXPECT_FALSE(leaderOutcome.has_value());
+            }
+        },
+        boost::asio::bind_cancellation_slot(cancellation.slot(), [](std::exception_ptr) {})
+    );
+
+    boost::asio::post(ctx, [&]() { cancellation.emit(boost::asio::cancellation_type::terminal); });
+    runContext();
+
+    EXPECT_TRUE(aborted);
+    EXPECT_EQ(executions, 1u);
+    EXPECT_EQ(leaderOutcome, SingleFlightOutcome::Executed);
+}
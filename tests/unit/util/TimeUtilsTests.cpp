@@ -53,3 +53,19 @@ TEST(TimeUtilTests, SystemTpFromLedgerCloseTime)
     auto const tp = util::SystemTpFromLedgerCloseTime(ripple::NetClock::time_point{seconds{0}});
     EXPECT_EQ(tp.time_since_epoch(), ripple::epoch_offset);
 }
+
+TEST(TimeUtilTests, LedgerCloseTimeFromSystemTp)
+{
+    using namespace std::chrono;
+
+    auto const closeTime = ripple::NetClock::time_point{seconds{784111777}};
+    EXPECT_EQ(util::LedgerCloseTimeFromSystemTp(util::SystemTpFromLedgerCloseTime(closeTime)), closeTime);
+    EXPECT_EQ(
+        util::LedgerCloseTimeFromSystemTp(util::SystemTpFromLedgerCloseTime(closeTime) + milliseconds{999}), closeTime
+    );
+}
+
+TEST(TimeUtilTests, LedgerCloseTimeFromSystemTpBeforeNetworkEpoch)
+{
+    EXPECT_FALSE(util::LedgerCloseTimeFromSystemTp(std::chrono::system_clock::time_point{}).has_value());
+}
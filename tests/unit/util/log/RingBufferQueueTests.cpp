@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/LoggerFixtures.hpp"
+#include "util/MockPrometheus.hpp"
+#include "util/log/Logger.hpp"
+#include "util/log/impl/RingBufferQueue.hpp"
+#include "util/prometheus/Label.hpp"
+#include "util/prometheus/Prometheus.hpp"
+
+#include <boost/core/null_deleter.hpp>
+#include <boost/log/core/core.hpp>
+#include <boost/log/keywords/max_size.hpp>
+#include <boost/log/keywords/start_thread.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace util;
+using namespace util::impl;
+
+namespace {
+
+template <OverflowPolicy Policy>
+using AsyncSink =
+    boost::log::sinks::asynchronous_sink<boost::log::sinks::text_ostream_backend, RingBufferQueue<Policy>>;
+
+}  // namespace
+
+template <OverflowPolicy Policy>
+struct RingBufferQueueTest : LoggerFixture {
+    std::ostringstream output;
+    boost::shared_ptr<AsyncSink<Policy>> sink;
+
+    template <typename... ArgsType>
+    void
+    makeSink(ArgsType&&... args)
+    {
+        auto backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
+        backend->add_stream(boost::shared_ptr<std::ostream>(&output, boost::null_deleter()));
+        sink = boost::make_shared<AsyncSink<Policy>>(backend, std::forward<ArgsType>(args)...);
+        boost::log::core::get()->add_sink(sink);
+    }
+
+    std::size_t
+    lines()
+    {
+        sink->flush();
+        auto const str = output.str();
+        return static_cast<std::size_t>(std::count(str.begin(), str.end(), '\n'));
+    }
+
+    ~RingBufferQueueTest() override
+    {
+        boost::log::core::get()->remove_sink(sink);
+        sink->stop();
+    }
+};
+
+using RingBufferQueueBlockTest = RingBufferQueueTest<OverflowPolicy::Block>;
+using RingBufferQueueDropTest = RingBufferQueueTest<OverflowPolicy::Drop>;
+
+TEST_F(RingBufferQueueBlockTest, CapacityIsRoundedUpToPowerOfTwo)
+{
+    makeSink(boost::log::keywords::max_size = 100);
+    EXPECT_EQ(sink->capacity(), 128u);
+}
+
+TEST_F(RingBufferQueueBlockTest, AllRecordsAreWrittenWhenQueueIsFull)
+{
+    static constexpr auto NUM_THREADS = 4;
+    static constexpr auto NUM_RECORDS = 1000;
+    makeSink(boost::log::keywords::max_size = 8);
+
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([] {
+            Logger const log{"General"};
+            for (auto j = 0; j < NUM_RECORDS; ++j)
+                LOG(log.info()) << "record " << j;
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(lines(), static_cast<std::size_t>(NUM_THREADS * NUM_RECORDS));
+}
+
+TEST_F(RingBufferQueueDropTest, RecordsAreDroppedAndCountedWhenQueueIsFull)
+{
+    // without a writer thread nothing leaves the queue until it is flushed
+    makeSink(boost::log::keywords::max_size = 4, boost::log::keywords::start_thread = false);
+    auto const droppedBefore = RingBufferQueue<OverflowPolicy::Drop>::dropped();
+
+    Logger const log{"General"};
+    for (auto i = 0; i < 10; ++i)
+        LOG(log.info()) << "record " << i;
+
+    EXPECT_EQ(RingBufferQueue<OverflowPolicy::Drop>::dropped() - droppedBefore, 6u);
+    EXPECT_EQ(lines(), 4u);
+}
+
+struct RingBufferQueueDropMetricsTest : util::prometheus::WithPrometheus, RingBufferQueueDropTest {
+    ~RingBufferQueueDropMetricsTest() override
+    {
+        RingBufferQueue<OverflowPolicy::Drop>::exportDropped(nullptr);
+    }
+};
+
+TEST_F(RingBufferQueueDropMetricsTest, DroppedRecordsAreExportedAsCounter)
+{
+    makeSink(boost::log::keywords::max_size = 4, boost::log::keywords::start_thread = false);
+    LogService::registerMetrics();
+
+    auto& counter = PrometheusService::counterInt("log_records_dropped_total_number", util::prometheus::Labels());
+    EXPECT_EQ(counter.value(), RingBufferQueue<OverflowPolicy::Drop>::dropped());
+    auto const droppedBefore = counter.value();
+
+    Logger const log{"General"};
+    for (auto i = 0; i < 10; ++i)
+        LOG(log.info()) << "record " << i;
+
+    EXPECT_EQ(counter.value() - droppedBefore, 6u);
+    EXPECT_EQ(counter.value(), RingBufferQueue<OverflowPolicy::Drop>::dropped());
+}
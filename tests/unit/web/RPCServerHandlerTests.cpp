@@ -27,6 +27,7 @@
 #include "util/config/Config.hpp"
 #include "web/RPCServerHandler.hpp"
 #include "web/interface/ConnectionBase.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
 
 #include <boost/beast/http/status.hpp>
 #include <boost/json/parse.hpp>
@@ -47,9 +48,9 @@ struct MockWsBase : public web::ConnectionBase {
     boost::beast::http::status lastStatus = boost::beast::http::status::unknown;
 
     void
-    send(std::shared_ptr<std::string> msg_type) override
+    send(std::shared_ptr<web::SubscriptionMessage const> msg_type) override
     {
-        message += std::string(*msg_type);
+        message += msg_type->data();
         lastStatus = boost::beast::http::status::ok;
     }
 
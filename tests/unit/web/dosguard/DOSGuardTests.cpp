@@ -26,7 +26,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <stdexcept>
 #include <string_view>
+#include <thread>
 
 using namespace testing;
 using namespace util;
@@ -126,3 +129,127 @@ TEST_F(DOSGuardTest, RequestLimitOnTimer)
     guard.clear();
     EXPECT_TRUE(guard.isOk(IP));  // can request again
 }
+
+TEST_F(DOSGuardTest, ClientsAreCountedSeparately)
+{
+    static constexpr auto OTHER_IP = "127.0.0.3";
+
+    EXPECT_TRUE(guard.add(IP, 100));
+    EXPECT_FALSE(guard.add(IP, 1));
+    EXPECT_TRUE(guard.isOk(OTHER_IP));
+    EXPECT_TRUE(guard.add(OTHER_IP, 100));
+}
+
+TEST_F(DOSGuardTest, IPv4AndMappedIPv6AddressesAreTheSameClient)
+{
+    static constexpr auto MAPPED_IP = "::ffff:127.0.0.2";
+
+    EXPECT_TRUE(guard.add(IP, 100));
+    EXPECT_FALSE(guard.add(MAPPED_IP, 1));
+    EXPECT_FALSE(guard.isOk(IP));
+
+    guard.clear();
+    EXPECT_TRUE(guard.isOk(MAPPED_IP));
+}
+
+TEST_F(DOSGuardTest, IPv6ConnectionCount)
+{
+    static constexpr auto IPV6 = "2001:db8::1";
+
+    guard.increment(IPV6);
+    guard.increment(IPV6);
+    guard.increment(IPV6);
+    EXPECT_FALSE(guard.isOk(IPV6));
+    EXPECT_TRUE(guard.isOk(IP));
+
+    guard.decrement(IPV6);
+    EXPECT_TRUE(guard.isOk(IPV6));
+}
+
+TEST_F(DOSGuardTest, MethodCostIsUnlimitedByDefault)
+{
+    for (auto i = 0; i < 10; ++i)
+        EXPECT_TRUE(guard.requestMethod(IP, "account_tx"));
+    EXPECT_TRUE(guard.isOk(IP));
+}
+
+struct DOSGuardMethodCostTest : DOSGuardTest {
+    static constexpr auto JSONDataMethodCost = R"JSON(
+    {
+        "dos_guard": {
+            "max_method_cost": 10,
+            "method_weights": [
+                {"method": "book_offers", "weight": 4}
+            ]
+        }
+    }
+)JSON";
+
+    Config cfgMethodCost{json::parse(JSONDataMethodCost)};
+    DOSGuard methodCostGuard{cfgMethodCost, whitelistHandler};
+};
+
+TEST_F(DOSGuardMethodCostTest, ExpensiveMethodsAreCharged)
+{
+    EXPECT_EQ(methodCostGuard.methodWeight("account_tx"), 10u);
+    EXPECT_EQ(methodCostGuard.methodWeight("book_offers"), 4u);
+    EXPECT_EQ(methodCostGuard.methodWeight("server_info"), 0u);
+
+    EXPECT_TRUE(methodCostGuard.requestMethod(IP, "book_offers"));
+    EXPECT_TRUE(methodCostGuard.requestMethod(IP, "book_offers"));
+    EXPECT_FALSE(methodCostGuard.requestMethod(IP, "book_offers"));
+    EXPECT_FALSE(methodCostGuard.isOk(IP));
+
+    methodCostGuard.clear();
+    EXPECT_TRUE(methodCostGuard.requestMethod(IP, "account_tx"));
+}
+
+TEST_F(DOSGuardMethodCostTest, CheapMethodsAreFree)
+{
+    for (auto i = 0; i < 100; ++i)
+        EXPECT_TRUE(methodCostGuard.requestMethod(IP, "server_info"));
+}
+
+TEST_F(DOSGuardTest, UnknownRateLimiterThrows)
+{
+    Config const cfgRateLimiter{json::parse(R"JSON({"dos_guard": {"rate_limiter": "leaky"}})JSON")};
+    EXPECT_THROW((DOSGuard{cfgRateLimiter, whitelistHandler}), std::logic_error);
+}
+
+struct DOSGuardTokenBucketTest : DOSGuardTest {
+    static constexpr auto JSONDataTokenBucket = R"JSON(
+    {
+        "dos_guard": {
+            "max_fetches": 100,
+            "max_connections": 2,
+            "max_requests": 2,
+            "sweep_interval": 0.1,
+            "rate_limiter": "token_bucket"
+        }
+    }
+)JSON";
+
+    Config cfgTokenBucket{json::parse(JSONDataTokenBucket)};
+    DOSGuard tokenBucketGuard{cfgTokenBucket, whitelistHandler};
+};
+
+TEST_F(DOSGuardTokenBucketTest, SweepDoesNotResetBudget)
+{
+    EXPECT_TRUE(tokenBucketGuard.add(IP, 100));
+    EXPECT_FALSE(tokenBucketGuard.add(IP, 100000));  // takes far longer than the test to pay off
+
+    tokenBucketGuard.clear();
+    EXPECT_FALSE(tokenBucketGuard.isOk(IP));
+}
+
+TEST_F(DOSGuardTokenBucketTest, BudgetIsRefilledOverTime)
+{
+    EXPECT_TRUE(tokenBucketGuard.request(IP));
+    EXPECT_TRUE(tokenBucketGuard.request(IP));
+    EXPECT_FALSE(tokenBucketGuard.request(IP));
+
+    // two requests per 100ms, so the debt of one request is paid off after 50ms
+    std::this_thread::sleep_for(std::chrono::milliseconds{100});
+    EXPECT_TRUE(tokenBucketGuard.isOk(IP));
+    EXPECT_TRUE(tokenBucketGuard.request(IP));
+}
@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/dosguard/TokenBucket.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace web::dosguard;
+using namespace std::chrono_literals;
+
+struct TokenBucketTest : ::testing::Test {
+    TokenBucket::ClockType::time_point const start = TokenBucket::ClockType::now();
+    TokenBucket bucket{10, 5, start};
+};
+
+TEST_F(TokenBucketTest, StartsFull)
+{
+    EXPECT_TRUE(bucket.isFull(start));
+    EXPECT_FALSE(bucket.isExhausted(start));
+    EXPECT_DOUBLE_EQ(bucket.available(start), 10);
+    EXPECT_DOUBLE_EQ(bucket.used(start), 0);
+}
+
+TEST_F(TokenBucketTest, ExhaustedWhenConsumingMoreThanAvailable)
+{
+    bucket.consume(10, start);
+    EXPECT_FALSE(bucket.isExhausted(start));
+
+    bucket.consume(1, start);
+    EXPECT_TRUE(bucket.isExhausted(start));
+    EXPECT_DOUBLE_EQ(bucket.used(start), 11);
+}
+
+TEST_F(TokenBucketTest, RefillsContinuously)
+{
+    bucket.consume(12, start);
+    EXPECT_TRUE(bucket.isExhausted(start));
+
+    EXPECT_DOUBLE_EQ(bucket.available(start + 200ms), -1);
+    EXPECT_FALSE(bucket.isExhausted(start + 400ms));
+    EXPECT_DOUBLE_EQ(bucket.available(start + 1s), 3);
+    EXPECT_TRUE(bucket.isFull(start + 3s));
+    EXPECT_DOUBLE_EQ(bucket.available(start + 10s), 10);
+}
+
+TEST_F(TokenBucketTest, ConsumingAfterRefill)
+{
+    bucket.consume(10, start);
+    bucket.consume(5, start + 1s);
+    EXPECT_DOUBLE_EQ(bucket.available(start + 1s), 0);
+    EXPECT_DOUBLE_EQ(bucket.available(start + 2s), 5);
+}
+
+TEST(TokenBucketWithoutRefillTest, NeverRefills)
+{
+    auto const start = TokenBucket::ClockType::now();
+    TokenBucket bucket{10, 0, start};
+
+    bucket.consume(4, start);
+    EXPECT_DOUBLE_EQ(bucket.available(start + 1h), 6);
+}
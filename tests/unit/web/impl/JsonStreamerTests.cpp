@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/JsonStreamer.hpp"
+
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/serialize.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+using namespace web::impl;
+
+namespace {
+
+boost::json::object
+makeLargeObject()
+{
+    boost::json::array objects;
+    for (std::size_t i = 0; i < 10000; ++i)
+        objects.push_back(boost::json::object{{"index", i}, {"data", std::string(32, 'A')}});
+
+    return boost::json::object{{"result", boost::json::object{{"state", std::move(objects)}}}};
+}
+
+}  // namespace
+
+TEST(JsonStreamerTest, SmallObjectIsReadAtOnce)
+{
+    boost::json::object const object{{"result", boost::json::object{{"status", "success"}}}};
+    JsonStreamer streamer{boost::json::object{object}};
+
+    EXPECT_FALSE(streamer.done());
+    EXPECT_EQ(streamer.read(), boost::json::serialize(object));
+    EXPECT_TRUE(streamer.done());
+    EXPECT_EQ(streamer.size(), boost::json::serialize(object).size());
+    EXPECT_TRUE(streamer.read().empty());
+}
+
+TEST(JsonStreamerTest, LargeObjectIsReadInBoundedChunks)
+{
+    auto const object = makeLargeObject();
+    auto const expected = boost::json::serialize(object);
+    JsonStreamer streamer{boost::json::object{object}};
+
+    std::string result;
+    std::size_t chunks = 0;
+    while (not streamer.done()) {
+        auto const chunk = streamer.read();
+        EXPECT_LE(chunk.size(), JsonStreamer::CHUNK_SIZE);
+        EXPECT_EQ(streamer.current(), chunk);
+        result += chunk;
+        ++chunks;
+    }
+
+    EXPECT_GT(chunks, 1u);
+    EXPECT_EQ(result, expected);
+    EXPECT_EQ(streamer.size(), expected.size());
+}
+
+TEST(JsonStreamerTest, RestartSerializesModifiedObject)
+{
+    auto object = makeLargeObject();
+    JsonStreamer streamer{boost::json::object{object}};
+    streamer.read();
+
+    streamer.restart([](boost::json::object& obj) { obj["warning"] = "load"; });
+    EXPECT_TRUE(streamer.current().empty());
+    EXPECT_EQ(streamer.size(), 0u);
+
+    std::string result;
+    while (not streamer.done())
+        result += streamer.read();
+
+    object["warning"] = "load";
+    EXPECT_EQ(result, boost::json::serialize(object));
+}
+
+TEST(JsonStreamBodyTest, WriterStartsWithCurrentChunk)
+{
+    auto const expected = boost::json::serialize(makeLargeObject());
+    auto const streamer = std::make_shared<JsonStreamer>(makeLargeObject());
+    streamer->read();
+
+    boost::beast::http::response_header<> const header;
+    JsonStreamBody::writer writer{header, streamer};
+
+    boost::beast::error_code ec;
+    writer.init(ec);
+    ASSERT_FALSE(ec);
+
+    std::string result;
+    while (auto const buffers = writer.get(ec)) {
+        ASSERT_FALSE(ec);
+        result.append(static_cast<char const*>(buffers->first.data()), buffers->first.size());
+        EXPECT_EQ(buffers->second, not streamer->done());
+    }
+
+    EXPECT_EQ(result, expected);
+}
@@ -0,0 +1,283 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "web/impl/WsFrame.hpp"
+#include "web/impl/WsFrameStream.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/buffers_to_string.hpp>
+#include <boost/beast/core/error.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/beast/http/field.hpp>
+#include <boost/beast/websocket/option.hpp>
+#include <boost/beast/websocket/rfc6455.hpp>
+#include <boost/beast/websocket/stream.hpp>
+#include <boost/beast/websocket/stream_base.hpp>
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <boost/beast/zlib/zlib.hpp>
+#include <boost/system/error_code.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace web::impl;
+
+namespace {
+
+std::vector<std::uint8_t>
+bytes(WsFrameHeader const& header)
+{
+    auto const buffer = header.buffer();
+    auto const* data = static_cast<std::uint8_t const*>(buffer.data());
+    return {data, data + buffer.size()};
+}
+
+std::string
+inflateMessage(std::string compressed)
+{
+    compressed += std::string_view{"\x00\x00\xff\xff", 4};
+
+    boost::beast::zlib::inflate_stream stream;
+    std::string result(1024 * 1024, '\0');
+    boost::beast::zlib::z_params params;
+    params.next_in = compressed.data();
+    params.avail_in = compressed.size();
+    params.next_out = result.data();
+    params.avail_out = result.size();
+
+    boost::system::error_code ec;
+    stream.write(params, boost::beast::zlib::Flush::sync, ec);
+    EXPECT_FALSE(ec);
+    result.resize(params.total_out);
+    return result;
+}
+
+std::string
+makeJson(std::size_t entries)
+{
+    std::string json = "[";
+    for (std::size_t i = 0; i < entries; ++i)
+        json += R"({"account":"rLHzPsX6oXkzU2qL12kHCH8G8cnZv1rBJh","sequence":)" + std::to_string(i) + "},";
+    json.back() = ']';
+    return json;
+}
+
+}  // namespace
+
+TEST(WsFrameHeaderTest, SmallPayloadLengthFitsIntoSecondByte)
+{
+    EXPECT_EQ(bytes(WsFrameHeader{0}), (std::vector<std::uint8_t>{0x81, 0x00}));
+    EXPECT_EQ(bytes(WsFrameHeader{125}), (std::vector<std::uint8_t>{0x81, 0x7d}));
+}
+
+TEST(WsFrameHeaderTest, MediumPayloadLengthUsesTwoBytes)
+{
+    EXPECT_EQ(bytes(WsFrameHeader{126}), (std::vector<std::uint8_t>{0x81, 0x7e, 0x00, 0x7e}));
+    EXPECT_EQ(bytes(WsFrameHeader{0xFFFF}), (std::vector<std::uint8_t>{0x81, 0x7e, 0xff, 0xff}));
+}
+
+TEST(WsFrameHeaderTest, LargePayloadLengthUsesEightBytes)
+{
+    EXPECT_EQ(
+        bytes(WsFrameHeader{70000}),
+        (std::vector<std::uint8_t>{0x81, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x70})
+    );
+}
+
+TEST(WsFrameHeaderTest, CompressedPayloadSetsRsv1)
+{
+    EXPECT_EQ(bytes(WsFrameHeader{5, true}), (std::vector<std::uint8_t>{0xc1, 0x05}));
+}
+
+TEST(WsFrameDeflateTest, DeflatedMessageInflatesToOriginal)
+{
+    for (auto const& message : {std::string{}, std::string{"short"}, makeJson(10000)}) {
+        auto const compressed = deflateMessage(message, 1);
+        EXPECT_FALSE(std::string_view{compressed}.ends_with(std::string_view{"\x00\x00\xff\xff", 4}));
+        EXPECT_EQ(inflateMessage(compressed), message);
+    }
+
+    auto const json = makeJson(10000);
+    EXPECT_LT(deflateMessage(json, 1).size(), json.size() / 4);
+}
+
+TEST(WsFrameDeflateTest, SharedDeflateNeedsNoContextTakeoverAndFullWindow)
+{
+    EXPECT_TRUE(acceptsSharedDeflate("permessage-deflate; server_no_context_takeover"));
+    EXPECT_TRUE(acceptsSharedDeflate(
+        "permessage-deflate; server_no_context_takeover; client_no_context_takeover; server_max_window_bits=15"
+    ));
+    EXPECT_TRUE(acceptsSharedDeflate(R"(permessage-deflate;server_max_window_bits="15";server_no_context_takeover)"));
+
+    EXPECT_FALSE(acceptsSharedDeflate(""));
+    EXPECT_FALSE(acceptsSharedDeflate("permessage-deflate"));
+    EXPECT_FALSE(acceptsSharedDeflate("permessage-deflate; server_no_context_takeover; server_max_window_bits=10"));
+    EXPECT_FALSE(acceptsSharedDeflate("x-webkit-deflate-frame; server_no_context_takeover"));
+}
+
+TEST(WsFrameDeflateTest, SubscriptionMessageIsCompressedOnce)
+{
+    web::SubscriptionMessage const message{makeJson(100)};
+    std::size_t calls = 0;
+    auto compress = [&calls](std::string const& data) {
+        ++calls;
+        return deflateMessage(data, 1);
+    };
+
+    auto const& first = message.compressed(compress);
+    auto const& second = message.compressed(compress);
+
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(&first, &second);
+    EXPECT_EQ(inflateMessage(first), message.data());
+}
+
+TEST(WsFrameStreamTest, FramesAreWrittenInPlaceOfEmptyMessage)
+{
+    namespace websocket = boost::beast::websocket;
+    using boost::asio::ip::tcp;
+
+    boost::asio::io_context ioc;
+    tcp::acceptor acceptor{ioc, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    auto const endpoint = acceptor.local_endpoint();
+
+    std::vector<std::string> const messages{"first", std::string(300, 'a'), std::string(70000, 'b'), "last"};
+    std::vector<std::string> received;
+
+    std::thread client{[&]() {
+        boost::asio::io_context clientIoc;
+        websocket::stream<tcp::socket> ws{clientIoc};
+        ws.next_layer().connect(endpoint);
+        ws.handshake("localhost", "/");
+        ws.ping({});  // the pong is written by the server while the frames may be written
+
+        for (std::size_t i = 0; i <= messages.size(); ++i) {
+            boost::beast::flat_buffer buffer;
+            ws.read(buffer);
+            received.push_back(boost::beast::buffers_to_string(buffer.data()));
+        }
+        ws.close(websocket::close_code::normal);
+    }};
+
+    websocket::stream<WsFrameStream<boost::beast::tcp_stream>> ws{acceptor.accept()};
+
+    std::vector<WsFrameHeader> headers;
+    for (auto const& message : messages)
+        headers.emplace_back(message.size());
+
+    std::vector<boost::asio::const_buffer> frames;
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        frames.push_back(headers[i].buffer());
+        frames.push_back(boost::asio::buffer(messages[i]));
+    }
+
+    std::string const single = "single";
+    boost::beast::flat_buffer readBuffer;
+    ws.async_accept([&](boost::beast::error_code ec) {
+        ASSERT_FALSE(ec);
+        ws.async_read(readBuffer, [](boost::beast::error_code ec, std::size_t) {
+            EXPECT_EQ(ec, websocket::error::closed);
+        });
+
+        ws.next_layer().setFrames(std::move(frames));
+        ws.async_write(boost::asio::const_buffer{}, [&](boost::beast::error_code ec, std::size_t) {
+            ASSERT_FALSE(ec);
+            ws.async_write(boost::asio::buffer(single), [](boost::beast::error_code ec, std::size_t) {
+                EXPECT_FALSE(ec);
+            });
+        });
+    });
+
+    ioc.run();
+    client.join();
+
+    auto expected = messages;
+    expected.push_back(single);
+    EXPECT_EQ(received, expected);
+}
+
+TEST(WsFrameStreamTest, SharedDeflatedFrameIsReadByClient)
+{
+    namespace websocket = boost::beast::websocket;
+    using boost::asio::ip::tcp;
+
+    boost::asio::io_context ioc;
+    tcp::acceptor acceptor{ioc, {boost::asio::ip::make_address("127.0.0.1"), 0}};
+    auto const endpoint = acceptor.local_endpoint();
+
+    auto const message = makeJson(1000);
+    std::string received;
+
+    std::thread client{[&]() {
+        boost::asio::io_context clientIoc;
+        websocket::stream<tcp::socket> ws{clientIoc};
+        websocket::permessage_deflate deflate;
+        deflate.client_enable = true;
+        ws.set_option(deflate);
+        ws.next_layer().connect(endpoint);
+        ws.handshake("localhost", "/");
+
+        boost::beast::flat_buffer buffer;
+        ws.read(buffer);
+        received = boost::beast::buffers_to_string(buffer.data());
+        ws.close(websocket::close_code::normal);
+    }};
+
+    websocket::stream<WsFrameStream<boost::beast::tcp_stream>> ws{acceptor.accept()};
+    websocket::permessage_deflate deflate;
+    deflate.server_enable = true;
+    deflate.server_no_context_takeover = true;
+    ws.set_option(deflate);
+
+    bool shared = false;
+    ws.set_option(websocket::stream_base::decorator([&shared](websocket::response_type& res) {
+        shared = acceptsSharedDeflate(std::string_view{res[boost::beast::http::field::sec_websocket_extensions]});
+    }));
+
+    auto const compressed = deflateMessage(message, 1);
+    WsFrameHeader const header{compressed.size(), true};
+    boost::beast::flat_buffer readBuffer;
+
+    ws.async_accept([&](boost::beast::error_code ec) {
+        ASSERT_FALSE(ec);
+        ASSERT_TRUE(shared);
+        ws.async_read(readBuffer, [](boost::beast::error_code, std::size_t) {});
+
+        ws.next_layer().setFrames({header.buffer(), boost::asio::buffer(compressed)});
+        ws.compress(false);
+        ws.async_write(boost::asio::const_buffer{}, [](boost::beast::error_code ec, std::size_t) {
+            EXPECT_FALSE(ec);
+        });
+    });
+
+    ioc.run();
+    client.join();
+
+    EXPECT_EQ(received, message);
+}
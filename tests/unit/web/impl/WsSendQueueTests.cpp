@@ -0,0 +1,271 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/MockPrometheus.hpp"
+#include "util/config/Config.hpp"
+#include "web/impl/JsonStreamer.hpp"
+#include "web/impl/WsSendQueue.hpp"
+#include "web/interface/SubscriptionMessage.hpp"
+
+#include <boost/json/object.hpp>
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+using namespace web;
+using namespace web::impl;
+
+namespace {
+
+std::shared_ptr<std::string>
+makeResponse(std::string text)
+{
+    return std::make_shared<std::string>(std::move(text));
+}
+
+std::shared_ptr<SubscriptionMessage const>
+makeMessage(std::string text)
+{
+    return std::make_shared<SubscriptionMessage const>(std::move(text));
+}
+
+std::shared_ptr<SubscriptionMessage const>
+makeLedgerMessage(int sequence)
+{
+    return std::make_shared<SubscriptionMessage const>(
+        R"({"type":"ledgerClosed","ledger_index":)" + std::to_string(sequence) + "}", SubscriptionMessage::Kind::Ledger
+    );
+}
+
+std::string
+popText(WsSendQueue& queue)
+{
+    auto const message = queue.pop();
+    if (auto const* response = std::get_if<std::shared_ptr<std::string>>(&message))
+        return **response;
+
+    return std::get<std::shared_ptr<SubscriptionMessage const>>(message)->data();
+}
+
+}  // namespace
+
+struct WsSendQueueTests : util::prometheus::WithPrometheus {
+    static WsSendQueueSettings
+    makeSettings(SlowClientPolicy policy, std::size_t maxMessages = 3, std::size_t maxBytes = 1024)
+    {
+        return WsSendQueueSettings{.maxMessages = maxMessages, .maxBytes = maxBytes, .policy = policy};
+    }
+};
+
+TEST_F(WsSendQueueTests, MessagesArePoppedInOrder)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+
+    EXPECT_TRUE(queue.push(makeMessage("first")));
+    EXPECT_TRUE(queue.push(makeResponse("second")));
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(queue.bytes(), 11u);
+
+    EXPECT_EQ(popText(queue), "first");
+    EXPECT_EQ(popText(queue), "second");
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.bytes(), 0u);
+}
+
+TEST_F(WsSendQueueTests, FrontDoesNotRemoveMessage)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+    auto const response = makeResponse("response");
+
+    EXPECT_TRUE(queue.push(response));
+    EXPECT_EQ(std::get<std::shared_ptr<std::string>>(queue.front()), response);
+    EXPECT_EQ(queue.size(), 1u);
+    EXPECT_EQ(popText(queue), "response");
+}
+
+TEST_F(WsSendQueueTests, StreamerIsAccountedWithItsCurrentChunk)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+    auto const streamer = std::make_shared<JsonStreamer>(boost::json::object{{"result", "success"}});
+    auto const chunk = streamer->read();
+
+    EXPECT_TRUE(queue.push(streamer));
+    EXPECT_EQ(queue.bytes(), chunk.size());
+    EXPECT_EQ(std::get<std::shared_ptr<JsonStreamer>>(queue.pop()), streamer);
+}
+
+TEST_F(WsSendQueueTests, DisconnectWhenMessageBudgetIsExceeded)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_TRUE(queue.push(makeMessage("message")));
+
+    EXPECT_FALSE(queue.push(makeMessage("message")));
+}
+
+TEST_F(WsSendQueueTests, DisconnectWhenByteBudgetIsExceeded)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect, 100, 10)};
+
+    EXPECT_TRUE(queue.push(makeMessage("12345")));
+    EXPECT_FALSE(queue.push(makeMessage("123456")));
+}
+
+TEST_F(WsSendQueueTests, ResponseOverBudgetEvictsSubscriptionsInsteadOfDisconnecting)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+
+    for (auto i = 0; i < 3; ++i)
+        EXPECT_TRUE(queue.push(makeMessage(std::to_string(i))));
+
+    EXPECT_TRUE(queue.push(makeResponse("response")));
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(popText(queue), "1");
+    EXPECT_EQ(popText(queue), "2");
+    EXPECT_EQ(popText(queue), "response");
+}
+
+TEST_F(WsSendQueueTests, ResponsesOverBudgetDoNotDisconnect)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::Disconnect)};
+
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(makeResponse(std::to_string(i))));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_FALSE(queue.push(makeMessage("subscription")));
+}
+
+TEST_F(WsSendQueueTests, DropOldestSubscriptionMessages)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::DropOldest)};
+
+    EXPECT_TRUE(queue.push(makeResponse("response")));
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(makeMessage(std::to_string(i))));
+
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(popText(queue), "response");
+    EXPECT_EQ(popText(queue), "2");
+    EXPECT_EQ(popText(queue), "3");
+}
+
+TEST_F(WsSendQueueTests, ResponsesAreNeverDropped)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::DropOldest)};
+
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(makeResponse(std::to_string(i))));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(popText(queue), "0");
+}
+
+TEST_F(WsSendQueueTests, CoalesceLedgerMessages)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::CoalesceLedgers)};
+
+    EXPECT_TRUE(queue.push(makeLedgerMessage(1)));
+    EXPECT_TRUE(queue.push(makeMessage("transaction")));
+    EXPECT_TRUE(queue.push(makeLedgerMessage(2)));
+    EXPECT_TRUE(queue.push(makeLedgerMessage(3)));
+
+    EXPECT_EQ(queue.size(), 2u);
+    EXPECT_EQ(popText(queue), "transaction");
+    EXPECT_EQ(popText(queue), makeLedgerMessage(3)->data());
+}
+
+TEST_F(WsSendQueueTests, CoalesceKeepsOnlyTheLatestLedgerMessage)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::CoalesceLedgers, 6)};
+
+    EXPECT_TRUE(queue.push(makeLedgerMessage(1)));
+    EXPECT_TRUE(queue.push(makeMessage("a")));
+    EXPECT_TRUE(queue.push(makeLedgerMessage(2)));
+    EXPECT_TRUE(queue.push(makeResponse("b")));
+    EXPECT_TRUE(queue.push(makeLedgerMessage(3)));
+    EXPECT_TRUE(queue.push(makeMessage("c")));
+    EXPECT_TRUE(queue.push(makeLedgerMessage(4)));
+
+    EXPECT_EQ(queue.size(), 4u);
+    EXPECT_EQ(queue.bytes(), 3u + makeLedgerMessage(4)->data().size());
+    EXPECT_EQ(popText(queue), "a");
+    EXPECT_EQ(popText(queue), "b");
+    EXPECT_EQ(popText(queue), "c");
+    EXPECT_EQ(popText(queue), makeLedgerMessage(4)->data());
+}
+
+TEST_F(WsSendQueueTests, CoalesceFallsBackToDropOldest)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::CoalesceLedgers)};
+
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(makeMessage(std::to_string(i))));
+
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(popText(queue), "1");
+}
+
+TEST_F(WsSendQueueTests, SettingsFromConfig)
+{
+    auto const settings = WsSendQueueSettings::make(util::Config{boost::json::parse(R"JSON({
+        "ws_max_queue_messages": 5,
+        "ws_max_queue_size_kb": 2,
+        "ws_slow_client_policy": "coalesce_ledgers"
+    })JSON")});
+
+    EXPECT_EQ(settings.maxMessages, 5u);
+    EXPECT_EQ(settings.maxBytes, 2048u);
+    EXPECT_EQ(settings.policy, SlowClientPolicy::CoalesceLedgers);
+}
+
+TEST_F(WsSendQueueTests, SettingsDefaults)
+{
+    auto const settings = WsSendQueueSettings::make(util::Config{boost::json::parse("{}")});
+
+    EXPECT_EQ(settings.maxMessages, WsSendQueueSettings::DEFAULT_MAX_MESSAGES);
+    EXPECT_EQ(settings.maxBytes, WsSendQueueSettings::DEFAULT_MAX_SIZE_KB * 1024);
+    EXPECT_EQ(settings.policy, SlowClientPolicy::Disconnect);
+}
+
+TEST_F(WsSendQueueTests, UnknownPolicyThrows)
+{
+    EXPECT_THROW(
+        WsSendQueueSettings::make(util::Config{boost::json::parse(R"JSON({"ws_slow_client_policy": "ignore"})JSON")}),
+        std::logic_error
+    );
+}
+
+TEST_F(WsSendQueueTests, CoalesceOnlyLedgerKindMessages)
+{
+    WsSendQueue queue{makeSettings(SlowClientPolicy::CoalesceLedgers)};
+
+    // looks like a ledger stream message but was not published as one
+    for (auto i = 0; i < 4; ++i)
+        EXPECT_TRUE(queue.push(makeMessage(R"({"type":"ledgerClosed","ledger_index":)" + std::to_string(i) + "}")));
+
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(popText(queue), R"({"type":"ledgerClosed","ledger_index":1})");
+}
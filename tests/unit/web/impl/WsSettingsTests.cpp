@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2024, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include "util/config/Config.hpp"
+#include "web/impl/WsSendQueue.hpp"
+#include "web/impl/WsSettings.hpp"
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace web::impl;
+
+TEST(WsSettingsTests, Defaults)
+{
+    auto const settings = WsSettings::make(util::Config{boost::json::parse("{}")});
+
+    EXPECT_FALSE(settings.compression.enabled);
+    EXPECT_EQ(settings.compression.level, WsCompressionSettings::DEFAULT_LEVEL);
+    EXPECT_EQ(settings.compression.threshold, WsCompressionSettings::DEFAULT_THRESHOLD);
+    EXPECT_EQ(settings.queue.maxMessages, WsSendQueueSettings::DEFAULT_MAX_MESSAGES);
+    EXPECT_EQ(settings.queue.policy, SlowClientPolicy::Disconnect);
+}
+
+TEST(WsSettingsTests, FromConfig)
+{
+    auto const settings = WsSettings::make(util::Config{boost::json::parse(R"JSON({
+        "ws_permessage_deflate": true,
+        "ws_compression_level": 6,
+        "ws_compression_threshold": 256,
+        "ws_slow_client_policy": "drop_oldest"
+    })JSON")});
+
+    EXPECT_TRUE(settings.compression.enabled);
+    EXPECT_EQ(settings.compression.level, 6);
+    EXPECT_EQ(settings.compression.threshold, 256u);
+    EXPECT_EQ(settings.queue.policy, SlowClientPolicy::DropOldest);
+}
+
+TEST(WsSettingsTests, InvalidCompressionLevelThrows)
+{
+    EXPECT_THROW(
+        WsSettings::make(util::Config{boost::json::parse(R"JSON({"ws_compression_level": 10})JSON")}), std::logic_error
+    );
+}